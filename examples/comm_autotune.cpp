@@ -0,0 +1,32 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#include <fstream>
+#include <ygm/comm.hpp>
+
+//
+// Calibrates ygm::comm settings for the current job size and node layout and
+// writes them to a config file, ".ygm" by default. Later runs from the same
+// directory, or with YGM_CONFIG_FILE pointing to the file, pick them up.
+int main(int argc, char** argv) {
+  ASSERT_MPI(MPI_Init(&argc, &argv));
+  {
+    std::string fname = argc > 1 ? argv[1] : ".ygm";
+
+    ygm::detail::comm_environment env;
+    env = ygm::detail::autotune_comm_environment(MPI_COMM_WORLD, env,
+                                                 &std::cout);
+
+    int rank;
+    ASSERT_MPI(MPI_Comm_rank(MPI_COMM_WORLD, &rank));
+    if (rank == 0) {
+      std::ofstream ofs(fname);
+      env.write_file(ofs);
+      std::cout << "Wrote " << fname << std::endl;
+    }
+  }
+  ASSERT_MPI(MPI_Finalize());
+  return 0;
+}
@@ -0,0 +1,91 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#include <random>
+#include <string>
+#include <ygm/comm.hpp>
+#include <ygm/container/bloom_filter.hpp>
+#include <ygm/container/set.hpp>
+
+// Builds a membership filter over random keys with set and with bloom_filter,
+// then probes it with as many keys again, half of them present, remotely and,
+// for the Bloom filter, from a replicated copy
+int main(int argc, char **argv) {
+  ygm::comm world(&argc, &argv);
+
+  size_t num_keys = 2000000;
+  if (argc > 1) {
+    num_keys = std::stoull(argv[1]);
+  }
+  world.cout0("Keys per rank: ", num_keys);
+
+  // Absent probes come from another generator and almost surely miss
+  std::mt19937_64     rng(world.rank());
+  std::mt19937_64     absent_rng(world.size() + world.rank());
+  std::vector<size_t> keys(num_keys);
+  std::vector<size_t> probes(num_keys);
+  for (size_t i = 0; i < num_keys; ++i) {
+    keys[i]   = rng();
+    probes[i] = i % 2 ? absent_rng() : keys[i];
+  }
+
+  auto time = [&world](auto fn) {
+    world.barrier();
+    double start = MPI_Wtime();
+    fn();
+    world.barrier();
+    return world.all_reduce_max(MPI_Wtime() - start);
+  };
+  static size_t hits;
+
+  {
+    ygm::container::set<size_t> s(world);
+    double insert_time = time([&]() {
+      for (size_t key : keys) {
+        s.async_insert(key);
+      }
+    });
+    hits              = 0;
+    double probe_time = time([&]() {
+      for (size_t key : probes) {
+        s.async_exe_if_contains(key, [](const size_t &key) { ++hits; });
+      }
+    });
+    world.cout0("set: insert ", insert_time, " s, probe ", probe_time, " s, ",
+                world.all_reduce_sum(s.local_memory_bytes()) / (1024 * 1024),
+                " MiB, ", world.all_reduce_sum(hits), " hits");
+  }
+
+  ygm::container::bloom_filter<size_t> bf(world, num_keys * world.size());
+  double insert_time = time([&]() {
+    for (size_t key : keys) {
+      bf.async_insert(key);
+    }
+  });
+  hits              = 0;
+  double probe_time = time([&]() {
+    for (size_t key : probes) {
+      bf.async_test_and_execute(key, [](const size_t &key, bool present) {
+        hits += present;
+      });
+    }
+  });
+  world.cout0("bloom_filter: insert ", insert_time, " s, probe ", probe_time,
+              " s, ",
+              world.all_reduce_sum(bf.local_memory_bytes()) / (1024 * 1024),
+              " MiB, ", world.all_reduce_sum(hits), " hits");
+
+  size_t local_hits     = 0;
+  double replicate_time = time([&]() { bf.replicate(); });
+  double local_time     = time([&]() {
+    for (size_t key : probes) {
+      local_hits += bf.local_maybe_contains(key);
+    }
+  });
+  world.cout0("bloom_filter replicated: replicate ", replicate_time,
+              " s, probe ", local_time, " s, ",
+              world.all_reduce_sum(local_hits), " hits");
+  return 0;
+}
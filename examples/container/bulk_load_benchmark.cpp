@@ -0,0 +1,52 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#include <random>
+#include <ygm/comm.hpp>
+#include <ygm/container/bag.hpp>
+#include <ygm/container/map.hpp>
+
+// Counts the degree of every vertex of a random edge list, once with one
+// async_reduce per edge endpoint and once with map::bulk_load
+int main(int argc, char **argv) {
+  ygm::comm world(&argc, &argv);
+
+  size_t num_edges = 1000000;
+  if (argc > 1) {
+    num_edges = std::stoull(argv[1]);
+  }
+  world.cout0("Edges per rank: ", num_edges);
+
+  const uint64_t num_vertices = num_edges * world.size() / 4;
+  ygm::container::bag<std::pair<uint64_t, uint64_t>> degrees(world);
+  std::mt19937_64                                    rng(world.rank());
+  for (size_t i = 0; i < num_edges; ++i) {
+    degrees.async_insert({rng() % num_vertices, 1});
+    degrees.async_insert({rng() % num_vertices, 1});
+  }
+  world.barrier();
+
+  ygm::container::map<uint64_t, uint64_t> async_degrees(world);
+  world.barrier();
+  double start = MPI_Wtime();
+  degrees.for_all([&async_degrees](const uint64_t &v, const uint64_t &d) {
+    async_degrees.async_reduce(v, d, std::plus<uint64_t>());
+  });
+  world.barrier();
+  double async_time = MPI_Wtime() - start;
+
+  ygm::container::map<uint64_t, uint64_t> bulk_degrees(world);
+  world.barrier();
+  start = MPI_Wtime();
+  bulk_degrees.bulk_load(degrees, std::plus<uint64_t>());
+  world.barrier();
+  double bulk_time = MPI_Wtime() - start;
+
+  world.cout0("async_reduce load: ", async_time, " s, ",
+              async_degrees.size(), " vertices");
+  world.cout0("bulk_load: ", bulk_time, " s, ", bulk_degrees.size(),
+              " vertices");
+  return 0;
+}
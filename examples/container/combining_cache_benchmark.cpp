@@ -0,0 +1,75 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#include <cmath>
+#include <random>
+#include <ygm/comm.hpp>
+#include <ygm/container/counting_set.hpp>
+#include <ygm/container/detail/reducing_adapter.hpp>
+#include <ygm/container/map.hpp>
+
+// Counts Zipf-distributed keys with counting_set and a reducing_adapter and
+// reports how many messages their combining caches saved
+int main(int argc, char **argv) {
+  ygm::comm world(&argc, &argv);
+
+  size_t num_ops  = 1000000;
+  size_t num_keys = 1000000;
+  double exponent = 1.1;
+  if (argc > 1) {
+    num_ops = std::stoull(argv[1]);
+  }
+  if (argc > 2) {
+    exponent = std::stod(argv[2]);
+  }
+  world.cout0("Operations per rank: ", num_ops, ", keys: ", num_keys,
+              ", Zipf exponent: ", exponent);
+
+  std::vector<double> weights(num_keys);
+  for (size_t i = 0; i < num_keys; ++i) {
+    weights[i] = 1.0 / std::pow(double(i + 1), exponent);
+  }
+  std::discrete_distribution<uint64_t> zipf(weights.begin(), weights.end());
+  std::vector<uint64_t>                keys(num_ops);
+  std::mt19937_64                      rng(world.rank());
+  for (auto &key : keys) {
+    key = zipf(rng);
+  }
+
+  auto report = [&world, num_ops](const std::string &name,
+                                  const double time, const auto &stats) {
+    world.cout0(name, ": ", time, " s, ", num_ops * world.size() / time / 1e6,
+                " M ops/s, hits ", world.all_reduce_sum(stats.hits),
+                ", misses ", world.all_reduce_sum(stats.misses),
+                ", messages ", world.all_reduce_sum(stats.flushes),
+                ", capacity ", stats.capacity);
+  };
+
+  {
+    ygm::container::counting_set<uint64_t> cset(world);
+    world.barrier();
+    double start = MPI_Wtime();
+    for (const auto &key : keys) {
+      cset.async_insert(key);
+    }
+    world.barrier();
+    report("counting_set", MPI_Wtime() - start, cset.cache_stats());
+  }
+
+  {
+    ygm::container::map<uint64_t, uint64_t> sums(world);
+    auto adapter = ygm::container::detail::make_reducing_adapter(
+        sums, [](const uint64_t a, const uint64_t b) { return a + b; });
+    world.barrier();
+    double start = MPI_Wtime();
+    for (const auto &key : keys) {
+      adapter.async_reduce(key, 1);
+    }
+    world.barrier();
+    report("reducing_adapter", MPI_Wtime() - start, adapter.cache_stats());
+  }
+
+  return 0;
+}
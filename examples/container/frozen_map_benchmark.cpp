@@ -0,0 +1,70 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#include <random>
+#include <ygm/comm.hpp>
+#include <ygm/container/map.hpp>
+
+// Times local lookups of random uint64 keys in a map before and after
+// freeze(). checksum sums the values found, so both layouts must agree.
+template <typename Lookup>
+double time_lookups(const size_t num_keys, Lookup lookup, uint64_t &checksum) {
+  std::mt19937_64 rng(42);
+  checksum     = 0;
+  double start = MPI_Wtime();
+  for (size_t i = 0; i < num_keys; ++i) {
+    checksum += lookup(rng() % (2 * num_keys));
+  }
+  return MPI_Wtime() - start;
+}
+
+int main(int argc, char **argv) {
+  ygm::comm world(&argc, &argv);
+
+  size_t num_keys = 1000000;
+  if (argc > 1) {
+    num_keys = std::stoull(argv[1]);
+  }
+  world.cout0("Keys per rank: ", num_keys);
+
+  ygm::container::map<uint64_t, uint64_t> m(world);
+  std::mt19937_64                         rng(world.rank());
+  for (size_t i = 0; i < num_keys; ++i) {
+    uint64_t key = rng() % (2 * num_keys * world.size());
+    m.async_insert(key, key);
+  }
+  world.barrier();
+
+  // Local lookups isolate the layouts from messaging costs
+  uint64_t map_sum  = 0;
+  double   map_time = time_lookups(
+      num_keys,
+      [&m](const uint64_t key) {
+        auto values = m.local_get(key * 4 + 1);
+        return values.empty() ? 0 : values.front();
+      },
+      map_sum);
+
+  auto     frozen      = m.freeze();
+  uint64_t frozen_sum  = 0;
+  double   frozen_time = time_lookups(
+      num_keys,
+      [&frozen](const uint64_t key) {
+        const uint64_t *value = frozen.local_find(key * 4 + 1);
+        return value ? *value : 0;
+      },
+      frozen_sum);
+
+  world.cout0("map local lookups: ", world.all_reduce_max(map_time), " s");
+  world.cout0("frozen_map local lookups: ", world.all_reduce_max(frozen_time),
+              " s");
+  world.cout0("Bytes per entry: frozen_map ",
+              sizeof(uint64_t) + sizeof(uint64_t),
+              ", std::multimap node about ",
+              sizeof(std::pair<const uint64_t, uint64_t>) + 4 * sizeof(void *));
+  world.cout0("Checksums: map ", world.all_reduce_sum(map_sum),
+              ", frozen_map ", world.all_reduce_sum(frozen_sum));
+  return 0;
+}
@@ -0,0 +1,68 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#include <cmath>
+#include <random>
+#include <ygm/comm.hpp>
+#include <ygm/container/hot_key_adapter.hpp>
+#include <ygm/container/map.hpp>
+
+// Counts Zipf-distributed keys with plain reductions and with a
+// hot_key_adapter, and reports how evenly the work lands on the ranks
+int main(int argc, char **argv) {
+  ygm::comm world(&argc, &argv);
+
+  size_t num_ops  = 1000000;
+  size_t num_keys = 100000;
+  if (argc > 1) {
+    num_ops = std::stoull(argv[1]);
+  }
+  world.cout0("Operations per rank: ", num_ops, ", keys: ", num_keys);
+
+  std::vector<double> weights(num_keys);
+  for (size_t i = 0; i < num_keys; ++i) {
+    weights[i] = 1.0 / std::pow(double(i + 1), 1.1);
+  }
+  std::discrete_distribution<uint64_t> zipf(weights.begin(), weights.end());
+  auto reducer = [](const uint64_t a, const uint64_t b) { return a + b; };
+
+  {
+    ygm::container::map<uint64_t, uint64_t> counts(world);
+    std::mt19937_64                         rng(world.rank());
+
+    world.barrier();
+    double start = MPI_Wtime();
+    for (size_t i = 0; i < num_ops; ++i) {
+      counts.async_reduce(zipf(rng), 1, reducer);
+    }
+    world.barrier();
+    world.cout0("map::async_reduce: ", MPI_Wtime() - start, " s");
+  }
+
+  {
+    ygm::container::map<uint64_t, uint64_t> counts(world);
+    std::mt19937_64                         rng(world.rank());
+    auto adapter = ygm::container::make_hot_key_adapter(counts, reducer);
+
+    world.barrier();
+    double start = MPI_Wtime();
+    // Hot keys are picked at each sync(), so sync a few times along the way
+    for (size_t epoch = 0; epoch < 10; ++epoch) {
+      for (size_t i = 0; i < num_ops / 10; ++i) {
+        adapter.async_reduce(zipf(rng), 1);
+      }
+      adapter.sync();
+    }
+    world.cout0("hot_key_adapter::async_reduce: ", MPI_Wtime() - start, " s");
+
+    auto stats = adapter.load_stats();
+    world.cout0("Hot keys: ", stats.num_hot_keys,
+                ", load imbalance without replication: ",
+                stats.direct_imbalance(),
+                ", with replication: ", stats.actual_imbalance());
+  }
+
+  return 0;
+}
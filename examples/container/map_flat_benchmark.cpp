@@ -0,0 +1,72 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#include <random>
+#include <ygm/comm.hpp>
+#include <ygm/container/map.hpp>
+#include <ygm/container/set.hpp>
+
+// Compares tree-backed and flat hash-backed map/set on random uint64 keys
+template <typename Map>
+void bench_map(ygm::comm &world, const std::string &name,
+               const size_t num_keys) {
+  Map             m(world);
+  std::mt19937_64 rng(world.rank());
+
+  world.barrier();
+  double start = MPI_Wtime();
+  for (size_t i = 0; i < num_keys; ++i) {
+    m.async_insert(rng(), i);
+  }
+  world.barrier();
+  double insert_time = MPI_Wtime() - start;
+
+  rng.seed(world.rank());
+  start = MPI_Wtime();
+  for (size_t i = 0; i < num_keys; ++i) {
+    m.async_visit_if_exists(rng(),
+                            [](const uint64_t &k, uint64_t &v) { ++v; });
+  }
+  world.barrier();
+  double visit_time = MPI_Wtime() - start;
+
+  world.cout0(name, ": insert ", insert_time, " s, visit ", visit_time,
+              " s, size ", m.size());
+}
+
+template <typename Set>
+void bench_set(ygm::comm &world, const std::string &name,
+               const size_t num_keys) {
+  Set             s(world);
+  std::mt19937_64 rng(world.rank());
+
+  world.barrier();
+  double start = MPI_Wtime();
+  for (size_t i = 0; i < num_keys; ++i) {
+    s.async_insert(rng() % (num_keys * world.size() / 2));
+  }
+  world.barrier();
+  double insert_time = MPI_Wtime() - start;
+
+  world.cout0(name, ": insert ", insert_time, " s, size ", s.size());
+}
+
+int main(int argc, char **argv) {
+  ygm::comm world(&argc, &argv);
+
+  size_t num_keys = 1000000;
+  if (argc > 1) {
+    num_keys = std::stoull(argv[1]);
+  }
+  world.cout0("Keys per rank: ", num_keys);
+
+  bench_map<ygm::container::map<uint64_t, uint64_t>>(world, "map", num_keys);
+  bench_map<ygm::container::flat_map<uint64_t, uint64_t>>(world, "flat_map",
+                                                          num_keys);
+  bench_set<ygm::container::set<uint64_t>>(world, "set", num_keys);
+  bench_set<ygm::container::flat_set<uint64_t>>(world, "flat_set", num_keys);
+
+  return 0;
+}
@@ -0,0 +1,71 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#include <map>
+#include <random>
+#include <string>
+#include <ygm/comm.hpp>
+#include <ygm/container/detail/pool_allocator.hpp>
+
+// Times filling, clearing and destroying the local std::multimap a ygm::map
+// keeps per rank, with std::allocator and with the pool allocators
+template <typename Alloc>
+void run(ygm::comm &world, const std::string &name, const size_t num_keys) {
+  using local_map = std::multimap<uint64_t, uint64_t, std::less<uint64_t>,
+                                  Alloc>;
+  std::mt19937_64 rng(world.rank());
+
+  auto  *m     = new local_map();
+  double start = MPI_Wtime();
+  for (size_t i = 0; i < num_keys; ++i) {
+    m->emplace(rng(), i);
+  }
+  double insert_time = MPI_Wtime() - start;
+
+  // Arena bytes per entry, or for std::allocator a tree node plus the
+  // malloc chunk header, rounded to malloc's 16-byte chunks
+  double bytes_per_entry =
+      (sizeof(typename local_map::value_type) + 4 * sizeof(void *) +
+       sizeof(size_t) + 15) / 16 * 16;
+  if constexpr (!std::is_same_v<Alloc, std::allocator<
+                                           typename local_map::value_type>>) {
+    bytes_per_entry =
+        double(m->get_allocator().stats().bytes_reserved) / num_keys;
+  }
+
+  start = MPI_Wtime();
+  m->clear();
+  double clear_time = MPI_Wtime() - start;
+
+  for (size_t i = 0; i < num_keys; ++i) {
+    m->emplace(rng(), i);
+  }
+  start = MPI_Wtime();
+  delete m;
+  double destroy_time = MPI_Wtime() - start;
+
+  world.cout0(name, ": insert ", world.all_reduce_max(insert_time),
+              " s, clear ", world.all_reduce_max(clear_time), " s, destroy ",
+              world.all_reduce_max(destroy_time), " s, ", bytes_per_entry,
+              " bytes per entry");
+}
+
+int main(int argc, char **argv) {
+  ygm::comm world(&argc, &argv);
+
+  size_t num_keys = 1000000;
+  if (argc > 1) {
+    num_keys = std::stoull(argv[1]);
+  }
+  world.cout0("Keys per rank: ", num_keys);
+
+  using value_type = std::pair<const uint64_t, uint64_t>;
+  run<std::allocator<value_type>>(world, "std::allocator", num_keys);
+  run<ygm::container::detail::pool_allocator<value_type>>(
+      world, "pool_allocator", num_keys);
+  run<ygm::container::detail::pool_allocator<value_type, true>>(
+      world, "pool_allocator<huge pages>", num_keys);
+  return 0;
+}
@@ -0,0 +1,72 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <ygm/comm.hpp>
+#include <ygm/container/bag.hpp>
+#include <ygm/container/quantile_sketch.hpp>
+
+// Computes percentiles of log-normal "latencies" by gathering a bag to rank 0
+// and sorting, and with quantile_sketch, then reports the sketch's error
+int main(int argc, char **argv) {
+  ygm::comm world(&argc, &argv);
+
+  size_t num_items = 1000000;
+  if (argc > 1) {
+    num_items = std::stoull(argv[1]);
+  }
+  world.cout0("Items per rank: ", num_items);
+
+  std::mt19937_64               rng(world.rank());
+  std::lognormal_distribution<> latency(0.0, 1.0);
+  std::vector<double>           items(num_items);
+  const std::vector<double>     qs = {0.5, 0.9, 0.99, 0.999};
+  std::generate(items.begin(), items.end(), [&]() { return latency(rng); });
+
+  auto time = [&world](auto fn) {
+    world.barrier();
+    double start = MPI_Wtime();
+    fn();
+    world.barrier();
+    return world.all_reduce_max(MPI_Wtime() - start);
+  };
+
+  std::vector<double> exact(qs.size());
+  {
+    ygm::container::bag<double> b(world);
+    double gather_time = time([&]() {
+      for (double x : items) {
+        b.async_insert(x);
+      }
+      auto all = b.gather_to_vector(0);
+      if (world.rank0()) {
+        std::sort(all.begin(), all.end());
+        for (size_t i = 0; i < qs.size(); ++i) {
+          exact[i] = all[size_t(qs[i] * (all.size() - 1))];
+        }
+      }
+    });
+    world.cout0("bag gather: ", gather_time, " s");
+  }
+
+  ygm::container::quantile_sketch<double> sketch(world);
+  std::vector<double>                     approx;
+  double sketch_time = time([&]() {
+    for (double x : items) {
+      sketch.async_insert(x);
+    }
+    approx = sketch.quantiles(qs);
+  });
+  world.cout0("quantile_sketch: ", sketch_time, " s, ",
+              world.all_reduce_max(sketch.local_memory_bytes()) / 1024,
+              " KiB per rank");
+  for (size_t i = 0; i < qs.size(); ++i) {
+    world.cout0("  q ", qs[i], ": exact ", exact[i], ", sketch ", approx[i],
+                ", rank error ", std::abs(sketch.cdf(exact[i]) - qs[i]));
+  }
+  return 0;
+}
@@ -0,0 +1,100 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#include <random>
+#include <string>
+#include <ygm/comm.hpp>
+#include <ygm/container/approximate_counting_set.hpp>
+#include <ygm/container/counting_set.hpp>
+#include <ygm/container/distinct_counter.hpp>
+#include <ygm/container/set.hpp>
+
+// Counts a skewed stream of keys exactly with counting_set and set, and
+// approximately with approximate_counting_set and distinct_counter, comparing
+// time, memory and the answers
+int main(int argc, char **argv) {
+  ygm::comm world(&argc, &argv);
+
+  size_t num_inserts = 4000000;
+  if (argc > 1) {
+    num_inserts = std::stoull(argv[1]);
+  }
+  world.cout0("Inserts per rank: ", num_inserts);
+
+  // Half the inserts draw from 1000 hot keys, half from a huge range
+  std::mt19937_64     rng(world.rank());
+  std::vector<size_t> keys;
+  keys.reserve(num_inserts);
+  for (size_t i = 0; i < num_inserts; ++i) {
+    keys.push_back(i % 2 ? rng() % 1000 : rng() % (num_inserts * 1000));
+  }
+
+  auto by_count = [](const auto &a, const auto &b) {
+    return a.second > b.second;
+  };
+  auto time = [&world](auto fn) {
+    world.barrier();
+    double start = MPI_Wtime();
+    fn();
+    world.barrier();
+    return world.all_reduce_max(MPI_Wtime() - start);
+  };
+  auto global_bytes = [&world](const size_t local) {
+    return double(world.all_reduce_sum(local)) / (1024 * 1024);
+  };
+
+  {
+    ygm::container::counting_set<size_t> cset(world);
+    double insert_time = time([&]() {
+      for (size_t key : keys) {
+        cset.async_insert(key);
+      }
+    });
+    size_t distinct = cset.size();
+    auto   top      = cset.topk(1, by_count);
+    world.cout0("counting_set: ", insert_time, " s, ",
+                global_bytes(cset.local_memory_bytes()), " MiB, ", distinct,
+                " keys, top count ", top[0].second);
+  }
+
+  {
+    ygm::container::approximate_counting_set<size_t> acs(world);
+    double insert_time = time([&]() {
+      for (size_t key : keys) {
+        acs.async_insert(key);
+      }
+    });
+    size_t distinct = acs.size();
+    auto   top      = acs.topk(1, by_count);
+    world.cout0("approximate_counting_set: ", insert_time, " s, ",
+                global_bytes(acs.local_memory_bytes()), " MiB, ", distinct,
+                " keys, top count ", top[0].second);
+  }
+
+  {
+    ygm::container::set<size_t> s(world);
+    double insert_time = time([&]() {
+      for (size_t key : keys) {
+        s.async_insert(key);
+      }
+    });
+    world.cout0("set: ", insert_time, " s, ",
+                global_bytes(s.local_memory_bytes()), " MiB, ", s.size(),
+                " keys");
+  }
+
+  {
+    ygm::container::distinct_counter<size_t> dc(world);
+    double insert_time = time([&]() {
+      for (size_t key : keys) {
+        dc.async_insert(key);
+      }
+    });
+    world.cout0("distinct_counter: ", insert_time, " s, ",
+                global_bytes(dc.local_memory_bytes()), " MiB, ", dc.count(),
+                " keys");
+  }
+  return 0;
+}
@@ -0,0 +1,45 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#include <random>
+#include <ygm/comm.hpp>
+#include <ygm/container/map.hpp>
+#include <ygm/container/sort.hpp>
+
+// Compares sample sort into an array against the old stand-in of inserting
+// every item into a tree-backed multimap
+int main(int argc, char **argv) {
+  ygm::comm world(&argc, &argv);
+
+  size_t num_items = 1000000;
+  if (argc > 1) {
+    num_items = std::stoull(argv[1]);
+  }
+  world.cout0("Items per rank: ", num_items);
+
+  ygm::container::bag<uint64_t> items(world);
+  std::mt19937_64               rng(world.rank());
+  for (size_t i = 0; i < num_items; ++i) {
+    items.async_insert(rng(), world.rank());
+  }
+  world.barrier();
+
+  double start  = MPI_Wtime();
+  auto   sorted = ygm::container::sort(items);
+  world.barrier();
+  world.cout0("sample sort: ", MPI_Wtime() - start, " s, size ",
+              sorted.size());
+
+  start = MPI_Wtime();
+  ygm::container::multimap<uint64_t, bool> as_map(world);
+  items.for_all([&as_map](const uint64_t &item) {
+    as_map.async_insert(item, true);
+  });
+  world.barrier();
+  world.cout0("multimap insert: ", MPI_Wtime() - start, " s, size ",
+              as_map.size());
+
+  return 0;
+}
@@ -0,0 +1,82 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#include <random>
+#include <string>
+#include <vector>
+#include <ygm/comm.hpp>
+#include <ygm/container/map.hpp>
+#include <ygm/container/string_map.hpp>
+
+// Counts short random words with map<std::string, size_t> and with
+// string_map<size_t>, then times local lookups and compares key storage
+template <typename Map, typename Lookup>
+void run(ygm::comm &world, const std::string &name, Map &m,
+         const std::vector<std::string> &words, Lookup lookup) {
+  world.barrier();
+  double start = MPI_Wtime();
+  for (const auto &word : words) {
+    m.async_reduce(word, 1, std::plus<size_t>());
+  }
+  world.barrier();
+  double insert_time = MPI_Wtime() - start;
+
+  size_t found = 0;
+  start        = MPI_Wtime();
+  for (int rep = 0; rep < 4; ++rep) {
+    for (const auto &word : words) {
+      found += lookup(word);
+    }
+  }
+  double lookup_time = MPI_Wtime() - start;
+
+  world.cout0(name, ": count ", world.all_reduce_max(insert_time),
+              " s, local lookups ", world.all_reduce_max(lookup_time), " s (",
+              world.all_reduce_sum(found), " found)");
+}
+
+int main(int argc, char **argv) {
+  ygm::comm world(&argc, &argv);
+
+  size_t num_words = 1000000;
+  if (argc > 1) {
+    num_words = std::stoull(argv[1]);
+  }
+  world.cout0("Words per rank: ", num_words);
+
+  // Words of 3 to 12 letters from a vocabulary of about num_words per rank
+  std::mt19937_64          rng(world.rank());
+  std::vector<std::string> words;
+  for (size_t i = 0; i < num_words; ++i) {
+    std::mt19937_64 word_rng(rng() % (num_words * world.size()));
+    std::string     word(3 + word_rng() % 10, 'a');
+    for (auto &c : word) {
+      c = 'a' + word_rng() % 26;
+    }
+    words.push_back(std::move(word));
+  }
+
+  {
+    ygm::container::map<std::string, size_t> m(world);
+    run(world, "map<std::string, size_t>", m, words,
+        [&m](const std::string &word) { return m.local_get(word).size(); });
+  }
+
+  ygm::container::string_map<size_t> sm(world);
+  run(world, "string_map<size_t>", sm, words, [&sm](const std::string &word) {
+    return size_t(sm.local_find(word) != nullptr);
+  });
+
+  // A tree node holds the std::string and count plus four words of links,
+  // rounded up to the pool allocator's 16-byte size classes
+  size_t node_bytes =
+      (sizeof(std::pair<const std::string, size_t>) + 4 * sizeof(void *) +
+       15) / 16 * 16;
+  world.cout0("Key bytes per entry: map about ", node_bytes - sizeof(size_t),
+              ", string_map ",
+              double(world.all_reduce_sum(sm.local_key_bytes())) /
+                  world.all_reduce_sum(sm.local_size()));
+  return 0;
+}
@@ -5,6 +5,10 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <vector>
 #include <ygm/comm.hpp>
 
 namespace ygm {
@@ -169,4 +173,141 @@ bool is_same(const T &to_check, comm &cm, const Equal &equals = Equal()) {
   return logical_and(local_is_same, cm);
 }
 
+/**
+ * @brief Default bound on the packed bytes each rank sends per round of
+ * exchange.
+ */
+constexpr size_t exchange_default_chunk_bytes = 64 * 1024 * 1024;
+
+/**
+ * @brief Collective all-to-all exchange. Every item of outgoing[dest] is
+ * delivered to rank dest, which calls fn(from, item) or fn(item) for it.
+ *
+ * Items are packed into one buffer and moved with MPI_Alltoallv in rounds of
+ * about chunk_bytes sent and received per rank. Only these per-round staging
+ * buffers are bounded: outgoing is built in full by the caller, and fn must
+ * consume items as they arrive to keep the receiving side bounded too. Within
+ * a round items arrive grouped by source rank, each source's items in the
+ * order they were given.
+ *
+ * @param outgoing Items to send, indexed by destination rank
+ * @param fn Receiver of each incoming item
+ * @param c Communicator
+ * @param chunk_bytes Packed bytes each rank sends per round
+ */
+template <typename T, typename Function>
+void exchange(const std::vector<std::vector<T>> &outgoing, Function fn,
+              comm &c, size_t chunk_bytes = exchange_default_chunk_bytes) {
+  constexpr bool is_raw = std::is_trivially_copyable<T>::value &&
+                          std::is_standard_layout<T>::value;
+  const int size = c.size();
+  ASSERT_RELEASE(outgoing.size() == size_t(size));
+  c.barrier();
+  MPI_Comm mpi_comm = c.get_mpi_comm();
+
+  const size_t dest_budget = std::max<size_t>(chunk_bytes / size, 1);
+
+  std::vector<size_t>    next_item(size, 0);
+  std::vector<int>       send_counts(size), send_displs(size);
+  std::vector<int>       recv_counts(size), recv_displs(size);
+  std::vector<std::byte> send_buffer, recv_buffer;
+
+  auto deliver = [&fn](int from, T &item) {
+    if constexpr (std::is_invocable<Function, int, T &>()) {
+      fn(from, item);
+    } else {
+      fn(item);
+    }
+  };
+
+  bool more = true;
+  while (more) {
+    send_buffer.clear();
+    bool local_more = false;
+    for (int dest = 0; dest < size; ++dest) {
+      const auto  &items = outgoing[dest];
+      size_t      &i     = next_item[dest];
+      const size_t start = send_buffer.size();
+      if constexpr (is_raw) {
+        size_t n = std::min(items.size() - i,
+                            std::max<size_t>(dest_budget / sizeof(T), 1));
+        send_buffer.resize(start + n * sizeof(T));
+        std::memcpy(send_buffer.data() + start, items.data() + i,
+                    n * sizeof(T));
+        i += n;
+      } else {
+        cereal::YGMOutputArchive oarchive(send_buffer);
+        while (i < items.size() && send_buffer.size() - start < dest_budget) {
+          oarchive(items[i++]);
+        }
+      }
+      ASSERT_RELEASE(send_buffer.size() < std::numeric_limits<int>::max());
+      send_displs[dest] = start;
+      send_counts[dest] = send_buffer.size() - start;
+      local_more |= i < items.size();
+    }
+
+    ASSERT_MPI(MPI_Alltoall(send_counts.data(), 1, MPI_INT, recv_counts.data(),
+                            1, MPI_INT, mpi_comm));
+    size_t recv_total = 0;
+    for (int from = 0; from < size; ++from) {
+      recv_displs[from] = recv_total;
+      recv_total += recv_counts[from];
+      ASSERT_RELEASE(recv_total < std::numeric_limits<int>::max());
+    }
+    recv_buffer.resize(recv_total);
+    ASSERT_MPI(MPI_Alltoallv(send_buffer.data(), send_counts.data(),
+                             send_displs.data(), MPI_BYTE, recv_buffer.data(),
+                             recv_counts.data(), recv_displs.data(), MPI_BYTE,
+                             mpi_comm));
+
+    for (int from = 0; from < size; ++from) {
+      std::byte *data = recv_buffer.data() + recv_displs[from];
+      if constexpr (is_raw) {
+        for (int offset = 0; offset < recv_counts[from];
+             offset += sizeof(T)) {
+          T item;
+          std::memcpy(&item, data + offset, sizeof(T));
+          deliver(from, item);
+        }
+      } else {
+        cereal::YGMInputArchive iarchive(data, recv_counts[from]);
+        while (!iarchive.empty()) {
+          T item;
+          iarchive(item);
+          deliver(from, item);
+        }
+      }
+    }
+
+    ASSERT_MPI(MPI_Allreduce(&local_more, &more, 1,
+                             detail::mpi_typeof(bool()), MPI_LOR, mpi_comm));
+  }
+}
+
+/**
+ * @brief Collective all-to-all exchange returning the items received by this
+ * rank, ordered by source rank and then by position in the source's
+ * outgoing list. Holds every incoming item at once; use the overload taking
+ * fn to process them as they arrive.
+ */
+template <typename T>
+std::vector<T> exchange(const std::vector<std::vector<T>> &outgoing, comm &c,
+                        size_t chunk_bytes = exchange_default_chunk_bytes) {
+  std::vector<std::vector<T>> received(c.size());
+  exchange(
+      outgoing,
+      [&received](int from, T &item) {
+        received[from].push_back(std::move(item));
+      },
+      c, chunk_bytes);
+
+  std::vector<T> to_return;
+  for (auto &items : received) {
+    to_return.insert(to_return.end(), std::make_move_iterator(items.begin()),
+                     std::make_move_iterator(items.end()));
+  }
+  return to_return;
+}
+
 }  // namespace ygm
\ No newline at end of file
@@ -7,6 +7,8 @@
 
 #include <deque>
 #include <functional>
+#include <limits>
+#include <map>
 #include <memory>
 #include <vector>
 
@@ -15,6 +17,7 @@
 #include <ygm/detail/comm_stats.hpp>
 #include <ygm/detail/lambda_map.hpp>
 #include <ygm/detail/layout.hpp>
+#include <ygm/detail/memory_registry.hpp>
 #include <ygm/detail/meta/functional.hpp>
 #include <ygm/detail/mpi.hpp>
 #include <ygm/detail/ygm_cereal_archive.hpp>
@@ -22,6 +25,8 @@
 
 namespace ygm {
 
+using routing_type = detail::routing_type;
+
 namespace detail {
 class interrupt_mask;
 class comm_stats;
@@ -44,8 +49,31 @@ class comm {
   // map<MPI_Comm, impl*>
   comm(MPI_Comm comm);
 
+  /**
+   * @brief Builds a comm on an initialized MPI_Comm with explicit settings
+   * instead of the ones read from the environment
+   */
+  comm(MPI_Comm comm, const detail::comm_environment &env);
+
   ~comm();
 
+  /**
+   * @brief Collectively splits this communicator into disjoint
+   * sub-communicators, as MPI_Comm_split.
+   *
+   * The sub-communicator does not own any MPI buffers. Its messages travel
+   * through the send buffers, receive buffers and progress engine of the
+   * communicator it was split from, and are delivered directly to their
+   * destination without routing hops. Barriers on the sub-communicator only
+   * involve its members.
+   *
+   * @param color Non-negative color selecting the sub-communicator to join
+   * @param key Controls rank assignment within the sub-communicator
+   * @return Owning pointer to the new sub-communicator. It must be destroyed
+   * before the communicator it was split from.
+   */
+  std::unique_ptr<comm> split(int color, int key);
+
   /**
    * @brief Prints a welcome message with configuration details.
    *
@@ -55,6 +83,17 @@ class comm {
   void stats_reset();
   void stats_print(const std::string &name = "", std::ostream &os = std::cout);
 
+  /**
+   * @brief Bytes held by this rank's message buffers, with high-water marks
+   */
+  detail::comm_memory_usage memory_usage() const;
+
+  /**
+   * @brief This rank's registry of container memory estimates, read by
+   * ygm::memory_report()
+   */
+  detail::memory_registry &memory_sources() { return m_memory_sources; }
+
   //
   //  Asynchronous rpc interfaces.   Can be called inside OpenMP loop
   //
@@ -62,6 +101,21 @@ class comm {
   template <typename AsyncFunction, typename... SendArgs>
   void async(int dest, AsyncFunction fn, const SendArgs &...args);
 
+  /**
+   * @brief Asynchronous rpc using the given routing instead of the configured
+   * YGM_COMM_ROUTING. Messages routed differently from the configured routing
+   * carry a small marker so that intermediate ranks can keep forwarding them
+   * along the requested route.
+   *
+   * @param route Routing for this message. routing_type::DEFAULT uses the
+   * configured routing and routing_type::ADAPTIVE picks NONE or NLNR from the
+   * volume previously sent to dest. Ignored on sub-communicators, whose
+   * messages are always sent directly.
+   */
+  template <typename AsyncFunction, typename... SendArgs>
+  void async(const routing_type route, int dest, AsyncFunction fn,
+             const SendArgs &...args);
+
   template <typename AsyncFunction, typename... SendArgs>
   void async_bcast(AsyncFunction fn, const SendArgs &...args);
 
@@ -86,6 +140,12 @@ class comm {
    */
   void barrier();
 
+  /**
+   * @brief Number of barrier() calls completed on this communicator. Caches of
+   * remote data can compare it to detect that an epoch has ended.
+   */
+  uint64_t barrier_epoch() const { return m_barrier_epoch; }
+
   void local_progress();
 
   bool local_process_incoming();
@@ -158,11 +218,42 @@ class comm {
 
   // Private member functions
  private:
+  comm(comm *parent, int color, int key);
+
   void comm_setup(MPI_Comm comm);
 
+  static detail::comm_environment initial_config(MPI_Comm comm);
+
+  MPI_Comm split_mpi_comm(int color, int key);
+
+  bool is_sub_comm() const { return m_root != this; }
+
+  template <typename PackFunction>
+  void queue_message(const int dest, const routing_type route,
+                     PackFunction pack_fn);
+
+  routing_type resolve_route(const int dest, const routing_type route);
+
+  void forward_message(const header_t &h, routing_type route,
+                       cereal::YGMInputArchive &iarchive);
+
+  static constexpr uint16_t route_marker(const routing_type route) {
+    return route_marker_base + static_cast<uint16_t>(route);
+  }
+
+  static constexpr bool is_route_marker(const uint16_t lid) {
+    return lid >= route_marker_base;
+  }
+
+  template <typename AsyncFunction, typename... SendArgs>
+  void async_sub_comm(const uint32_t sub_comm_id, int root_dest,
+                      AsyncFunction fn, const SendArgs &...args);
+
   size_t pack_header(std::vector<std::byte> &packed, const int dest,
                      size_t size);
 
+  size_t pack_marker(std::vector<std::byte> &packed, const routing_type route);
+
   std::pair<uint64_t, uint64_t> barrier_reduce_counts();
 
   void flush_send_buffer(int dest);
@@ -182,6 +273,11 @@ class comm {
   template <typename Lambda, typename... PackArgs>
   void pack_lambda_broadcast(Lambda l, const PackArgs &...args);
 
+  template <typename Lambda, typename... PackArgs>
+  size_t pack_lambda_sub_comm(std::vector<std::byte> &packed,
+                              const uint32_t sub_comm_id, Lambda l,
+                              const PackArgs &...args);
+
   template <typename Lambda, typename RemoteLogicLambda, typename... PackArgs>
   size_t pack_lambda_generic(std::vector<std::byte> &packed, Lambda l,
                              RemoteLogicLambda rll, const PackArgs &...args);
@@ -192,6 +288,10 @@ class comm {
   void handle_next_receive(MPI_Status                   status,
                            std::shared_ptr<std::byte[]> buffer);
 
+  void handle_received_bytes(std::byte *data, int count);
+
+  bool process_loopback_queue();
+
   bool process_receive_queue();
 
   template <typename... Args>
@@ -220,6 +320,9 @@ class comm {
   std::deque<mpi_isend_request>                        m_send_queue;
   std::vector<std::shared_ptr<std::vector<std::byte>>> m_free_send_buffers;
 
+  // Send buffers addressed to this rank, handed over without MPI
+  std::deque<std::shared_ptr<std::vector<std::byte>>> m_loopback_queue;
+
   size_t m_pending_isend_bytes = 0;
 
   std::deque<std::function<void()>> m_pre_barrier_callbacks;
@@ -229,15 +332,39 @@ class comm {
   uint64_t m_recv_count = 0;
   uint64_t m_send_count = 0;
 
+  uint64_t m_barrier_epoch = 0;
+
   bool m_in_process_receive_queue = false;
 
+  detail::memory_registry m_memory_sources;
+
   detail::comm_stats             stats;
   const detail::comm_environment config;
   const detail::layout           m_layout;
   detail::comm_router            m_router;
 
-  detail::lambda_map<void (*)(comm *, cereal::YGMInputArchive *), uint16_t>
-      m_lambda_map;
+  using lambda_map_type =
+      detail::lambda_map<void (*)(comm *, cereal::YGMInputArchive *), uint16_t>;
+  lambda_map_type m_lambda_map;
+
+  // Lambda ids reserved to mark messages that follow a routing other than the
+  // configured one. The marker value identifies the routing.
+  static constexpr uint16_t route_marker_base =
+      std::numeric_limits<uint16_t>::max() - lambda_map_type::num_reserved_ids +
+      1;
+
+  // Bytes sent to each destination with routing_type::ADAPTIVE, decayed at
+  // every barrier
+  std::vector<size_t> m_adaptive_dest_bytes;
+  size_t              m_adaptive_total_bytes = 0;
+
+  // Sub-communicator bookkeeping. The root comm owns the MPI transport;
+  // sub-communicators forward all buffering and progress to it.
+  comm                      *m_root        = this;
+  uint32_t                   m_sub_comm_id = 0;
+  std::vector<int>           m_root_ranks;
+  std::map<uint32_t, comm *> m_sub_comms;
+  uint32_t                   m_next_sub_comm_id = 1;
 };
 
 }  // end namespace ygm
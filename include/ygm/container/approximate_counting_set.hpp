@@ -0,0 +1,213 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cereal/archives/json.hpp>
+#include <fstream>
+#include <string>
+#include <ygm/comm.hpp>
+#include <ygm/container/detail/combining_cache.hpp>
+#include <ygm/container/detail/count_min_sketch.hpp>
+#include <ygm/container/detail/hash_partitioner.hpp>
+#include <ygm/container/detail/heavy_hitters.hpp>
+#include <ygm/container/detail/hyperloglog.hpp>
+#include <ygm/container/detail/topk.hpp>
+#include <ygm/detail/ygm_ptr.hpp>
+
+namespace ygm::container {
+
+/**
+ * @brief counting_set keeping a fixed amount of state per rank instead of a
+ * counter per key. Each key's counts go to its owner, as in counting_set,
+ * where they are added to a count-min sketch of width x depth counters, a
+ * Misra-Gries summary of the most frequent keys, and a HyperLogLog sketch of
+ * the distinct keys.
+ *
+ * count() never undercounts, and with probability 1 - e^-depth overcounts by
+ * at most e / width times the number of inserts landing on the key's owner.
+ * size() is an estimate with about 1.6% standard error. topk() ranks the
+ * keys kept by the owners' Misra-Gries summaries, which include every key
+ * holding more than 1 / (candidates + 1) of its owner's inserts, by their
+ * estimated counts. There is no for_all(), since keys are not stored.
+ */
+template <typename Key, typename Partitioner = detail::hash_partitioner<Key>>
+class approximate_counting_set {
+ public:
+  using self_type   = approximate_counting_set<Key, Partitioner>;
+  using mapped_type = size_t;
+  using key_type    = Key;
+  using size_type   = size_t;
+
+  static constexpr size_t  default_width      = size_t(1) << 16;
+  static constexpr size_t  default_depth      = 4;
+  static constexpr size_t  default_candidates = 1024;
+  static constexpr uint8_t distinct_precision = 12;
+
+  Partitioner partitioner;
+
+  approximate_counting_set() = delete;
+
+  approximate_counting_set(ygm::comm   &comm,
+                           const size_t width      = default_width,
+                           const size_t depth      = default_depth,
+                           const size_t candidates = default_candidates)
+      : m_sketch(width, depth),
+        m_candidates(candidates),
+        m_distinct(distinct_precision),
+        m_comm(comm),
+        pthis(this) {
+    pthis.check(m_comm);
+  }
+
+  ~approximate_counting_set() { m_comm.barrier(); }
+
+  void set_routing(const ygm::routing_type route) { m_routing = route; }
+
+  void async_insert(const key_type &key) { cache_insert(key); }
+
+  // Collective estimate of the times key was inserted
+  mapped_type count(const key_type &key) {
+    m_comm.barrier();
+    return m_comm.all_reduce_sum(
+        is_mine(key) ? mapped_type(m_sketch.estimate(key)) : mapped_type(0));
+  }
+
+  // Collective. Exact number of inserts.
+  mapped_type count_all() {
+    m_comm.barrier();
+    return m_comm.all_reduce_sum(mapped_type(m_sketch.total()));
+  }
+
+  // Collective estimate of the number of distinct keys
+  size_type size() {
+    m_comm.barrier();
+    // Owners hold disjoint keys, so their estimates add
+    return m_comm.all_reduce_sum(size_type(m_distinct.estimate() + 0.5));
+  }
+
+  template <typename CompareFunction>
+  std::vector<std::pair<key_type, mapped_type>> topk(size_t          k,
+                                                    CompareFunction cfn) {
+    m_comm.barrier();
+    return detail::distributed_topk<std::pair<key_type, mapped_type>>(
+        m_comm, k, cfn, [this](auto push) {
+          m_candidates.for_all([this, &push](const key_type &key, size_t) {
+            push(std::make_pair(key, mapped_type(m_sketch.estimate(key))));
+          });
+        });
+  }
+
+  void clear() {
+    m_comm.barrier();
+    m_sketch.clear();
+    m_candidates.clear();
+    m_distinct.clear();
+  }
+
+  void serialize(const std::string &fname) {
+    m_comm.barrier();
+    std::string   rank_fname = fname + std::to_string(m_comm.rank());
+    std::ofstream os(rank_fname, std::ios::binary);
+    cereal::JSONOutputArchive oarchive(os);
+    oarchive(m_sketch, m_candidates, m_distinct, m_comm.size());
+  }
+
+  void deserialize(const std::string &fname) {
+    m_comm.barrier();
+
+    std::string   rank_fname = fname + std::to_string(m_comm.rank());
+    std::ifstream is(rank_fname, std::ios::binary);
+
+    cereal::JSONInputArchive iarchive(is);
+    int                      comm_size;
+    iarchive(m_sketch, m_candidates, m_distinct, comm_size);
+
+    if (comm_size != m_comm.size()) {
+      m_comm.cerr0(
+          "Attempting to deserialize approximate_counting_set using "
+          "communicator of different size than serialized with");
+    }
+  }
+
+  int owner(const key_type &key) const {
+    auto [owner, rank] = partitioner(key, m_comm.size(), 1024);
+    return owner;
+  }
+
+  bool is_mine(const key_type &key) const {
+    return owner(key) == m_comm.rank();
+  }
+
+  /**
+   * @brief Hit, miss and flush counts of this rank's insert cache. Each flush
+   * is one message.
+   */
+  detail::combining_cache_stats cache_stats() const {
+    return m_count_cache.stats();
+  }
+
+  // Heap bytes held by this rank's sketches and insert cache
+  size_t local_memory_bytes() const {
+    return m_sketch.memory_bytes() + m_candidates.memory_bytes() +
+           m_distinct.memory_bytes() + m_count_cache.memory_bytes();
+  }
+
+  typename ygm::ygm_ptr<self_type> get_ygm_ptr() const { return pthis; }
+
+  ygm::comm &comm() { return m_comm; }
+
+ private:
+  void cache_insert(const key_type &key) {
+    if (m_cache_empty) {
+      m_cache_empty = false;
+      m_comm.register_pre_barrier_callback(
+          [this]() { this->count_cache_flush_all(); });
+    }
+    m_count_cache.combine(
+        key, 1, std::plus<mapped_type>(),
+        [this](const key_type &key, const mapped_type &count) {
+          count_cache_flush(key, count);
+        });
+  }
+
+  void count_cache_flush(const key_type &key, const mapped_type &count) {
+    auto adder = [](auto pset, const key_type &key, const mapped_type count) {
+      pset->local_add(key, count);
+    };
+    m_comm.async(m_routing, owner(key), adder, pthis, key, count);
+  }
+
+  void count_cache_flush_all() {
+    // Cleared first, so counts cached while flushing register a new callback
+    m_cache_empty = true;
+    m_count_cache.flush_all(
+        [this](const key_type &key, const mapped_type &count) {
+          count_cache_flush(key, count);
+        });
+  }
+
+  void local_add(const key_type &key, const mapped_type count) {
+    const uint64_t hash = detail::sketch_hash(key);
+    m_sketch.add_hash(hash, count);
+    m_distinct.add_hash(hash);
+    m_candidates.insert(key, count);
+  }
+
+  detail::combining_cache<key_type, mapped_type> m_count_cache;
+  bool                                           m_cache_empty = true;
+  detail::count_min_sketch                       m_sketch;
+  detail::heavy_hitters<key_type>                m_candidates;
+  detail::hyperloglog                            m_distinct;
+  ygm::comm                                     &m_comm;
+  typename ygm::ygm_ptr<self_type>               pthis;
+  ygm::routing_type m_routing = ygm::routing_type::DEFAULT;
+
+  ygm::detail::memory_tracker m_memory{
+      m_comm.memory_sources(), "approximate_counting_set",
+      [this]() { return local_memory_bytes(); }};
+};
+
+}  // namespace ygm::container
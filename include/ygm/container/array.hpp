@@ -105,6 +105,12 @@ class array {
 
   ygm::comm& comm();
 
+  // Estimated heap bytes held by this rank's block
+  size_t local_memory_bytes() const;
+
+  // Name this array is reported under by ygm::memory_report()
+  void set_memory_name(const std::string& name);
+
   const mapped_type& default_value() const;
 
   void resize(const size_type size, const mapped_type& fill_value);
@@ -128,6 +134,10 @@ class array {
   std::vector<mapped_type>         m_local_vec;
   ygm::comm&                       m_comm;
   typename ygm::ygm_ptr<self_type> pthis;
+
+  ygm::detail::memory_tracker m_memory{
+      m_comm.memory_sources(), "array",
+      [this]() { return local_memory_bytes(); }};
 };
 
 }  // namespace ygm::container
@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <ygm/collective.hpp>
 #include <ygm/container/container_traits.hpp>
 #include <ygm/random.hpp>
 
@@ -19,8 +20,15 @@ class bag {
   using ygm_container_type = ygm::container::bag_tag;
 
   bag(ygm::comm &comm);
+  bag(ygm::comm &comm, const ygm::routing_type route);
   ~bag();
 
+  /**
+   * @brief Selects the routing used by messages sent from this bag, overriding
+   * YGM_COMM_ROUTING
+   */
+  void set_routing(const ygm::routing_type route) { m_routing = route; }
+
   void async_insert(const value_type &item);
   void async_insert(const value_type &item, int dest);
   void async_insert(const std::vector<value_type> &items, int dest);
@@ -33,7 +41,20 @@ class bag {
   size_type size();
   size_type local_size();
 
-  void rebalance();
+  /**
+   * @brief Moves items so each rank holds a contiguous, evenly sized block of
+   * the global order, matching the partitioning of ygm::container::array
+   *
+   * @param chunk_bytes Packed bytes each rank sends per round of the exchange
+   */
+  void rebalance(size_t chunk_bytes = exchange_default_chunk_bytes);
+
+  /**
+   * @brief Moves every item to the rank partitioner(item) returns, with one
+   * bulk all-to-all exchange instead of a message per item
+   */
+  template <typename Partitioner>
+  void repartition(Partitioner partitioner);
 
   void swap(self_type &s);
 
@@ -50,14 +71,18 @@ class bag {
 
   ygm::comm &comm();
 
+  // Estimated heap bytes held by this rank's items
+  size_t local_memory_bytes() const;
+
+  // Name this bag is reported under by ygm::memory_report()
+  void set_memory_name(const std::string &name);
+
   void                    serialize(const std::string &fname);
   void                    deserialize(const std::string &fname);
   std::vector<value_type> gather_to_vector(int dest);
   std::vector<value_type> gather_to_vector();
 
  private:
-  std::vector<value_type> local_pop(int n);
-
   template <typename Function>
   void local_for_all_pair_types(Function fn);
 
@@ -66,6 +91,11 @@ class bag {
   ygm::comm                       &m_comm;
   std::vector<value_type>          m_local_bag;
   typename ygm::ygm_ptr<self_type> pthis;
+  ygm::routing_type                m_routing = ygm::routing_type::DEFAULT;
+
+  ygm::detail::memory_tracker m_memory{
+      m_comm.memory_sources(), "bag",
+      [this]() { return local_memory_bytes(); }};
 };
 }  // namespace ygm::container
 
@@ -0,0 +1,224 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cereal/archives/json.hpp>
+#include <fstream>
+#include <string>
+#include <ygm/comm.hpp>
+#include <ygm/container/detail/block_bloom_filter.hpp>
+#include <ygm/container/detail/hash_partitioner.hpp>
+#include <ygm/detail/interrupt_mask.hpp>
+#include <ygm/detail/ygm_ptr.hpp>
+#include <ygm/detail/ygm_traits.hpp>
+
+namespace ygm::container {
+
+/**
+ * @brief Distributed Bloom filter: a set that answers membership tests with
+ * no false negatives and a small rate of false positives, at about
+ * bits_per_key bits per key instead of a stored key.
+ *
+ * The bit array is split into one block_bloom_filter per rank, and each key's
+ * bits live on the rank Partitioner assigns it, so inserts are 8-byte
+ * messages carrying the key's hash. For read-only phases, replicate() ORs
+ * the shards into a full copy on every rank, after which local_maybe_contains
+ * answers without messages.
+ */
+template <typename Key, typename Partitioner = detail::hash_partitioner<Key>>
+class bloom_filter {
+ public:
+  using self_type  = bloom_filter<Key, Partitioner>;
+  using ptr_type   = typename ygm::ygm_ptr<self_type>;
+  using key_type   = Key;
+  using size_type  = size_t;
+  using shard_type = detail::block_bloom_filter;
+
+  Partitioner partitioner;
+
+  bloom_filter() = delete;
+
+  /**
+   * @brief Sized for expected_keys keys across all ranks. The false positive
+   * rate is about 1.3% at 10 bits per key and falls roughly tenfold per
+   * further 5 bits.
+   */
+  bloom_filter(ygm::comm   &comm, const size_t expected_keys,
+               const size_t bits_per_key = shard_type::default_bits_per_key)
+      : m_shard((expected_keys + comm.size() - 1) / comm.size(), bits_per_key),
+        m_comm(comm),
+        pthis(this) {
+    pthis.check(m_comm);
+  }
+
+  ~bloom_filter() { m_comm.barrier(); }
+
+  void set_routing(const ygm::routing_type route) { m_routing = route; }
+
+  void async_insert(const key_type &key) {
+    auto inserter = [](auto pfilter, const uint64_t hash) {
+      pfilter->m_shard.insert_hash(hash);
+    };
+    m_comm.async(m_routing, owner(key), inserter, pthis,
+                 shard_type::hash(key));
+  }
+
+  /**
+   * @brief Calls visitor(key, maybe_present, args...), or visitor(pfilter,
+   * key, maybe_present, args...), on the owner of key. maybe_present is false
+   * only if key was never inserted.
+   */
+  template <typename Visitor, typename... VisitorArgs>
+  void async_test_and_execute(const key_type &key, Visitor visitor,
+                              const VisitorArgs &...args) {
+    auto tester = [](auto pfilter, const key_type &key,
+                     const VisitorArgs &...args) {
+      const bool maybe_present =
+          pfilter->m_shard.maybe_contains_hash(shard_type::hash(key));
+      Visitor *vis = nullptr;
+      pfilter->local_visit(key, maybe_present, *vis, args...);
+    };
+    m_comm.async(m_routing, owner(key), tester, pthis, key,
+                 std::forward<const VisitorArgs>(args)...);
+  }
+
+  /**
+   * @brief Inserts key on its owner and, if it was not already present, calls
+   * visitor there as in async_test_and_execute. A false positive skips the
+   * visitor, so this suits work that may be dropped, such as duplicate
+   * suppression.
+   */
+  template <typename Visitor, typename... VisitorArgs>
+  void async_insert_exe_if_missing(const key_type &key, Visitor visitor,
+                                   const VisitorArgs &...args) {
+    auto insert_and_visit = [](auto pfilter, const key_type &key,
+                               const VisitorArgs &...args) {
+      const uint64_t hash = shard_type::hash(key);
+      if (!pfilter->m_shard.maybe_contains_hash(hash)) {
+        pfilter->m_shard.insert_hash(hash);
+        Visitor *vis = nullptr;
+        pfilter->local_visit(key, false, *vis, args...);
+      }
+    };
+    m_comm.async(m_routing, owner(key), insert_and_visit, pthis, key,
+                 std::forward<const VisitorArgs>(args)...);
+  }
+
+  /**
+   * @brief Collective. Copies every rank's shard into one full filter on each
+   * rank with an OR all_reduce, for local tests during read-only phases.
+   * Inserts made afterwards are not seen by the copy until the next call.
+   */
+  void replicate() {
+    m_comm.barrier();
+    const size_t shard_blocks = m_shard.num_blocks();
+    m_replica.resize_blocks(shard_blocks * m_comm.size());
+    m_replica.copy_blocks(m_shard, shard_blocks * m_comm.rank());
+    m_replica.all_reduce_or(m_comm);
+  }
+
+  bool is_replicated() const { return m_replica.num_blocks() > 0; }
+
+  // Frees the copy made by replicate()
+  void drop_replica() { m_replica = shard_type(); }
+
+  // Tests key against the copy made by replicate(), without messages
+  bool local_maybe_contains(const key_type &key) const {
+    ASSERT_RELEASE(is_replicated());
+    const uint64_t hash = shard_type::hash(key);
+    return m_replica.maybe_contains_hash_at(
+        owner(key) * m_shard.num_blocks() + m_shard.block_of(hash), hash);
+  }
+
+  // Collective. Fraction of bits set over all shards.
+  double fill_ratio() {
+    m_comm.barrier();
+    return m_comm.all_reduce_sum(m_shard.fill_ratio()) / m_comm.size();
+  }
+
+  void clear() {
+    m_comm.barrier();
+    m_shard.clear();
+    drop_replica();
+  }
+
+  void serialize(const std::string &fname) {
+    m_comm.barrier();
+    std::string   rank_fname = fname + std::to_string(m_comm.rank());
+    std::ofstream os(rank_fname, std::ios::binary);
+    cereal::JSONOutputArchive oarchive(os);
+    oarchive(m_shard, m_comm.size());
+  }
+
+  void deserialize(const std::string &fname) {
+    m_comm.barrier();
+
+    std::string   rank_fname = fname + std::to_string(m_comm.rank());
+    std::ifstream is(rank_fname, std::ios::binary);
+
+    cereal::JSONInputArchive iarchive(is);
+    int                      comm_size;
+    iarchive(m_shard, comm_size);
+    drop_replica();
+
+    if (comm_size != m_comm.size()) {
+      m_comm.cerr0(
+          "Attempting to deserialize bloom_filter using communicator of "
+          "different size than serialized with");
+    }
+  }
+
+  int owner(const key_type &key) const {
+    auto [owner, rank] = partitioner(key, m_comm.size(), 1024);
+    return owner;
+  }
+
+  bool is_mine(const key_type &key) const {
+    return owner(key) == m_comm.rank();
+  }
+
+  // Heap bytes held by this rank's shard and replica
+  size_t local_memory_bytes() const {
+    return m_shard.memory_bytes() + m_replica.memory_bytes();
+  }
+
+  typename ygm::ygm_ptr<self_type> get_ygm_ptr() const { return pthis; }
+
+  ygm::comm &comm() { return m_comm; }
+
+ private:
+  template <typename Function, typename... VisitorArgs>
+  void local_visit(const key_type &key, const bool maybe_present, Function &fn,
+                   const VisitorArgs &...args) {
+    ygm::detail::interrupt_mask mask(m_comm);
+
+    if constexpr (std::is_invocable<decltype(fn), const key_type &, bool,
+                                    VisitorArgs &...>() ||
+                  std::is_invocable<decltype(fn), ptr_type, const key_type &,
+                                    bool, VisitorArgs &...>()) {
+      ygm::meta::apply_optional(
+          fn, std::make_tuple(pthis),
+          std::forward_as_tuple(key, maybe_present, args...));
+    } else {
+      static_assert(ygm::detail::always_false<>,
+                    "remote bloom_filter lambda signature must be invocable "
+                    "with (const &key_type, bool, ...) or (ptr_type, const "
+                    "&key_type, bool, ...) signatures");
+    }
+  }
+
+  shard_type                       m_shard;
+  shard_type                       m_replica;
+  ygm::comm                       &m_comm;
+  typename ygm::ygm_ptr<self_type> pthis;
+  ygm::routing_type                m_routing = ygm::routing_type::DEFAULT;
+
+  ygm::detail::memory_tracker m_memory{
+      m_comm.memory_sources(), "bloom_filter",
+      [this]() { return local_memory_bytes(); }};
+};
+
+}  // namespace ygm::container
@@ -6,6 +6,7 @@
 #pragma once
 
 #include <ygm/comm.hpp>
+#include <ygm/container/detail/combining_cache.hpp>
 #include <ygm/container/map.hpp>
 #include <ygm/detail/ygm_ptr.hpp>
 #include <ygm/container/container_traits.hpp>
@@ -14,7 +15,7 @@ namespace ygm::container {
 
 template <typename Key, typename Partitioner = detail::hash_partitioner<Key>,
           typename Compare = std::less<Key>,
-          class Alloc      = std::allocator<std::pair<const Key, size_t>>>
+          class Alloc = detail::pool_allocator<std::pair<const Key, size_t>>>
 class counting_set {
  public:
   using self_type           = counting_set<Key, Partitioner, Compare, Alloc>;
@@ -24,10 +25,8 @@ class counting_set {
   using ygm_for_all_types   = std::tuple< Key, size_t >;
   using ygm_container_type  = ygm::container::counting_set_tag;
 
-  const size_type count_cache_size = 1024 * 1024;
-
   counting_set(ygm::comm &comm) : m_map(comm, mapped_type(0)), pthis(this) {
-    m_count_cache.resize(count_cache_size, {key_type(), -1});
+    m_map.set_memory_name("counting_set");
   }
 
   void async_insert(const key_type &key) { cache_insert(key); }
@@ -77,21 +76,39 @@ class counting_set {
     return m_map.all_gather(keys);
   }
 
+  /**
+   * @brief Collective counts of many keys at once: fn(key, count) is called
+   * on this rank for each requested key that was inserted. Cheaper than
+   * count() per key, which costs a barrier and an all_reduce each.
+   */
+  template <typename KeyRange, typename Function>
+  void bulk_lookup(const KeyRange &keys, Function fn) {
+    m_map.bulk_lookup(keys, fn);
+  }
+
   typename ygm::ygm_ptr<self_type> get_ygm_ptr() const { return pthis; }
 
+  /**
+   * @brief Hit, miss and flush counts of this rank's insert cache. Each flush
+   * is one message.
+   */
+  detail::combining_cache_stats cache_stats() const {
+    return m_count_cache.stats();
+  }
+
   void serialize(const std::string &fname) { m_map.serialize(fname); }
   void deserialize(const std::string &fname) { m_map.deserialize(fname); }
 
   ygm::comm &comm() { return m_map.comm(); }
 
+  // Estimated heap bytes held by this rank's counts and insert cache
+  size_t local_memory_bytes() const {
+    return m_map.local_memory_bytes() + m_count_cache.memory_bytes();
+  }
+
  private:
   void cache_erase(const key_type &key) {
-    size_t slot = std::hash<key_type>{}(key) % count_cache_size;
-    if (m_count_cache[slot].second != -1 && m_count_cache[slot].first == key) {
-      // Key was cached, clear cache
-      m_count_cache[slot].second = -1;
-      m_count_cache[slot].first  = key_type();
-    }
+    m_count_cache.erase(key);
     m_map.async_erase(key);
   }
   void cache_insert(const key_type &key) {
@@ -100,55 +117,41 @@ class counting_set {
       m_map.comm().register_pre_barrier_callback(
           [this]() { this->count_cache_flush_all(); });
     }
-    size_t slot = std::hash<key_type>{}(key) % count_cache_size;
-    if (m_count_cache[slot].second == -1) {
-      m_count_cache[slot].first  = key;
-      m_count_cache[slot].second = 1;
-    } else {
-      // flush slot, fill with key
-      ASSERT_DEBUG(m_count_cache[slot].second > 0);
-      if (m_count_cache[slot].first == key) {
-        m_count_cache[slot].second++;
-      } else {
-        count_cache_flush(slot);
-        ASSERT_DEBUG(m_count_cache[slot].second == -1);
-        m_count_cache[slot].first  = key;
-        m_count_cache[slot].second = 1;
-      }
-    }
-    if (m_count_cache[slot].second == std::numeric_limits<int32_t>::max()) {
-      count_cache_flush(slot);
-    }
+    m_count_cache.combine(
+        key, 1, std::plus<mapped_type>(),
+        [this](const key_type &key, const mapped_type &count) {
+          count_cache_flush(key, count);
+        });
   }
 
-  void count_cache_flush(size_t slot) {
-    auto key          = m_count_cache[slot].first;
-    auto cached_count = m_count_cache[slot].second;
-    ASSERT_DEBUG(cached_count > 0);
+  void count_cache_flush(const key_type &key, const mapped_type &count) {
     m_map.async_visit(
         key,
-        [](const key_type &key, size_t &count, int32_t to_add) {
+        [](const key_type &key, size_t &count, const mapped_type &to_add) {
           count += to_add;
         },
-        cached_count);
-    m_count_cache[slot].first  = key_type();
-    m_count_cache[slot].second = -1;
+        count);
   }
 
   void count_cache_flush_all() {
-    for (size_t i = 0; i < m_count_cache.size(); ++i) {
-      if (m_count_cache[i].second > 0) {
-        count_cache_flush(i);
-      }
-    }
+    // Cleared first, so counts cached while flushing register a new callback
     m_cache_empty = true;
+    m_count_cache.flush_all(
+        [this](const key_type &key, const mapped_type &count) {
+          count_cache_flush(key, count);
+        });
   }
   counting_set() = delete;
 
-  std::vector<std::pair<Key, int32_t>>                m_count_cache;
+  detail::combining_cache<Key, mapped_type>           m_count_cache;
   bool                                                m_cache_empty = true;
   map<Key, mapped_type, Partitioner, Compare, Alloc>  m_map;
   typename ygm::ygm_ptr<self_type>                    pthis;
+
+  // The cache is reported with the map, under "counting_set"
+  ygm::detail::memory_tracker m_cache_memory{
+      m_map.comm().memory_sources(), "counting_set",
+      [this]() { return m_count_cache.memory_bytes(); }};
 };
 
 }  // namespace ygm::container
@@ -49,7 +49,7 @@ void array<Value, Index>::resize(const size_type    size,
 
   m_global_size      = size;
   m_small_block_size = size / m_comm.size();
-  m_large_block_size = m_small_block_size + ((size / m_comm.size()) > 0);
+  m_large_block_size = m_small_block_size + ((size % m_comm.size()) > 0);
 
   m_local_vec.resize(
       m_small_block_size + (m_comm.rank() < (size % m_comm.size())),
@@ -185,6 +185,16 @@ ygm::comm &array<Value, Index>::comm() {
   return m_comm;
 }
 
+template <typename Value, typename Index>
+size_t array<Value, Index>::local_memory_bytes() const {
+  return m_local_vec.capacity() * sizeof(mapped_type);
+}
+
+template <typename Value, typename Index>
+void array<Value, Index>::set_memory_name(const std::string &name) {
+  m_memory.rename(name);
+}
+
 template <typename Value, typename Index>
 const typename array<Value, Index>::mapped_type &
 array<Value, Index>::default_value() const {
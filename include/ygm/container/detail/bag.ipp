@@ -16,6 +16,12 @@ bag<Item, Alloc>::bag(ygm::comm &comm) : m_comm(comm), pthis(this) {
   pthis.check(m_comm);
 }
 
+template <typename Item, typename Alloc>
+bag<Item, Alloc>::bag(ygm::comm &comm, const ygm::routing_type route)
+    : m_comm(comm), pthis(this), m_routing(route) {
+  pthis.check(m_comm);
+}
+
 template <typename Item, typename Alloc>
 bag<Item, Alloc>::~bag() {
   m_comm.barrier();
@@ -27,7 +33,7 @@ void bag<Item, Alloc>::async_insert(const value_type &item) {
     map->m_local_bag.push_back(item);
   };
   int dest = (m_round_robin++ + m_comm.rank()) % m_comm.size();
-  m_comm.async(dest, inserter, pthis, item);
+  m_comm.async(m_routing, dest, inserter, pthis, item);
 }
 
 template <typename Item, typename Alloc>
@@ -35,7 +41,7 @@ void bag<Item, Alloc>::async_insert(const value_type &item, int dest) {
   auto inserter = [](auto mailbox, auto map, const value_type &item) {
     map->m_local_bag.push_back(item);
   };
-  m_comm.async(dest, inserter, pthis, item);
+  m_comm.async(m_routing, dest, inserter, pthis, item);
 }
 
 template <typename Item, typename Alloc>
@@ -45,7 +51,7 @@ void bag<Item, Alloc>::async_insert(const std::vector<value_type> &items,
                      const std::vector<value_type> &item) {
     map->m_local_bag.insert(map->m_local_bag.end(), item.begin(), item.end());
   };
-  m_comm.async(dest, inserter, pthis, items);
+  m_comm.async(m_routing, dest, inserter, pthis, items);
 }
 
 template <typename Item, typename Alloc>
@@ -73,47 +79,72 @@ typename bag<Item, Alloc>::size_type bag<Item, Alloc>::local_size() {
 }
 
 template <typename Item, typename Alloc>
-void bag<Item, Alloc>::rebalance() {
+void bag<Item, Alloc>::rebalance(size_t chunk_bytes) {
   m_comm.barrier();
 
   // Find current rank's prefix val and desired target size
   size_t prefix_val  = ygm::prefix_sum(local_size(), m_comm);
-  size_t target_size = std::ceil((size() * 1.0) / m_comm.size());
+  auto   global_size = size();
 
-  // Init to_send array where index is dest and value is the num to send
-  // int to_send[m_comm.size()] = {0};
-  std::unordered_map<size_t, size_t> to_send;
-
-  auto   global_size      = size();
   size_t small_block_size = global_size / m_comm.size();
   size_t large_block_size =
-      global_size / m_comm.size() + ((global_size / m_comm.size()) > 0);
-
-  for (size_t i = 0; i < local_size(); i++) {
-    size_t idx = prefix_val + i;
-    size_t target_rank;
+      global_size / m_comm.size() + ((global_size % m_comm.size()) > 0);
+  size_t large_block_end = (global_size % m_comm.size()) * large_block_size;
 
-    // Determine target rank to match partitioning in ygm::container::array
-    if (idx < (global_size % m_comm.size()) * large_block_size) {
-      target_rank = idx / large_block_size;
-    } else {
-      target_rank = (global_size % m_comm.size()) +
-                    (idx - (global_size % m_comm.size()) * large_block_size) /
-                        small_block_size;
+  // Determine target rank to match partitioning in ygm::container::array
+  auto target_rank = [&](size_t idx) -> int {
+    if (idx < large_block_end) {
+      return idx / large_block_size;
     }
+    return (global_size % m_comm.size()) +
+           (idx - large_block_end) / small_block_size;
+  };
 
-    if (target_rank != m_comm.rank()) {
-      to_send[target_rank]++;
+  // Items that move keep their global order: lower ranks' items land before
+  // the ones kept here, higher ranks' after. Exchange rounds interleave
+  // sources, so incoming items are held per source until all have arrived.
+  std::vector<std::vector<value_type>> to_send(m_comm.size());
+  std::vector<value_type>              kept;
+  for (size_t i = 0; i < m_local_bag.size(); ++i) {
+    int dest = target_rank(prefix_val + i);
+    if (dest == m_comm.rank()) {
+      kept.push_back(std::move(m_local_bag[i]));
+    } else {
+      to_send[dest].push_back(std::move(m_local_bag[i]));
     }
   }
-  m_comm.barrier();
+  m_local_bag.clear();
 
-  // Build and send bag indexes as calculated by to_send
-  for (auto &kv_pair : to_send) {
-    async_insert(local_pop(kv_pair.second), kv_pair.first);
+  std::vector<std::vector<value_type>> received(m_comm.size());
+  ygm::exchange(
+      to_send,
+      [&received](int from, value_type &item) {
+        received[from].push_back(std::move(item));
+      },
+      m_comm, chunk_bytes);
+  received[m_comm.rank()] = std::move(kept);
+  for (auto &items : received) {
+    m_local_bag.insert(m_local_bag.end(),
+                       std::make_move_iterator(items.begin()),
+                       std::make_move_iterator(items.end()));
   }
+}
 
+template <typename Item, typename Alloc>
+template <typename Partitioner>
+void bag<Item, Alloc>::repartition(Partitioner partitioner) {
   m_comm.barrier();
+  std::vector<std::vector<value_type>> to_send(m_comm.size());
+  for (auto &item : m_local_bag) {
+    int dest = partitioner(item);
+    to_send[dest].push_back(std::move(item));
+  }
+  m_local_bag.clear();
+
+  ygm::exchange(
+      to_send,
+      [this](value_type &item) { m_local_bag.push_back(std::move(item)); },
+      m_comm);
 }
 
 template <typename Item, typename Alloc>
@@ -138,18 +169,8 @@ void bag<Item, Alloc>::local_shuffle() {
 template <typename Item, typename Alloc>
 template <typename RandomFunc>
 void bag<Item, Alloc>::global_shuffle(RandomFunc &r) {
-  m_comm.barrier();
-  std::vector<value_type> old_local_bag;
-  std::swap(old_local_bag, m_local_bag);
-
-  auto send_item = [](auto bag, const value_type &item) {
-    bag->m_local_bag.push_back(item);
-  };
-
   std::uniform_int_distribution<> distrib(0, m_comm.size() - 1);
-  for (value_type i : old_local_bag) {
-    m_comm.async(distrib(r), send_item, pthis, i);
-  }
+  repartition([&r, &distrib](const value_type &item) { return distrib(r); });
 }
 
 template <typename Item, typename Alloc>
@@ -163,6 +184,16 @@ ygm::comm &bag<Item, Alloc>::comm() {
   return m_comm;
 }
 
+template <typename Item, typename Alloc>
+size_t bag<Item, Alloc>::local_memory_bytes() const {
+  return m_local_bag.capacity() * sizeof(value_type);
+}
+
+template <typename Item, typename Alloc>
+void bag<Item, Alloc>::set_memory_name(const std::string &name) {
+  m_memory.rename(name);
+}
+
 template <typename Item, typename Alloc>
 void bag<Item, Alloc>::serialize(const std::string &fname) {
   m_comm.barrier();
@@ -237,19 +268,6 @@ bag<Item, Alloc>::gather_to_vector() {
   return result;
 }
 
-template <typename Item, typename Alloc>
-std::vector<typename bag<Item, Alloc>::value_type> bag<Item, Alloc>::local_pop(
-    int n) {
-  ASSERT_RELEASE(n <= local_size());
-
-  size_t                  new_size  = local_size() - n;
-  auto                    pop_start = m_local_bag.begin() + new_size;
-  std::vector<value_type> ret;
-  ret.assign(pop_start, m_local_bag.end());
-  m_local_bag.resize(new_size);
-  return ret;
-}
-
 template <typename Item, typename Alloc>
 template <typename Function>
 void bag<Item, Alloc>::local_for_all_pair_types(Function fn) {
@@ -0,0 +1,62 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <utility>
+#include <vector>
+#include <ygm/collective.hpp>
+#include <ygm/comm.hpp>
+#include <ygm/container/detail/flat_hash_table.hpp>
+
+namespace ygm::container::detail {
+
+/**
+ * @brief Collective lookup of keys in a container exposing owner() and
+ * local_get(). Calls fn(key, value) on the requesting rank for every value
+ * stored under each distinct requested key; absent keys are skipped.
+ *
+ * Requested keys are deduplicated, then each rank sends one batch of keys to
+ * every owner and gets one batch of (key, value) replies back, both through
+ * ygm::exchange. fn may async; its messages are delivered when this returns.
+ */
+template <typename Container, typename KeyRange, typename Function>
+void bulk_lookup(Container &c, const KeyRange &keys, Function fn) {
+  using key_type    = typename Container::key_type;
+  using mapped_type = typename Container::mapped_type;
+  using reply_type  = std::pair<key_type, mapped_type>;
+
+  ygm::comm &comm = c.comm();
+  comm.barrier();
+
+  flat_hash_set<key_type>            unique_keys;
+  std::vector<std::vector<key_type>> requests(comm.size());
+  for (const auto &key : keys) {
+    if (unique_keys.insert(key).second) {
+      requests[c.owner(key)].push_back(key);
+    }
+  }
+  unique_keys = flat_hash_set<key_type>();
+
+  std::vector<std::vector<reply_type>> replies(comm.size());
+  ygm::exchange(
+      requests,
+      [&c, &replies](const int from, const key_type &key) {
+        for (const auto &value : c.local_get(key)) {
+          replies[from].emplace_back(key, value);
+        }
+      },
+      comm);
+  requests = std::vector<std::vector<key_type>>();
+
+  ygm::exchange(
+      replies,
+      [&fn](const reply_type &reply) { fn(reply.first, reply.second); },
+      comm);
+
+  comm.barrier();
+}
+
+}  // namespace ygm::container::detail
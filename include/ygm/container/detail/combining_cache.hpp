@@ -0,0 +1,218 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include <ygm/container/detail/flat_hash_table.hpp>
+
+namespace ygm::container::detail {
+
+struct combining_cache_stats {
+  size_t hits     = 0;  // Values combined into a cached entry
+  size_t misses   = 0;  // Values that started a new entry
+  size_t flushes  = 0;  // Entries handed to the flush function
+  size_t capacity = 0;  // Current number of entries the cache can hold
+};
+
+/**
+ * @brief Set-associative cache that combines values sent to the same key
+ * before they are flushed, used to cut messages for commutative updates.
+ *
+ * Each key maps to one set of `ways` entries kept in LRU order; a miss on a
+ * full set flushes the least recently used entry. The number of sets starts
+ * small and doubles, up to max_sets, whenever more than 1/8 of the updates in
+ * a window evict an entry. flush_all() shrinks the cache again if it was
+ * mostly empty.
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class combining_cache {
+ public:
+  using key_type   = Key;
+  using value_type = Value;
+
+  static constexpr size_t ways             = 4;
+  static constexpr size_t default_min_sets = 1024;
+  static constexpr size_t default_max_sets = 1024 * 1024 / ways;
+
+  combining_cache(const size_t min_sets = default_min_sets,
+                  const size_t max_sets = default_max_sets)
+      : m_min_sets(round_up_pow2(min_sets)),
+        m_max_sets(std::max(m_min_sets, round_up_pow2(max_sets))) {
+    resize(m_min_sets);
+  }
+
+  /**
+   * @brief Combines value into the entry for key with reducer(old, value). If
+   * that evicts another entry, calls flush(evicted_key, evicted_value) last,
+   * so flush may safely re-enter the cache.
+   */
+  template <typename Reducer, typename Flush>
+  void combine(const key_type &key, const value_type &value, Reducer reducer,
+               Flush flush) {
+    ++m_window_ops;
+    entry *set = set_of(key);
+    for (size_t i = 0; i < ways && set[i].occupied; ++i) {
+      if (set[i].key == key) {
+        ++m_stats.hits;
+        set[i].value = reducer(set[i].value, value);
+        std::rotate(set, set + i, set + i + 1);
+        return;
+      }
+    }
+
+    ++m_stats.misses;
+    if (!set[ways - 1].occupied) {
+      size_t i = 0;
+      while (set[i].occupied) {
+        ++i;
+      }
+      set[i] = entry{key, value, true};
+      std::rotate(set, set + i, set + i + 1);
+      note_size(++m_size);
+      return;
+    }
+
+    // Full set: replace the least recently used entry
+    entry victim  = std::move(set[ways - 1]);
+    set[ways - 1] = entry{key, value, true};
+    std::rotate(set, set + ways - 1, set + ways);
+    ++m_stats.flushes;
+    ++m_window_evictions;
+    maybe_grow();
+    flush(victim.key, victim.value);
+  }
+
+  /**
+   * @brief Removes key without flushing it; returns whether it was cached
+   */
+  bool erase(const key_type &key) {
+    entry *set = set_of(key);
+    for (size_t i = 0; i < ways && set[i].occupied; ++i) {
+      if (set[i].key == key) {
+        std::rotate(set + i, set + i + 1, set + ways);
+        set[ways - 1] = entry{};
+        --m_size;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * @brief Calls flush(key, value) for every cached entry and empties the
+   * cache. Entries combined by flush itself stay cached.
+   */
+  template <typename Flush>
+  void flush_all(Flush flush) {
+    std::vector<entry> table;
+    table.swap(m_table);
+    const size_t peak = m_peak_size;
+    size_t       sets = m_num_sets;
+    if (peak * 8 < table.size() && sets > m_min_sets) {
+      sets /= 2;
+    }
+    resize(sets);
+
+    for (auto &e : table) {
+      if (e.occupied) {
+        ++m_stats.flushes;
+        flush(e.key, e.value);
+      }
+    }
+  }
+
+  bool empty() const { return m_size == 0; }
+
+  size_t size() const { return m_size; }
+
+  size_t capacity() const { return m_table.size(); }
+
+  size_t memory_bytes() const { return m_table.capacity() * sizeof(entry); }
+
+  combining_cache_stats stats() const {
+    combining_cache_stats s = m_stats;
+    s.capacity              = capacity();
+    return s;
+  }
+
+ private:
+  struct entry {
+    key_type   key      = key_type();
+    value_type value    = value_type();
+    bool       occupied = false;
+  };
+
+  static size_t round_up_pow2(const size_t n) {
+    size_t p = 1;
+    while (p < n) {
+      p *= 2;
+    }
+    return p;
+  }
+
+  entry *set_of(const key_type &key) {
+    size_t h = flat_hash::mix(Hash{}(key));
+    return m_table.data() + (h & (m_num_sets - 1)) * ways;
+  }
+
+  void note_size(const size_t size) {
+    m_peak_size = std::max(m_peak_size, size);
+  }
+
+  // Doubles the sets when the last window of updates evicted too often. Every
+  // old set splits across two new ones, so no entry is lost.
+  void maybe_grow() {
+    if (m_window_ops < m_table.size()) {
+      return;
+    }
+    const bool thrashing = m_window_evictions * 8 > m_window_ops;
+    m_window_ops         = 0;
+    m_window_evictions   = 0;
+    if (!thrashing || m_num_sets >= m_max_sets) {
+      return;
+    }
+
+    std::vector<entry> old;
+    old.swap(m_table);
+    resize(m_num_sets * 2);
+    for (auto &e : old) {
+      if (e.occupied) {
+        entry *set = set_of(e.key);
+        size_t i   = 0;
+        while (set[i].occupied) {
+          ++i;
+        }
+        set[i] = std::move(e);
+        ++m_size;
+      }
+    }
+    note_size(m_size);
+  }
+
+  void resize(const size_t num_sets) {
+    m_num_sets = num_sets;
+    m_table.assign(num_sets * ways, entry{});
+    m_size             = 0;
+    m_peak_size        = 0;
+    m_window_ops       = 0;
+    m_window_evictions = 0;
+  }
+
+  size_t             m_min_sets;
+  size_t             m_max_sets;
+  size_t             m_num_sets = 0;
+  std::vector<entry> m_table;
+  size_t             m_size             = 0;
+  size_t             m_peak_size        = 0;
+  size_t             m_window_ops       = 0;
+  size_t             m_window_evictions = 0;
+
+  combining_cache_stats m_stats;
+};
+
+}  // namespace ygm::container::detail
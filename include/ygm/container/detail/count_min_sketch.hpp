@@ -0,0 +1,110 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <algorithm>
+#include <cereal/types/vector.hpp>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include <ygm/container/detail/hyperloglog.hpp>
+#include <ygm/detail/assert.hpp>
+
+namespace ygm::container::detail {
+
+/**
+ * @brief Count-min sketch of a stream of weighted hashes: depth rows of width
+ * counters each. estimate() never undercounts, and overcounts by more than
+ * e / width * total() with probability at most e^-depth. Sketches of equal
+ * shape merge by adding their counters.
+ */
+class count_min_sketch {
+ public:
+  static constexpr size_t default_width = size_t(1) << 16;
+  static constexpr size_t default_depth = 4;
+
+  explicit count_min_sketch(const size_t width = default_width,
+                            const size_t depth = default_depth)
+      : m_width(std::max<size_t>(width, 1)),
+        m_depth(std::max<size_t>(depth, 1)),
+        m_counters(m_width * m_depth, 0) {}
+
+  // Adds count to a well-mixed 64-bit hash, e.g. from sketch_hash()
+  void add_hash(const uint64_t hash, const uint64_t count = 1) {
+    m_total += count;
+    const uint64_t step = row_step(hash);
+    for (size_t row = 0; row < m_depth; ++row) {
+      m_counters[cell(hash, step, row)] += count;
+    }
+  }
+
+  uint64_t estimate_hash(const uint64_t hash) const {
+    uint64_t       to_return = std::numeric_limits<uint64_t>::max();
+    const uint64_t step      = row_step(hash);
+    for (size_t row = 0; row < m_depth; ++row) {
+      to_return = std::min(to_return, m_counters[cell(hash, step, row)]);
+    }
+    return to_return;
+  }
+
+  template <typename T>
+  void add(const T &item, const uint64_t count = 1) {
+    add_hash(sketch_hash(item), count);
+  }
+
+  template <typename T>
+  uint64_t estimate(const T &item) const {
+    return estimate_hash(sketch_hash(item));
+  }
+
+  void merge(const count_min_sketch &other) {
+    ASSERT_RELEASE(other.m_width == m_width && other.m_depth == m_depth);
+    for (size_t i = 0; i < m_counters.size(); ++i) {
+      m_counters[i] += other.m_counters[i];
+    }
+    m_total += other.m_total;
+  }
+
+  // Sum of all counts added
+  uint64_t total() const { return m_total; }
+
+  size_t width() const { return m_width; }
+
+  size_t depth() const { return m_depth; }
+
+  void clear() {
+    std::fill(m_counters.begin(), m_counters.end(), 0);
+    m_total = 0;
+  }
+
+  size_t memory_bytes() const {
+    return m_counters.capacity() * sizeof(uint64_t);
+  }
+
+  template <class Archive>
+  void serialize(Archive &ar) {
+    ar(m_width, m_depth, m_total, m_counters);
+  }
+
+ private:
+  // Row i reads column hash + i * step, so one hash yields depth pairwise
+  // independent columns
+  static uint64_t row_step(const uint64_t hash) {
+    return flat_hash::mix(hash ^ 0x9e3779b97f4a7c15ULL) | 1;
+  }
+
+  size_t cell(const uint64_t hash, const uint64_t step,
+              const size_t row) const {
+    return row * m_width + (hash + row * step) % m_width;
+  }
+
+  size_t                m_width;
+  size_t                m_depth;
+  uint64_t              m_total = 0;
+  std::vector<uint64_t> m_counters;
+};
+
+}  // namespace ygm::container::detail
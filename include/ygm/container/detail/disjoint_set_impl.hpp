@@ -9,6 +9,8 @@
 #include <ygm/comm.hpp>
 #include <ygm/container/container_traits.hpp>
 #include <ygm/container/detail/hash_partitioner.hpp>
+#include <ygm/container/detail/memory_usage.hpp>
+#include <ygm/container/detail/pool_allocator.hpp>
 #include <ygm/detail/ygm_ptr.hpp>
 #include <ygm/detail/ygm_traits.hpp>
 
@@ -24,7 +26,9 @@ class disjoint_set_impl {
   using ygm_for_all_types  = std::tuple<Item, Item>;
   using ygm_container_type = ygm::container::disjoint_set_tag;
   using rank_type          = int16_t;
-  using parent_map_type    = std::map<value_type, rank_parent_t>;
+  using parent_map_type =
+      std::map<value_type, rank_parent_t, std::less<value_type>,
+               pool_allocator<std::pair<const value_type, rank_parent_t>>>;
 
   Partitioner partitioner;
 
@@ -572,11 +576,22 @@ class disjoint_set_impl {
 
   ygm::comm &comm() { return m_comm; }
 
+  // Estimated heap bytes held by this rank's items
+  size_t local_memory_bytes() const {
+    return local_container_bytes(m_local_item_parent_map);
+  }
+
+  void set_memory_name(const std::string &name) { m_memory.rename(name); }
+
  protected:
   disjoint_set_impl() = delete;
 
   ygm::comm        &m_comm;
   self_ygm_ptr_type pthis;
   parent_map_type   m_local_item_parent_map;
+
+  ygm::detail::memory_tracker m_memory{
+      m_comm.memory_sources(), "disjoint_set",
+      [this]() { return local_memory_bytes(); }};
 };
 }  // namespace ygm::container::detail
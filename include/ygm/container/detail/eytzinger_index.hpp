@@ -0,0 +1,108 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <limits>
+#include <vector>
+
+namespace ygm::container::detail {
+
+/**
+ * @brief Immutable set of distinct keys stored in Eytzinger (BFS) order of an
+ * implicit binary search tree. A search walks one cache-friendly path from
+ * the front of the array instead of jumping across a sorted array or chasing
+ * tree nodes, and there is no per-key overhead.
+ *
+ * Slots are 0-based positions in the array; parallel arrays indexed by slot
+ * can hold per-key data.
+ */
+template <typename Key, typename Compare = std::less<Key>>
+class eytzinger_index {
+ public:
+  using key_type = Key;
+
+  static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+  eytzinger_index() = default;
+
+  /**
+   * @brief Builds from strictly increasing keys. Returns, for each slot, the
+   * position in sorted its key came from.
+   */
+  std::vector<size_t> build(std::vector<key_type> &&sorted) {
+    const size_t        n = sorted.size();
+    std::vector<size_t> order(n);
+    m_keys.resize(n);
+    size_t i = 0;
+    for_each_slot_in_order(n, [&](const size_t slot) {
+      m_keys[slot] = std::move(sorted[i]);
+      order[slot]  = i++;
+    });
+    return order;
+  }
+
+  // Slot holding key, or npos
+  size_t find(const key_type &key) const {
+    const size_t n = m_keys.size();
+    size_t       k = 1;
+    while (k <= n) {
+      k = 2 * k + Compare{}(m_keys[k - 1], key);
+    }
+    // Undo the right turns taken after the last left turn
+    k >>= __builtin_ffsll(~k);
+    if (k == 0 || Compare{}(key, m_keys[k - 1])) {
+      return npos;
+    }
+    return k - 1;
+  }
+
+  const key_type &key(const size_t slot) const { return m_keys[slot]; }
+
+  size_t size() const { return m_keys.size(); }
+
+  bool empty() const { return m_keys.empty(); }
+
+  size_t memory_bytes() const { return m_keys.capacity() * sizeof(key_type); }
+
+  // Calls fn(slot) for every slot in key order
+  template <typename Function>
+  void for_each_in_order(Function fn) const {
+    for_each_slot_in_order(m_keys.size(), fn);
+  }
+
+ private:
+  // In-order walk of the implicit tree with 1-based node k and children 2k
+  // and 2k + 1
+  template <typename Function>
+  static void for_each_slot_in_order(const size_t n, Function fn) {
+    if (n == 0) {
+      return;
+    }
+    size_t k = 1;
+    while (2 * k <= n) {
+      k *= 2;
+    }
+    while (k != 0) {
+      fn(k - 1);
+      if (2 * k + 1 <= n) {
+        k = 2 * k + 1;
+        while (2 * k <= n) {
+          k *= 2;
+        }
+      } else {
+        // Climb while we are a right child, then once more
+        while (k & 1) {
+          k >>= 1;
+        }
+        k >>= 1;
+      }
+    }
+  }
+
+  std::vector<key_type> m_keys;
+};
+
+}  // namespace ygm::container::detail
@@ -0,0 +1,536 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <cereal/cereal.hpp>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace ygm::container::detail {
+
+namespace flat_hash {
+
+// Control byte of each slot: empty, deleted, or the low 7 bits of the hash of
+// a full slot
+using ctrl_t = int8_t;
+
+constexpr ctrl_t ctrl_empty   = -128;  // 0b10000000
+constexpr ctrl_t ctrl_deleted = -2;    // 0b11111110
+
+constexpr size_t group_width = 16;
+
+/**
+ * @brief Bitmask of slots within a group of control bytes
+ */
+class bitmask {
+ public:
+  explicit bitmask(uint32_t mask) : m_mask(mask) {}
+
+  explicit operator bool() const { return m_mask != 0; }
+
+  size_t lowest() const { return __builtin_ctz(m_mask); }
+
+  void clear_lowest() { m_mask &= m_mask - 1; }
+
+ private:
+  uint32_t m_mask;
+};
+
+/**
+ * @brief 16 control bytes compared at once, with SSE2 when available
+ */
+class group {
+ public:
+  explicit group(const ctrl_t *ctrl) {
+#if defined(__SSE2__)
+    m_ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ctrl));
+#else
+    std::memcpy(m_ctrl, ctrl, group_width);
+#endif
+  }
+
+  bitmask match(ctrl_t h2) const {
+#if defined(__SSE2__)
+    return bitmask(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), m_ctrl)));
+#else
+    uint32_t mask = 0;
+    for (size_t i = 0; i < group_width; ++i) {
+      mask |= uint32_t(m_ctrl[i] == h2) << i;
+    }
+    return bitmask(mask);
+#endif
+  }
+
+  bitmask match_empty() const { return match(ctrl_empty); }
+
+  bitmask match_empty_or_deleted() const {
+#if defined(__SSE2__)
+    // Empty and deleted are the only negative control bytes below -1
+    return bitmask(_mm_movemask_epi8(
+        _mm_cmpgt_epi8(_mm_set1_epi8(ctrl_deleted + 1), m_ctrl)));
+#else
+    uint32_t mask = 0;
+    for (size_t i = 0; i < group_width; ++i) {
+      mask |= uint32_t(m_ctrl[i] < ctrl_deleted + 1) << i;
+    }
+    return bitmask(mask);
+#endif
+  }
+
+ private:
+#if defined(__SSE2__)
+  __m128i m_ctrl;
+#else
+  ctrl_t m_ctrl[group_width];
+#endif
+};
+
+/**
+ * @brief Spreads the bits of std::hash, which is the identity for integers
+ * and would otherwise leave keys sharing an owner rank in the same groups
+ */
+inline size_t mix(size_t h) {
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return h;
+}
+
+struct key_of_pair {
+  template <typename Pair>
+  const auto &operator()(const Pair &p) const {
+    return p.first;
+  }
+};
+
+struct key_of_key {
+  template <typename Key>
+  const Key &operator()(const Key &k) const {
+    return k;
+  }
+};
+
+}  // namespace flat_hash
+
+/**
+ * @brief Open-addressing hash table with unique keys, storing values in a flat
+ * slot array next to one control byte per slot.
+ *
+ * Slots are probed a group of 16 control bytes at a time, comparing 7 bits of
+ * the hash of every slot in the group at once, so most lookups touch a single
+ * cache line of control bytes and compare at most one key. Provides the
+ * subset of the std::map and std::set interfaces used by map_impl and
+ * set_impl. Iteration order is unspecified, and inserting may invalidate
+ * iterators.
+ *
+ * @tparam Value Slot type, either std::pair<const Key, Mapped> or Key
+ * @tparam KeyOf Extracts the key of a slot
+ */
+template <typename Key, typename Value, typename KeyOf,
+          typename Hash     = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>>
+class flat_hash_table {
+  static constexpr bool is_set = std::is_same_v<Key, Value>;
+
+ public:
+  using key_type   = Key;
+  using value_type = Value;
+  using size_type  = size_t;
+
+  template <bool Const>
+  class iterator_base {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = Value;
+    using difference_type   = std::ptrdiff_t;
+    using reference =
+        std::conditional_t<Const || is_set, const Value &, Value &>;
+    using pointer =
+        std::conditional_t<Const || is_set, const Value *, Value *>;
+
+    iterator_base() = default;
+
+    iterator_base(const flat_hash_table *table, size_t index)
+        : m_table(table), m_index(index) {
+      skip_empty();
+    }
+
+    // Allows iterator to const_iterator conversion
+    template <bool C = Const, typename = std::enable_if_t<C>>
+    iterator_base(const iterator_base<false> &rhs)
+        : m_table(rhs.m_table), m_index(rhs.m_index) {}
+
+    reference operator*() const {
+      return const_cast<reference>(m_table->slot(m_index));
+    }
+
+    pointer operator->() const { return &(**this); }
+
+    iterator_base &operator++() {
+      ++m_index;
+      skip_empty();
+      return *this;
+    }
+
+    iterator_base operator++(int) {
+      iterator_base to_return = *this;
+      ++(*this);
+      return to_return;
+    }
+
+    bool operator==(const iterator_base &rhs) const {
+      return m_index == rhs.m_index;
+    }
+
+    bool operator!=(const iterator_base &rhs) const { return !(*this == rhs); }
+
+   private:
+    friend class flat_hash_table;
+    friend class iterator_base<true>;
+
+    void skip_empty() {
+      while (m_index < m_table->m_capacity && m_table->m_ctrl[m_index] < 0) {
+        ++m_index;
+      }
+    }
+
+    const flat_hash_table *m_table = nullptr;
+    size_t                 m_index = 0;
+  };
+
+  using iterator       = iterator_base<false>;
+  using const_iterator = iterator_base<true>;
+
+  flat_hash_table() = default;
+
+  flat_hash_table(const flat_hash_table &rhs) {
+    insert(rhs.begin(), rhs.end());
+  }
+
+  flat_hash_table(flat_hash_table &&rhs) noexcept { swap(rhs); }
+
+  flat_hash_table &operator=(flat_hash_table rhs) {
+    swap(rhs);
+    return *this;
+  }
+
+  ~flat_hash_table() { destroy_all(); }
+
+  iterator       begin() { return iterator(this, 0); }
+  iterator       end() { return iterator(this, m_capacity); }
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(this, m_capacity); }
+
+  size_type size() const { return m_size; }
+  bool      empty() const { return m_size == 0; }
+
+  iterator find(const key_type &key) {
+    return iterator(this, find_index(key));
+  }
+
+  const_iterator find(const key_type &key) const {
+    return const_iterator(this, find_index(key));
+  }
+
+  size_type count(const key_type &key) const {
+    return find_index(key) != m_capacity;
+  }
+
+  std::pair<iterator, iterator> equal_range(const key_type &key) {
+    iterator first = find(key);
+    if (first == end()) {
+      return {first, first};
+    }
+    iterator last = first;
+    return {first, ++last};
+  }
+
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return emplace(value);
+  }
+
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return emplace(std::move(value));
+  }
+
+  template <typename P,
+            typename = std::enable_if_t<std::is_constructible_v<Value, P &&>>>
+  std::pair<iterator, bool> insert(P &&value) {
+    return emplace(std::forward<P>(value));
+  }
+
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last) {
+    for (; first != last; ++first) {
+      emplace(*first);
+    }
+  }
+
+  /**
+   * @brief Constructs a value in place unless its key is already present
+   */
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    // Built first to get at the key; moved into its slot when new
+    Value      value(std::forward<Args>(args)...);
+    const auto hash  = flat_hash::mix(Hash{}(KeyOf{}(value)));
+    size_t     index = find_index(KeyOf{}(value), hash);
+    if (index != m_capacity) {
+      return {iterator(this, index), false};
+    }
+    if (m_size + m_deleted + 1 > max_load()) {
+      rehash(m_size + 1 > max_load() ? m_capacity * 2 : m_capacity);
+    }
+    index = find_insert_index(hash);
+    if (m_ctrl[index] == flat_hash::ctrl_deleted) {
+      --m_deleted;
+    }
+    set_ctrl(index, h2(hash));
+    new (slot_ptr(index)) Value(std::move(value));
+    ++m_size;
+    return {iterator(this, index), true};
+  }
+
+  /**
+   * @brief Mapped value of key, default constructed first if key is missing
+   */
+  template <bool S = is_set, typename = std::enable_if_t<!S>>
+  auto &operator[](const key_type &key) {
+    auto itr = find(key);
+    if (itr == end()) {
+      itr = emplace(std::piecewise_construct, std::forward_as_tuple(key),
+                    std::forward_as_tuple())
+                .first;
+    }
+    return itr->second;
+  }
+
+  size_type erase(const key_type &key) {
+    size_t index = find_index(key);
+    if (index == m_capacity) {
+      return 0;
+    }
+    erase_index(index);
+    return 1;
+  }
+
+  iterator erase(const_iterator pos) {
+    erase_index(pos.m_index);
+    return iterator(this, pos.m_index + 1);
+  }
+
+  void clear() {
+    destroy_all();
+    m_ctrl.clear();
+    m_slots.reset();
+    m_capacity = 0;
+    m_size     = 0;
+    m_deleted  = 0;
+  }
+
+  // Heap bytes held by slots and control bytes
+  size_t memory_bytes() const {
+    return m_capacity * (sizeof(storage_t) + sizeof(flat_hash::ctrl_t));
+  }
+
+  /**
+   * @brief Grows the table to hold at least n values without rehashing
+   */
+  void reserve(size_type n) {
+    size_t capacity = std::max(m_capacity, flat_hash::group_width);
+    while (capacity * 7 / 8 < n) {
+      capacity *= 2;
+    }
+    if (capacity != m_capacity) {
+      rehash(capacity);
+    }
+  }
+
+  void swap(flat_hash_table &rhs) noexcept {
+    std::swap(m_ctrl, rhs.m_ctrl);
+    std::swap(m_slots, rhs.m_slots);
+    std::swap(m_capacity, rhs.m_capacity);
+    std::swap(m_size, rhs.m_size);
+    std::swap(m_deleted, rhs.m_deleted);
+  }
+
+  template <class Archive>
+  void save(Archive &ar) const {
+    ar(cereal::make_size_tag(static_cast<cereal::size_type>(m_size)));
+    for (const auto &value : *this) {
+      if constexpr (is_set) {
+        ar(value);
+      } else {
+        ar(value.first, value.second);
+      }
+    }
+  }
+
+  template <class Archive>
+  void load(Archive &ar) {
+    cereal::size_type size;
+    ar(cereal::make_size_tag(size));
+    clear();
+    reserve(size);
+    for (cereal::size_type i = 0; i < size; ++i) {
+      if constexpr (is_set) {
+        Key key;
+        ar(key);
+        emplace(std::move(key));
+      } else {
+        Key                                    key;
+        typename Value::second_type            mapped;
+        ar(key, mapped);
+        emplace(std::move(key), std::move(mapped));
+      }
+    }
+  }
+
+ private:
+  static flat_hash::ctrl_t h2(size_t hash) { return hash & 0x7F; }
+
+  size_t num_groups() const { return m_capacity / flat_hash::group_width; }
+
+  size_t max_load() const { return m_capacity * 7 / 8; }
+
+  Value *slot_ptr(size_t index) const {
+    return reinterpret_cast<Value *>(m_slots.get()) + index;
+  }
+
+  const Value &slot(size_t index) const { return *slot_ptr(index); }
+
+  void set_ctrl(size_t index, flat_hash::ctrl_t c) { m_ctrl[index] = c; }
+
+  size_t find_index(const key_type &key) const {
+    return find_index(key, flat_hash::mix(Hash{}(key)));
+  }
+
+  /**
+   * @brief Index of the slot holding key, or m_capacity when absent. Probes
+   * groups in triangular order until a group with an empty slot.
+   */
+  size_t find_index(const key_type &key, size_t hash) const {
+    if (m_capacity == 0) {
+      return m_capacity;
+    }
+    const size_t mask = num_groups() - 1;
+    size_t       g    = (hash >> 7) & mask;
+    for (size_t step = 1;; ++step) {
+      const size_t     base = g * flat_hash::group_width;
+      flat_hash::group grp(&m_ctrl[base]);
+      for (auto match = grp.match(h2(hash)); match; match.clear_lowest()) {
+        size_t index = base + match.lowest();
+        if (KeyEqual{}(KeyOf{}(slot(index)), key)) {
+          return index;
+        }
+      }
+      if (grp.match_empty() || step > num_groups()) {
+        return m_capacity;
+      }
+      g = (g + step) & mask;
+    }
+  }
+
+  size_t find_insert_index(size_t hash) const {
+    const size_t mask = num_groups() - 1;
+    size_t       g    = (hash >> 7) & mask;
+    for (size_t step = 1;; ++step) {
+      const size_t     base = g * flat_hash::group_width;
+      flat_hash::group grp(&m_ctrl[base]);
+      if (auto match = grp.match_empty_or_deleted()) {
+        return base + match.lowest();
+      }
+      g = (g + step) & mask;
+    }
+  }
+
+  void erase_index(size_t index) {
+    slot_ptr(index)->~Value();
+    --m_size;
+    // A group that already has an empty slot ends every probe through it, so
+    // the erased slot can become empty rather than a tombstone
+    const size_t base = index - index % flat_hash::group_width;
+    if (flat_hash::group(&m_ctrl[base]).match_empty()) {
+      set_ctrl(index, flat_hash::ctrl_empty);
+    } else {
+      set_ctrl(index, flat_hash::ctrl_deleted);
+      ++m_deleted;
+    }
+  }
+
+  void rehash(size_t new_capacity) {
+    new_capacity = std::max(new_capacity, flat_hash::group_width);
+
+    std::vector<flat_hash::ctrl_t> old_ctrl = std::move(m_ctrl);
+    std::unique_ptr<storage_t[]>   old_slots = std::move(m_slots);
+    const size_t                   old_capacity = m_capacity;
+
+    m_ctrl.assign(new_capacity, flat_hash::ctrl_empty);
+    m_slots.reset(new storage_t[new_capacity]);
+    m_capacity = new_capacity;
+    m_deleted  = 0;
+
+    Value *old_values = reinterpret_cast<Value *>(old_slots.get());
+    for (size_t i = 0; i < old_capacity; ++i) {
+      if (old_ctrl[i] >= 0) {
+        const auto hash  = flat_hash::mix(Hash{}(KeyOf{}(old_values[i])));
+        size_t     index = find_insert_index(hash);
+        set_ctrl(index, h2(hash));
+        new (slot_ptr(index)) Value(std::move(old_values[i]));
+        old_values[i].~Value();
+      }
+    }
+  }
+
+  void destroy_all() {
+    if constexpr (!std::is_trivially_destructible_v<Value>) {
+      for (size_t i = 0; i < m_capacity; ++i) {
+        if (m_ctrl[i] >= 0) {
+          slot_ptr(i)->~Value();
+        }
+      }
+    }
+  }
+
+  using storage_t =
+      typename std::aligned_storage<sizeof(Value), alignof(Value)>::type;
+
+  std::vector<flat_hash::ctrl_t> m_ctrl;
+  std::unique_ptr<storage_t[]>   m_slots;
+  size_t                         m_capacity = 0;
+  size_t                         m_size     = 0;
+  size_t                         m_deleted  = 0;
+};
+
+template <typename Key, typename Mapped, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>>
+using flat_hash_map =
+    flat_hash_table<Key, std::pair<const Key, Mapped>, flat_hash::key_of_pair,
+                    Hash, KeyEqual>;
+
+template <typename Key, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>>
+using flat_hash_set =
+    flat_hash_table<Key, Key, flat_hash::key_of_key, Hash, KeyEqual>;
+
+}  // namespace ygm::container::detail
@@ -0,0 +1,362 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#include <cereal/archives/json.hpp>
+#include <cereal/types/utility.hpp>
+#include <cereal/types/vector.hpp>
+#include <fstream>
+#include <vector>
+#include <ygm/comm.hpp>
+#include <ygm/container/detail/bulk_lookup.hpp>
+#include <ygm/container/detail/flat_hash_table.hpp>
+#include <ygm/container/detail/hash_partitioner.hpp>
+#include <ygm/container/detail/memory_usage.hpp>
+#include <ygm/detail/interrupt_mask.hpp>
+#include <ygm/detail/ygm_ptr.hpp>
+#include <ygm/detail/ygm_traits.hpp>
+
+namespace ygm::container::detail {
+
+/**
+ * @brief Non-owning view of a contiguous run of values. Invalidated by any
+ * later insert to, or erase of, the key it was taken from.
+ */
+template <typename T>
+class value_span {
+ public:
+  using value_type     = std::remove_cv_t<T>;
+  using iterator       = T *;
+  using const_iterator = const T *;
+  using size_type      = size_t;
+
+  value_span() = default;
+  value_span(T *data, size_t size) : m_data(data), m_size(size) {}
+
+  iterator begin() const { return m_data; }
+  iterator end() const { return m_data + m_size; }
+
+  T *data() const { return m_data; }
+
+  size_type size() const { return m_size; }
+  bool      empty() const { return m_size == 0; }
+
+  T &operator[](size_t i) const { return m_data[i]; }
+  T &front() const { return m_data[0]; }
+  T &back() const { return m_data[m_size - 1]; }
+
+ private:
+  T     *m_data = nullptr;
+  size_t m_size = 0;
+};
+
+template <typename Key, typename Value,
+          typename Partitioner = detail::hash_partitioner<Key>,
+          typename Hash        = std::hash<Key>,
+          class LocalMap = flat_hash_map<Key, std::vector<Value>, Hash>>
+class grouped_multimap_impl {
+ public:
+  using self_type =
+      grouped_multimap_impl<Key, Value, Partitioner, Hash, LocalMap>;
+  using ptr_type          = typename ygm::ygm_ptr<self_type>;
+  using mapped_type       = Value;
+  using key_type          = Key;
+  using size_type         = size_t;
+  using group_type        = value_span<mapped_type>;
+  using const_group_type  = value_span<const mapped_type>;
+  using ygm_for_all_types = std::tuple<Key, Value>;
+
+  Partitioner partitioner;
+
+  grouped_multimap_impl(ygm::comm &comm) : m_comm(comm), pthis(this) {
+    pthis.check(m_comm);
+  }
+
+  grouped_multimap_impl(const self_type &rhs)
+      : m_local_map(rhs.m_local_map),
+        m_local_values(rhs.m_local_values),
+        m_comm(rhs.m_comm),
+        pthis(this) {
+    m_routing = rhs.m_routing;
+    pthis.check(m_comm);
+  }
+
+  ~grouped_multimap_impl() { m_comm.barrier(); }
+
+  void set_routing(const ygm::routing_type route) { m_routing = route; }
+
+  void async_insert(const key_type &key, const mapped_type &value) {
+    auto inserter = [](auto pmap, const key_type &key,
+                       const mapped_type &value) {
+      pmap->local_insert(key, value);
+    };
+    m_comm.async(m_routing, owner(key), inserter, pthis, key, value);
+  }
+
+  template <typename Visitor, typename... VisitorArgs>
+  void async_visit(const key_type &key, Visitor visitor,
+                   const VisitorArgs &...args) {
+    auto visit_wrapper = [](auto pmap, const key_type &key,
+                            const VisitorArgs &...args) {
+      Visitor *vis = nullptr;
+      pmap->local_visit(key, *vis, args...);
+    };
+
+    m_comm.async(m_routing, owner(key), visit_wrapper, pthis, key,
+                 std::forward<const VisitorArgs>(args)...);
+  }
+
+  template <typename Visitor, typename... VisitorArgs>
+  void async_visit_group(const key_type &key, Visitor visitor,
+                         const VisitorArgs &...args) {
+    auto visit_wrapper = [](auto pmap, const key_type &key,
+                            const VisitorArgs &...args) {
+      Visitor *vis = nullptr;
+      pmap->local_visit_group(key, *vis, args...);
+    };
+
+    m_comm.async(m_routing, owner(key), visit_wrapper, pthis, key,
+                 std::forward<const VisitorArgs>(args)...);
+  }
+
+  void async_erase(const key_type &key) {
+    auto erase_wrapper = [](auto pmap, const key_type &key) {
+      pmap->local_erase(key);
+    };
+
+    m_comm.async(m_routing, owner(key), erase_wrapper, pthis, key);
+  }
+
+  size_t local_count(const key_type &key) const {
+    auto itr = m_local_map.find(key);
+    return itr == m_local_map.end() ? 0 : itr->second.size();
+  }
+
+  template <typename Function>
+  void for_all(Function fn) {
+    m_comm.barrier();
+    local_for_all(fn);
+  }
+
+  template <typename Function>
+  void for_all_groups(Function fn) {
+    m_comm.barrier();
+    local_for_all_groups(fn);
+  }
+
+  void clear() {
+    m_comm.barrier();
+    local_clear();
+  }
+
+  size_type size() {
+    m_comm.barrier();
+    return m_comm.all_reduce_sum(m_local_values);
+  }
+
+  size_type num_keys() {
+    m_comm.barrier();
+    return m_comm.all_reduce_sum(m_local_map.size());
+  }
+
+  size_t count(const key_type &key) {
+    m_comm.barrier();
+    return m_comm.all_reduce_sum(local_count(key));
+  }
+
+  void swap(self_type &s) {
+    m_comm.barrier();
+    m_local_map.swap(s.m_local_map);
+    std::swap(m_local_values, s.m_local_values);
+  }
+
+  template <typename STLKeyContainer, typename MapKeyValue>
+  void all_gather(const STLKeyContainer &keys, MapKeyValue &output) {
+    bulk_lookup(*this, keys,
+                [&output](const key_type &key, const mapped_type &value) {
+                  output.insert(std::make_pair(key, value));
+                });
+  }
+
+  typename ygm::ygm_ptr<self_type> get_ygm_ptr() const { return pthis; }
+
+  void serialize(const std::string &fname) {
+    m_comm.barrier();
+    std::string   rank_fname = fname + std::to_string(m_comm.rank());
+    std::ofstream os(rank_fname, std::ios::binary);
+    cereal::JSONOutputArchive oarchive(os);
+    oarchive(m_local_map, m_comm.size());
+  }
+
+  void deserialize(const std::string &fname) {
+    m_comm.barrier();
+
+    std::string   rank_fname = fname + std::to_string(m_comm.rank());
+    std::ifstream is(rank_fname, std::ios::binary);
+
+    cereal::JSONInputArchive iarchive(is);
+    int                      comm_size;
+    iarchive(m_local_map, comm_size);
+
+    m_local_values = 0;
+    for (const auto &kv : m_local_map) {
+      m_local_values += kv.second.size();
+    }
+
+    if (comm_size != m_comm.size()) {
+      m_comm.cerr0(
+          "Attempting to deserialize grouped_multimap_impl using communicator "
+          "of different size than serialized with");
+    }
+  }
+
+  int owner(const key_type &key) const {
+    auto [owner, rank] = partitioner(key, m_comm.size(), 1024);
+    return owner;
+  }
+
+  bool is_mine(const key_type &key) const {
+    return owner(key) == m_comm.rank();
+  }
+
+  /**
+   * @brief View of the values stored locally for key, without copying. Empty
+   * if key is not stored on this rank.
+   */
+  const_group_type local_get(const key_type &key) const {
+    auto itr = m_local_map.find(key);
+    if (itr == m_local_map.end()) {
+      return const_group_type();
+    }
+    return const_group_type(itr->second.data(), itr->second.size());
+  }
+
+  void local_insert(const key_type &key, const mapped_type &value) {
+    m_local_map[key].push_back(value);
+    ++m_local_values;
+  }
+
+  template <typename Function, typename... VisitorArgs>
+  void local_visit(const key_type &key, Function &fn,
+                   const VisitorArgs &...args) {
+    ygm::detail::interrupt_mask mask(m_comm);
+
+    if constexpr (std::is_invocable<decltype(fn), const key_type &,
+                                    mapped_type &, VisitorArgs &...>() ||
+                  std::is_invocable<decltype(fn), ptr_type, const key_type &,
+                                    mapped_type &, VisitorArgs &...>()) {
+      auto itr = m_local_map.find(key);
+      if (itr == m_local_map.end()) {
+        return;
+      }
+      for (auto &value : itr->second) {
+        ygm::meta::apply_optional(fn, std::make_tuple(pthis),
+                                  std::forward_as_tuple(key, value, args...));
+      }
+    } else {
+      static_assert(ygm::detail::always_false<>,
+                    "remote grouped_multimap lambda signature must be "
+                    "invocable with (const &key_type, mapped_type&, ...) or "
+                    "(ptr_type, const &key_type, mapped_type&, ...) "
+                    "signatures");
+    }
+  }
+
+  template <typename Function, typename... VisitorArgs>
+  void local_visit_group(const key_type &key, Function &fn,
+                         const VisitorArgs &...args) {
+    ygm::detail::interrupt_mask mask(m_comm);
+
+    if constexpr (std::is_invocable<decltype(fn), const key_type &,
+                                    group_type, VisitorArgs &...>() ||
+                  std::is_invocable<decltype(fn), ptr_type, const key_type &,
+                                    group_type, VisitorArgs &...>()) {
+      auto itr = m_local_map.find(key);
+      if (itr == m_local_map.end()) {
+        return;
+      }
+      group_type group(itr->second.data(), itr->second.size());
+      ygm::meta::apply_optional(fn, std::make_tuple(pthis),
+                                std::forward_as_tuple(key, group, args...));
+    } else {
+      static_assert(ygm::detail::always_false<>,
+                    "remote grouped_multimap group lambda signature must be "
+                    "invocable with (const &key_type, group_type, ...) or "
+                    "(ptr_type, const &key_type, group_type, ...) signatures");
+    }
+  }
+
+  void local_erase(const key_type &key) {
+    auto itr = m_local_map.find(key);
+    if (itr != m_local_map.end()) {
+      m_local_values -= itr->second.size();
+      m_local_map.erase(itr);
+    }
+  }
+
+  void local_clear() {
+    m_local_map.clear();
+    m_local_values = 0;
+  }
+
+  size_type local_size() const { return m_local_values; }
+
+  ygm::comm &comm() { return m_comm; }
+
+  // Estimated heap bytes held by this rank's groups. Walks every group.
+  size_t local_memory_bytes() const {
+    size_t bytes = local_container_bytes(m_local_map);
+    for (const auto &kv : m_local_map) {
+      bytes += local_container_bytes(kv.second);
+    }
+    return bytes;
+  }
+
+  void set_memory_name(const std::string &name) { m_memory.rename(name); }
+
+  template <typename Function>
+  void local_for_all(Function fn) {
+    if constexpr (std::is_invocable<decltype(fn), const key_type,
+                                    mapped_type &>()) {
+      for (auto &kv : m_local_map) {
+        for (auto &value : kv.second) {
+          fn(kv.first, value);
+        }
+      }
+    } else {
+      static_assert(ygm::detail::always_false<>,
+                    "local grouped_multimap lambda signature must be "
+                    "invocable with (const &key_type, mapped_type&) signature");
+    }
+  }
+
+  template <typename Function>
+  void local_for_all_groups(Function fn) {
+    if constexpr (std::is_invocable<decltype(fn), const key_type,
+                                    group_type>()) {
+      for (auto &kv : m_local_map) {
+        fn(kv.first, group_type(kv.second.data(), kv.second.size()));
+      }
+    } else {
+      static_assert(ygm::detail::always_false<>,
+                    "local grouped_multimap group lambda signature must be "
+                    "invocable with (const &key_type, group_type) signature");
+    }
+  }
+
+ protected:
+  grouped_multimap_impl() = delete;
+
+  LocalMap          m_local_map;
+  size_t            m_local_values = 0;
+  ygm::comm        &m_comm;
+  ptr_type          pthis;
+  ygm::routing_type m_routing = ygm::routing_type::DEFAULT;
+
+  ygm::detail::memory_tracker m_memory{
+      m_comm.memory_sources(), "grouped_multimap",
+      [this]() { return local_memory_bytes(); }};
+};
+}  // namespace ygm::container::detail
@@ -0,0 +1,286 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <algorithm>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <ygm/collective.hpp>
+#include <ygm/comm.hpp>
+#include <ygm/container/detail/block_bloom_filter.hpp>
+#include <ygm/container/detail/flat_hash_table.hpp>
+#include <ygm/container/detail/hash_partitioner.hpp>
+#include <ygm/detail/std_traits.hpp>
+#include <ygm/detail/ygm_traits.hpp>
+
+namespace ygm::container::detail {
+
+enum class join_kind { inner, left, semi };
+
+// Stands in for the value of key-only containers
+struct join_no_value {
+  template <class Archive>
+  void serialize(Archive &ar) {}
+};
+
+// Key and value types of a container's rows, from its ygm_for_all_types
+template <typename ForAllTypes>
+struct join_row_types {
+  static_assert(ygm::detail::always_false<ForAllTypes>,
+                "join inputs must hold keys, key-value pairs, or std::pairs");
+};
+
+template <typename Key>
+struct join_row_types<std::tuple<Key>> {
+  using key_type                  = Key;
+  using value_type                = join_no_value;
+  static constexpr bool has_value = false;
+};
+
+template <typename Key, typename Value>
+struct join_row_types<std::tuple<std::pair<Key, Value>>> {
+  using key_type                  = Key;
+  using value_type                = Value;
+  static constexpr bool has_value = true;
+};
+
+template <typename Key, typename Value>
+struct join_row_types<std::tuple<Key, Value>> {
+  using key_type                  = Key;
+  using value_type                = Value;
+  static constexpr bool has_value = true;
+};
+
+template <typename Container>
+using join_traits = join_row_types<typename Container::ygm_for_all_types>;
+
+// Containers placing keys with a partitioner expose partitioner_type and owner
+template <typename Container, typename = void>
+struct is_key_partitioned : std::false_type {};
+
+template <typename Container>
+struct is_key_partitioned<Container,
+                          std::void_t<typename Container::partitioner_type>>
+    : std::true_type {};
+
+template <typename Left, typename Right, typename = void>
+struct is_co_partitioned : std::false_type {};
+
+template <typename Left, typename Right>
+struct is_co_partitioned<Left, Right,
+                         std::void_t<typename Left::partitioner_type,
+                                     typename Right::partitioner_type>>
+    : std::is_same<typename Left::partitioner_type,
+                   typename Right::partitioner_type> {};
+
+// Calls fn(key, value) for each local row of c, with join_no_value for
+// key-only containers
+template <typename Container, typename Function>
+void for_all_join_rows(Container &c, Function fn) {
+  using traits     = join_traits<Container>;
+  using key_type   = typename traits::key_type;
+  using value_type = typename traits::value_type;
+
+  if constexpr (traits::has_value) {
+    c.for_all([&fn](const key_type &key, const value_type &value) {
+      fn(key, value);
+    });
+  } else {
+    c.for_all([&fn](const key_type &key) { fn(key, join_no_value{}); });
+  }
+}
+
+template <typename Container>
+auto collect_join_rows(Container &c) {
+  using traits     = join_traits<Container>;
+  using key_type   = typename traits::key_type;
+  using value_type = typename traits::value_type;
+
+  std::vector<std::pair<key_type, value_type>> rows;
+  for_all_join_rows(c, [&rows](const key_type &key, const value_type &value) {
+    rows.emplace_back(key, value);
+  });
+  return rows;
+}
+/**
+ * @brief Collective hash join of left and right on their keys. Calls fn on the
+ * rank owning each key, once per matching row (inner, left) or matching left
+ * row (semi).
+ *
+ * Rows of an input already placed by its partitioner stay put and are read in
+ * place; the other input is copied out and moved to match with one
+ * ygm::exchange. When both inputs share a partitioner type nothing is moved at
+ * all. With use_bloom_filter, rows of a moving side are first pruned against a
+ * Bloom filter of the other side's keys; when both sides move the larger one
+ * is pruned. Left rows of a left join are never pruned.
+ */
+template <join_kind Kind, typename Left, typename Right, typename Function>
+void hash_join(Left &left, Right &right, Function fn,
+               const bool use_bloom_filter) {
+  using left_traits  = join_traits<Left>;
+  using right_traits = join_traits<Right>;
+  using key_type     = typename left_traits::key_type;
+  using left_value   = typename left_traits::value_type;
+  using right_value  = typename right_traits::value_type;
+  static_assert(std::is_same_v<key_type, typename right_traits::key_type>,
+                "join inputs must have the same key type");
+  static_assert(Kind == join_kind::semi ||
+                    (left_traits::has_value && right_traits::has_value),
+                "inner and left joins need values on both sides");
+
+  constexpr bool left_placed = is_key_partitioned<Left>::value;
+  constexpr bool right_placed =
+      is_co_partitioned<Left, Right>::value ||
+      (is_key_partitioned<Right>::value && !left_placed);
+
+  ygm::comm &c = left.comm();
+
+  std::vector<std::pair<key_type, left_value>>  lrows;
+  std::vector<std::pair<key_type, right_value>> rrows;
+  if constexpr (!left_placed) {
+    lrows = collect_join_rows(left);
+  }
+  if constexpr (!right_placed) {
+    rrows = collect_join_rows(right);
+  }
+
+  auto for_left_rows = [&left, &lrows](auto f) {
+    if constexpr (left_placed) {
+      for_all_join_rows(left, f);
+    } else {
+      for (const auto &row : lrows) {
+        f(row.first, row.second);
+      }
+    }
+  };
+  auto for_right_rows = [&right, &rrows](auto f) {
+    if constexpr (right_placed) {
+      for_all_join_rows(right, f);
+    } else {
+      for (const auto &row : rrows) {
+        f(row.first, row.second);
+      }
+    }
+  };
+
+  if constexpr (!(left_placed && right_placed)) {
+    auto owner = [&left, &right, &c](const key_type &key) -> int {
+      if constexpr (left_placed) {
+        return left.owner(key);
+      } else if constexpr (right_placed) {
+        return right.owner(key);
+      } else {
+        return hash_partitioner<key_type>{}(key, c.size(), 1024).first;
+      }
+    };
+
+    auto prune = [&c](auto for_build_rows, auto &probe) {
+      size_t local_build = 0;
+      for_build_rows([&local_build](const auto &, const auto &) {
+        ++local_build;
+      });
+
+      // Replicated on every rank: each sets its keys' bits, then all are OR-ed
+      block_bloom_filter filter(c.all_reduce_sum(local_build));
+      for_build_rows([&filter](const key_type &key, const auto &) {
+        filter.insert(key);
+      });
+      filter.all_reduce_or(c);
+
+      probe.erase(std::remove_if(probe.begin(), probe.end(),
+                                 [&filter](const auto &row) {
+                                   return !filter.maybe_contains(row.first);
+                                 }),
+                  probe.end());
+    };
+
+    // Pruning a placed side saves no traffic, and a left join keeps every
+    // left row whether or not it matches
+    constexpr bool can_prune_left  = !left_placed && Kind != join_kind::left;
+    constexpr bool can_prune_right = !right_placed;
+    if constexpr (can_prune_left || can_prune_right) {
+      if (use_bloom_filter) {
+        bool prune_left = can_prune_left;
+        if constexpr (can_prune_left && can_prune_right) {
+          prune_left = c.all_reduce_sum(lrows.size()) >
+                       c.all_reduce_sum(rrows.size());
+        }
+        if (prune_left) {
+          prune(for_right_rows, lrows);
+        } else {
+          prune(for_left_rows, rrows);
+        }
+      }
+    }
+
+    auto ship = [&owner, &c](auto &rows) {
+      using row_type = typename std::decay_t<decltype(rows)>::value_type;
+      std::vector<std::vector<row_type>> to_send(c.size());
+      for (auto &row : rows) {
+        to_send[owner(row.first)].push_back(std::move(row));
+      }
+      rows = ygm::exchange(to_send, c);
+    };
+    if constexpr (!left_placed) {
+      ship(lrows);
+    }
+    if constexpr (!right_placed) {
+      ship(rrows);
+    }
+  }
+
+  if constexpr (Kind == join_kind::semi) {
+    std::unordered_set<key_type> keys;
+    for_right_rows(
+        [&keys](const key_type &key, const auto &) { keys.insert(key); });
+    for_left_rows([&keys, &fn](const key_type &key, const left_value &value) {
+      if (keys.count(key)) {
+        if constexpr (left_traits::has_value) {
+          fn(key, value);
+        } else {
+          fn(key);
+        }
+      }
+    });
+  } else {
+    std::unordered_multimap<key_type, right_value> index;
+    if constexpr (right_placed) {
+      for_right_rows([&index](const key_type &key, const right_value &value) {
+        index.emplace(key, value);
+      });
+    } else {
+      index.reserve(rrows.size());
+      for (auto &row : rrows) {
+        index.emplace(std::move(row));
+      }
+      rrows.clear();
+    }
+    for_left_rows([&index, &fn](const key_type   &key,
+                                const left_value &value) {
+      auto range = index.equal_range(key);
+      if constexpr (Kind == join_kind::left) {
+        if (range.first == range.second) {
+          fn(key, value, std::optional<right_value>());
+        }
+      }
+      for (auto itr = range.first; itr != range.second; ++itr) {
+        if constexpr (Kind == join_kind::left) {
+          fn(key, value, std::optional<right_value>(itr->second));
+        } else {
+          fn(key, value, itr->second);
+        }
+      }
+    });
+  }
+
+  c.barrier();
+}
+
+}  // namespace ygm::container::detail
@@ -0,0 +1,133 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <algorithm>
+#include <cereal/types/unordered_map.hpp>
+#include <unordered_map>
+#include <vector>
+#include <ygm/comm.hpp>
+#include <ygm/container/detail/memory_usage.hpp>
+
+namespace ygm::container::detail {
+
+/**
+ * @brief Misra-Gries summary of a key stream. Keeps at most capacity counters;
+ * every key seen more than total() / (capacity + 1) times is guaranteed to
+ * hold one, and counts underestimate by at most that much.
+ */
+template <typename Key>
+class heavy_hitters {
+ public:
+  using key_type   = Key;
+  using entry_type = std::pair<key_type, size_t>;
+
+  heavy_hitters(const size_t capacity) : m_capacity(capacity) {
+    m_counters.reserve(capacity + 1);
+  }
+
+  void insert(const key_type &key, const size_t weight = 1) {
+    m_total += weight;
+    auto itr = m_counters.find(key);
+    if (itr != m_counters.end()) {
+      itr->second += weight;
+    } else if (m_counters.size() < m_capacity) {
+      m_counters.emplace(key, weight);
+    } else {
+      // Decrement all counters; each decrement is paid for by an earlier
+      // insert, so this is amortized O(1)
+      size_t decrement = weight;
+      for (const auto &kv : m_counters) {
+        decrement = std::min(decrement, kv.second);
+      }
+      for (auto itr = m_counters.begin(); itr != m_counters.end();) {
+        itr->second -= decrement;
+        if (itr->second == 0) {
+          itr = m_counters.erase(itr);
+        } else {
+          ++itr;
+        }
+      }
+      if (weight > decrement) {
+        m_counters.emplace(key, weight - decrement);
+      }
+    }
+  }
+
+  size_t total() const { return m_total; }
+
+  size_t capacity() const { return m_capacity; }
+
+  size_t memory_bytes() const { return local_container_bytes(m_counters); }
+
+  // Calls fn(key, count) for each candidate held on this rank
+  template <typename Function>
+  void for_all(Function fn) const {
+    for (const auto &kv : m_counters) {
+      fn(kv.first, kv.second);
+    }
+  }
+
+  void clear() {
+    m_counters.clear();
+    m_total = 0;
+  }
+
+  /**
+   * @brief Collective. Keys making up at least fraction of the stream across
+   * all ranks, sorted by key and identical on every rank. Since merged counts
+   * may fall short by up to 1 / (capacity + 1) of the stream, keys that close
+   * below fraction may be included too.
+   */
+  std::vector<key_type> global_heavy(ygm::comm &c, const double fraction) {
+    std::vector<entry_type> local(m_counters.begin(), m_counters.end());
+    std::sort(local.begin(), local.end());
+
+    auto merge = [](const std::vector<entry_type> &a,
+                    const std::vector<entry_type> &b) {
+      std::vector<entry_type> out;
+      out.reserve(a.size() + b.size());
+      auto ia = a.begin();
+      auto ib = b.begin();
+      while (ia != a.end() || ib != b.end()) {
+        if (ib == b.end() || (ia != a.end() && ia->first < ib->first)) {
+          out.push_back(*ia++);
+        } else if (ia == a.end() || ib->first < ia->first) {
+          out.push_back(*ib++);
+        } else {
+          out.emplace_back(ia->first, ia->second + ib->second);
+          ++ia;
+          ++ib;
+        }
+      }
+      return out;
+    };
+    auto   merged = c.all_reduce(local, merge);
+    size_t total  = c.all_reduce_sum(m_total);
+
+    const double threshold = (fraction - 1.0 / (m_capacity + 1)) * total;
+
+    std::vector<key_type> heavy;
+    for (const auto &kv : merged) {
+      if (kv.second > 0 && double(kv.second) >= threshold) {
+        heavy.push_back(kv.first);
+      }
+    }
+    return heavy;
+  }
+
+  template <class Archive>
+  void serialize(Archive &ar) {
+    ar(m_capacity, m_total, m_counters);
+  }
+
+ private:
+  size_t                               m_capacity;
+  size_t                               m_total = 0;
+  std::unordered_map<key_type, size_t> m_counters;
+};
+
+}  // namespace ygm::container::detail
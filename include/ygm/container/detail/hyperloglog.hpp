@@ -0,0 +1,104 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <algorithm>
+#include <cereal/types/vector.hpp>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include <ygm/container/detail/flat_hash_table.hpp>
+#include <ygm/detail/assert.hpp>
+
+namespace ygm::container::detail {
+
+// 64-bit hash of an item for the sketches, well mixed even where std::hash is
+// the identity
+template <typename T>
+size_t sketch_hash(const T &item) {
+  return flat_hash::mix(std::hash<T>{}(item));
+}
+
+/**
+ * @brief HyperLogLog estimate of the number of distinct hashes added. Holds
+ * 2^precision one-byte registers; the relative standard error is about
+ * 1.04 / sqrt(2^precision). Sketches of equal precision merge by taking the
+ * register-wise maximum, which is the sketch of the union of their inputs.
+ */
+class hyperloglog {
+ public:
+  static constexpr uint8_t min_precision     = 4;
+  static constexpr uint8_t max_precision     = 18;
+  static constexpr uint8_t default_precision = 14;
+
+  explicit hyperloglog(const uint8_t precision = default_precision)
+      : m_precision(std::clamp(precision, min_precision, max_precision)),
+        m_registers(size_t(1) << m_precision, 0) {}
+
+  // Adds a well-mixed 64-bit hash, e.g. from sketch_hash()
+  void add_hash(const uint64_t hash) {
+    const size_t   index = hash >> (64 - m_precision);
+    const uint64_t rest  = hash << m_precision;
+    // Position of the first set bit among the remaining 64 - p bits
+    const uint8_t rank =
+        rest == 0 ? uint8_t(64 - m_precision + 1)
+                  : uint8_t(std::min<int>(__builtin_clzll(rest) + 1,
+                                          64 - m_precision + 1));
+    m_registers[index] = std::max(m_registers[index], rank);
+  }
+
+  template <typename T>
+  void add(const T &item) {
+    add_hash(sketch_hash(item));
+  }
+
+  void merge(const hyperloglog &other) {
+    ASSERT_RELEASE(other.m_precision == m_precision);
+    for (size_t i = 0; i < m_registers.size(); ++i) {
+      m_registers[i] = std::max(m_registers[i], other.m_registers[i]);
+    }
+  }
+
+  // Estimated number of distinct hashes added
+  double estimate() const {
+    const double m     = m_registers.size();
+    double       sum   = 0;
+    size_t       zeros = 0;
+    for (const uint8_t r : m_registers) {
+      sum += std::ldexp(1.0, -int(r));
+      zeros += (r == 0);
+    }
+    const double alpha =
+        m_precision == 4   ? 0.673
+        : m_precision == 5 ? 0.697
+        : m_precision == 6 ? 0.709
+                           : 0.7213 / (1.0 + 1.079 / m);
+    const double raw = alpha * m * m / sum;
+    // Linear counting is more accurate while many registers are still empty
+    if (raw <= 2.5 * m && zeros > 0) {
+      return m * std::log(m / double(zeros));
+    }
+    return raw;
+  }
+
+  uint8_t precision() const { return m_precision; }
+
+  void clear() { std::fill(m_registers.begin(), m_registers.end(), 0); }
+
+  size_t memory_bytes() const { return m_registers.capacity(); }
+
+  template <class Archive>
+  void serialize(Archive &ar) {
+    ar(m_precision, m_registers);
+  }
+
+ private:
+  uint8_t              m_precision;
+  std::vector<uint8_t> m_registers;
+};
+
+}  // namespace ygm::container::detail
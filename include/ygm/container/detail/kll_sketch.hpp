@@ -0,0 +1,225 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <algorithm>
+#include <cereal/types/vector.hpp>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+#include <ygm/detail/assert.hpp>
+
+namespace ygm::container::detail {
+
+/**
+ * @brief KLL quantile sketch. Items are kept in levels of compactors; an item
+ * on level h stands for 2^h inserted items. When the sketch is full, the
+ * lowest full level is sorted and every other item, starting at a random
+ * offset, is promoted, so the sketch keeps O(k log(n / k)) items and rank
+ * errors stay around 1.7 / k of n. Sketches with equal k merge by
+ * concatenating their levels and compacting, in any order.
+ */
+template <typename T, typename Compare = std::less<T>>
+class kll_sketch {
+ public:
+  using value_type = T;
+
+  static constexpr uint32_t default_k = 200;
+
+  explicit kll_sketch(const uint32_t k = default_k, const uint64_t seed = 0)
+      : m_k(std::max<uint32_t>(k, 8)), m_rng(seed * 2 + 1) {}
+
+  void insert(const value_type &item) {
+    if (m_levels.empty()) {
+      m_levels.emplace_back();
+      update_max_retained();
+    }
+    m_levels[0].push_back(item);
+    ++m_n;
+    if (++m_retained >= m_max_retained) {
+      compact();
+    }
+  }
+
+  void merge(const kll_sketch &other) {
+    ASSERT_RELEASE(other.m_k == m_k);
+    if (other.empty()) {
+      return;
+    }
+    if (other.m_levels.size() > m_levels.size()) {
+      m_levels.resize(other.m_levels.size());
+    }
+    for (size_t h = 0; h < other.m_levels.size(); ++h) {
+      m_levels[h].insert(m_levels[h].end(), other.m_levels[h].begin(),
+                         other.m_levels[h].end());
+    }
+    m_n += other.m_n;
+    m_retained += other.m_retained;
+    update_max_retained();
+    while (m_retained >= m_max_retained) {
+      compact();
+    }
+  }
+
+  // Number of items inserted, exactly
+  uint64_t count() const { return m_n; }
+
+  bool empty() const { return m_n == 0; }
+
+  /**
+   * @brief Smallest retained item whose estimated rank is at least q * count()
+   */
+  value_type quantile(const double q) const {
+    return quantiles(std::vector<double>{q})[0];
+  }
+
+  // quantile() of each of qs, sorting the retained items once
+  std::vector<value_type> quantiles(const std::vector<double> &qs) const {
+    ASSERT_RELEASE(!empty());
+    auto                    items = weighted_items();
+    std::vector<value_type> to_return;
+    to_return.reserve(qs.size());
+    for (const double q : qs) {
+      const double target = std::clamp(q, 0.0, 1.0) * m_n;
+      uint64_t     rank   = 0;
+      size_t       i      = 0;
+      for (; i + 1 < items.size(); ++i) {
+        rank += items[i].second;
+        if (rank >= target) {
+          break;
+        }
+      }
+      to_return.push_back(items[i].first);
+    }
+    return to_return;
+  }
+
+  // Estimated fraction of inserted items not greater than item
+  double cdf(const value_type &item) const {
+    if (empty()) {
+      return 0;
+    }
+    uint64_t rank = 0;
+    for_all_weighted([&rank, &item](const value_type &x, const uint64_t w) {
+      if (!Compare{}(item, x)) {
+        rank += w;
+      }
+    });
+    return double(rank) / m_n;
+  }
+
+  // Calls fn(item, weight) for each retained item
+  template <typename Function>
+  void for_all_weighted(Function fn) const {
+    for (size_t h = 0; h < m_levels.size(); ++h) {
+      for (const auto &item : m_levels[h]) {
+        fn(item, uint64_t(1) << h);
+      }
+    }
+  }
+
+  uint32_t k() const { return m_k; }
+
+  size_t num_retained() const { return m_retained; }
+
+  void clear() {
+    m_levels.clear();
+    m_n            = 0;
+    m_retained     = 0;
+    m_max_retained = 0;
+  }
+
+  size_t memory_bytes() const {
+    size_t to_return = m_levels.capacity() * sizeof(std::vector<value_type>);
+    for (const auto &level : m_levels) {
+      to_return += level.capacity() * sizeof(value_type);
+    }
+    return to_return;
+  }
+
+  template <class Archive>
+  void serialize(Archive &ar) {
+    ar(m_k, m_n, m_rng, m_levels);
+    m_retained = 0;
+    for (const auto &level : m_levels) {
+      m_retained += level.size();
+    }
+    update_max_retained();
+  }
+
+ private:
+  // Level h holds up to k * (2/3)^(levels above h) items, and at least 2
+  size_t capacity(const size_t h) const {
+    const size_t depth = m_levels.size() - 1 - h;
+    return std::max<size_t>(2, std::ceil(m_k * std::pow(2.0 / 3.0, depth)));
+  }
+
+  // Capacities change only when a level is added, so their sum is cached
+  void update_max_retained() {
+    m_max_retained = 0;
+    for (size_t h = 0; h < m_levels.size(); ++h) {
+      m_max_retained += capacity(h);
+    }
+  }
+
+  // Halves the lowest level at or over its capacity into the level above
+  void compact() {
+    size_t h = 0;
+    while (m_levels[h].size() < capacity(h)) {
+      ++h;
+    }
+    if (h + 1 == m_levels.size()) {
+      m_levels.emplace_back();
+      update_max_retained();
+    }
+    auto &level = m_levels[h];
+    auto &above = m_levels[h + 1];
+    std::sort(level.begin(), level.end(), Compare{});
+
+    // An odd item out stays behind
+    const size_t paired = level.size() & ~size_t(1);
+    for (size_t i = coin_flip(); i < paired; i += 2) {
+      above.push_back(std::move(level[i]));
+    }
+    if (paired < level.size()) {
+      std::swap(level[0], level.back());
+    }
+    level.resize(level.size() - paired);
+    m_retained -= paired / 2;
+  }
+
+  // Retained items sorted, with their weights
+  std::vector<std::pair<value_type, uint64_t>> weighted_items() const {
+    std::vector<std::pair<value_type, uint64_t>> items;
+    items.reserve(num_retained());
+    for_all_weighted([&items](const value_type &x, const uint64_t w) {
+      items.emplace_back(x, w);
+    });
+    std::sort(items.begin(), items.end(), [](const auto &a, const auto &b) {
+      return Compare{}(a.first, b.first);
+    });
+    return items;
+  }
+
+  size_t coin_flip() {
+    // xorshift64
+    m_rng ^= m_rng << 13;
+    m_rng ^= m_rng >> 7;
+    m_rng ^= m_rng << 17;
+    return m_rng & 1;
+  }
+
+  uint32_t                             m_k;
+  uint64_t                             m_n = 0;
+  uint64_t                             m_rng;
+  size_t                               m_retained     = 0;
+  size_t                               m_max_retained = 0;
+  std::vector<std::vector<value_type>> m_levels;
+};
+
+}  // namespace ygm::container::detail
@@ -6,24 +6,43 @@
 #pragma once
 #include <cereal/archives/json.hpp>
 #include <cereal/types/utility.hpp>
+#include <algorithm>
 #include <fstream>
 #include <map>
+#include <type_traits>
+#include <ygm/collective.hpp>
 #include <ygm/comm.hpp>
 #include <ygm/container/container_traits.hpp>
+#include <ygm/container/detail/bulk_lookup.hpp>
 #include <ygm/container/detail/hash_partitioner.hpp>
+#include <ygm/container/detail/memory_usage.hpp>
+#include <ygm/container/detail/pool_allocator.hpp>
+#include <ygm/container/detail/topk.hpp>
 #include <ygm/detail/interrupt_mask.hpp>
 #include <ygm/detail/ygm_ptr.hpp>
 #include <ygm/detail/ygm_traits.hpp>
 
 namespace ygm::container::detail {
 
+// True for local maps kept in key order, which take insertion hints
+template <typename LocalMap, typename = void>
+struct is_ordered_local_map : std::false_type {};
+
+template <typename LocalMap>
+struct is_ordered_local_map<
+    LocalMap, std::void_t<decltype(std::declval<LocalMap &>().lower_bound(
+                  std::declval<const typename LocalMap::key_type &>()))>>
+    : std::true_type {};
+
 template <typename Key, typename Value,
           typename Partitioner = detail::hash_partitioner<Key>,
           typename Compare     = std::less<Key>,
-          class Alloc          = std::allocator<std::pair<const Key, Value>>>
+          class Alloc          = pool_allocator<std::pair<const Key, Value>>,
+          class LocalMap       = std::multimap<Key, Value, Compare, Alloc>>
 class map_impl {
  public:
-  using self_type          = map_impl<Key, Value, Partitioner, Compare, Alloc>;
+  using self_type =
+      map_impl<Key, Value, Partitioner, Compare, Alloc, LocalMap>;
   using ptr_type           = typename ygm::ygm_ptr<self_type>;
   using mapped_type        = Value;
   using key_type           = Key;
@@ -45,11 +64,18 @@ class map_impl {
   map_impl(const self_type &rhs)
       : m_default_value(rhs.m_default_value), m_comm(rhs.m_comm), pthis(this) {
     m_local_map.insert(std::begin(rhs.m_local_map), std::end(rhs.m_local_map));
+    m_routing = rhs.m_routing;
     pthis.check(m_comm);
   }
 
   ~map_impl() { m_comm.barrier(); }
 
+  /**
+   * @brief Selects the routing used by messages sent from this container,
+   * overriding YGM_COMM_ROUTING
+   */
+  void set_routing(const ygm::routing_type route) { m_routing = route; }
+
   void async_insert_unique(const key_type &key, const mapped_type &value) {
     auto inserter = [](auto mailbox, auto map, const key_type &key,
                        const mapped_type &value) {
@@ -61,7 +87,7 @@ class map_impl {
       }
     };
     int dest = owner(key);
-    m_comm.async(dest, inserter, pthis, key, value);
+    m_comm.async(m_routing, dest, inserter, pthis, key, value);
   }
 
   void async_insert_if_missing(const key_type &key, const mapped_type &value) {
@@ -77,7 +103,7 @@ class map_impl {
       map->m_local_map.insert(std::make_pair(key, value));
     };
     int dest = owner(key);
-    m_comm.async(dest, inserter, pthis, key, value);
+    m_comm.async(m_routing, dest, inserter, pthis, key, value);
   }
 
   template <typename Visitor, typename... VisitorArgs>
@@ -96,7 +122,7 @@ class map_impl {
       pmap->local_visit(key, *vis, args...);
     };
 
-    m_comm.async(dest, visit_wrapper, pthis, key,
+    m_comm.async(m_routing, dest, visit_wrapper, pthis, key,
                  std::forward<const VisitorArgs>(args)...);
   }
 
@@ -121,7 +147,7 @@ class map_impl {
           std::forward_as_tuple(range.first, range.second, args...));
     };
 
-    m_comm.async(dest, visit_wrapper, pthis, key,
+    m_comm.async(m_routing, dest, visit_wrapper, pthis, key,
                  std::forward<const VisitorArgs>(args)...);
   }
 
@@ -135,7 +161,7 @@ class map_impl {
       pmap->local_visit(key, *vis, args...);
     };
 
-    m_comm.async(dest, visit_wrapper, pthis, key,
+    m_comm.async(m_routing, dest, visit_wrapper, pthis, key,
                  std::forward<const VisitorArgs>(args)...);
   }
 
@@ -157,8 +183,8 @@ class map_impl {
       }
     };
 
-    m_comm.async(dest, insert_else_visit_wrapper, pthis, key, value,
-                 std::forward<const VisitorArgs>(args)...);
+    m_comm.async(m_routing, dest, insert_else_visit_wrapper, pthis, key,
+                 value, std::forward<const VisitorArgs>(args)...);
   }
 
   template <typename ReductionOp>
@@ -176,7 +202,7 @@ class map_impl {
       }
     };
 
-    m_comm.async(dest, reduce_wrapper, pthis, key, value);
+    m_comm.async(m_routing, dest, reduce_wrapper, pthis, key, value);
   }
 
   void async_erase(const key_type &key) {
@@ -185,7 +211,7 @@ class map_impl {
       pmap->local_erase(key);
     };
 
-    m_comm.async(dest, erase_wrapper, pthis, key);
+    m_comm.async(m_routing, dest, erase_wrapper, pthis, key);
   }
 
   size_t local_count(const key_type &key) { return m_local_map.count(key); }
@@ -219,28 +245,67 @@ class map_impl {
     m_local_map.swap(s.m_local_map);
   }
 
-  template <typename STLKeyContainer, typename MapKeyValue>
-  void all_gather(const STLKeyContainer &keys, MapKeyValue &output) {
-    ygm::ygm_ptr<MapKeyValue> preturn(&output);
-
-    auto fetcher = [](auto pcomm, int from, const key_type &key, auto pmap,
-                      auto pcont) {
-      auto returner = [](auto pcomm, const key_type &key,
-                         const std::vector<mapped_type> &values, auto pcont) {
-        for (const auto &v : values) {
-          pcont->insert(std::make_pair(key, v));
-        }
-      };
-      auto values = pmap->local_get(key);
-      pcomm->async(from, returner, key, values, pcont);
-    };
+  /**
+   * @brief Collective. Inserts every (key, value) pair of input, a container
+   * whose for_all yields (key, value), combining values that share a key,
+   * including one already stored, with reducer(old, value).
+   *
+   * Instead of one message per pair, each rank sorts and combines the pairs
+   * bound for each owner, moves them with one ygm::exchange, then sorts and
+   * combines what it received and builds its local map in one ordered pass.
+   * reducer must be associative and commutative, as for async_reduce.
+   */
+  template <typename Container, typename ReductionOp>
+  void bulk_load(Container &input, ReductionOp reducer) {
+    using row_type = std::pair<key_type, mapped_type>;
+
+    std::vector<std::vector<row_type>> to_send(m_comm.size());
+    input.for_all([this, &to_send](const key_type    &key,
+                                   const mapped_type &value) {
+      to_send[owner(key)].emplace_back(key, value);
+    });
+    for (auto &rows : to_send) {
+      combine_sorted(rows, reducer);
+    }
 
-    m_comm.barrier();
-    for (const auto &key : keys) {
-      int o = owner(key);
-      m_comm.async(o, fetcher, m_comm.rank(), key, pthis, preturn);
+    std::vector<row_type> rows = ygm::exchange(to_send, m_comm);
+    to_send.clear();
+    to_send.shrink_to_fit();
+    combine_sorted(rows, reducer);
+
+    if constexpr (is_ordered_local_map<LocalMap>::value) {
+      // Sorted rows go straight in behind the previous one when this rank
+      // started empty, otherwise each needs a search
+      const bool append = m_local_map.empty();
+      for (auto &row : rows) {
+        auto itr = append ? m_local_map.end()
+                          : m_local_map.lower_bound(row.first);
+        if (itr != m_local_map.end() && !Compare{}(row.first, itr->first)) {
+          itr->second = reducer(itr->second, row.second);
+        } else {
+          m_local_map.emplace_hint(itr, std::move(row.first),
+                                   std::move(row.second));
+        }
+      }
+    } else {
+      m_local_map.reserve(m_local_map.size() + rows.size());
+      for (auto &row : rows) {
+        auto itr = m_local_map.find(row.first);
+        if (itr != m_local_map.end()) {
+          itr->second = reducer(itr->second, row.second);
+        } else {
+          m_local_map.emplace(std::move(row.first), std::move(row.second));
+        }
+      }
     }
-    m_comm.barrier();
+  }
+
+  template <typename STLKeyContainer, typename MapKeyValue>
+  void all_gather(const STLKeyContainer &keys, MapKeyValue &output) {
+    bulk_lookup(*this, keys,
+                [&output](const key_type &key, const mapped_type &value) {
+                  output.insert(std::make_pair(key, value));
+                });
   }
 
   typename ygm::ygm_ptr<self_type> get_ygm_ptr() const { return pthis; }
@@ -340,40 +405,56 @@ class map_impl {
   template <typename CompareFunction>
   std::vector<std::pair<key_type, mapped_type>> topk(size_t          k,
                                                      CompareFunction cfn) {
-    using vec_type = std::vector<std::pair<key_type, mapped_type>>;
-
     m_comm.barrier();
-
-    vec_type local_topk;
-    for (const auto &kv : m_local_map) {
-      local_topk.push_back(kv);
-      std::sort(local_topk.begin(), local_topk.end(), cfn);
-      if (local_topk.size() > k) {
-        local_topk.pop_back();
-      }
-    }
-
-    auto to_return = m_comm.all_reduce(
-        local_topk, [cfn, k](const vec_type &va, const vec_type &vb) {
-          vec_type out(va.begin(), va.end());
-          out.insert(out.end(), vb.begin(), vb.end());
-          std::sort(out.begin(), out.end(), cfn);
-          while (out.size() > k) {
-            out.pop_back();
+    return distributed_topk<std::pair<key_type, mapped_type>>(
+        m_comm, k, cfn, [this](auto push) {
+          for (const auto &kv : m_local_map) {
+            push(kv);
           }
-          return out;
         });
-    return to_return;
   }
 
   const mapped_type &default_value() const { return m_default_value; }
 
+  // Estimated heap bytes held by this rank's entries
+  size_t local_memory_bytes() const {
+    return local_container_bytes(m_local_map);
+  }
+
+  // Name this map is reported under by ygm::memory_report()
+  void set_memory_name(const std::string &name) { m_memory.rename(name); }
+
  protected:
+  // Sorts rows by key and folds each run of equal keys into one row
+  template <typename Row, typename ReductionOp>
+  static void combine_sorted(std::vector<Row> &rows, ReductionOp &reducer) {
+    std::sort(rows.begin(), rows.end(), [](const Row &a, const Row &b) {
+      return Compare{}(a.first, b.first);
+    });
+    auto out = rows.begin();
+    for (auto itr = rows.begin(); itr != rows.end(); ++itr) {
+      if (out != rows.begin() && !Compare{}((out - 1)->first, itr->first)) {
+        (out - 1)->second = reducer((out - 1)->second, itr->second);
+      } else {
+        if (out != itr) {
+          *out = std::move(*itr);
+        }
+        ++out;
+      }
+    }
+    rows.erase(out, rows.end());
+  }
+
   map_impl() = delete;
 
-  mapped_type                                          m_default_value;
-  std::multimap<key_type, mapped_type, Compare, Alloc> m_local_map;
-  ygm::comm                                           &m_comm;
-  ptr_type                                             pthis;
+  mapped_type       m_default_value;
+  LocalMap          m_local_map;
+  ygm::comm        &m_comm;
+  ptr_type          pthis;
+  ygm::routing_type m_routing = ygm::routing_type::DEFAULT;
+
+  ygm::detail::memory_tracker m_memory{
+      m_comm.memory_sources(), "map",
+      [this]() { return local_memory_bytes(); }};
 };
 }  // namespace ygm::container::detail
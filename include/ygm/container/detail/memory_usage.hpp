@@ -0,0 +1,59 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <type_traits>
+#include <ygm/container/detail/pool_allocator.hpp>
+
+namespace ygm::container::detail {
+
+// Per-element overhead assumed for node-based std containers: four words of
+// tree links and color, or a hash node's next pointer plus bucket and hash
+constexpr size_t node_overhead_bytes = 4 * sizeof(void *);
+
+template <typename Alloc>
+struct is_pool_allocator : std::false_type {};
+
+template <typename T, bool HugePages>
+struct is_pool_allocator<pool_allocator<T, HugePages>> : std::true_type {};
+
+template <typename Local, typename = void>
+struct has_memory_bytes : std::false_type {};
+
+template <typename Local>
+struct has_memory_bytes<
+    Local, std::void_t<decltype(std::declval<const Local &>().memory_bytes())>>
+    : std::true_type {};
+
+template <typename Local, typename = void>
+struct has_capacity : std::false_type {};
+
+template <typename Local>
+struct has_capacity<
+    Local, std::void_t<decltype(std::declval<const Local &>().capacity())>>
+    : std::true_type {};
+
+/**
+ * @brief Estimated heap bytes held by a rank-local container, counting its
+ * own storage and allocator overhead but not memory owned by the elements,
+ * such as the characters of long std::strings
+ */
+template <typename Local>
+size_t local_container_bytes(const Local &c) {
+  if constexpr (has_memory_bytes<Local>::value) {
+    return c.memory_bytes();
+  } else if constexpr (has_capacity<Local>::value) {
+    return c.capacity() * sizeof(typename Local::value_type);
+  } else if constexpr (is_pool_allocator<
+                           typename Local::allocator_type>::value) {
+    return c.get_allocator().stats().bytes_reserved;
+  } else {
+    return c.size() *
+           (sizeof(typename Local::value_type) + node_overhead_bytes);
+  }
+}
+
+}  // namespace ygm::container::detail
@@ -0,0 +1,301 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#include <algorithm>
+#include <map>
+#include <vector>
+#include <ygm/collective.hpp>
+#include <ygm/comm.hpp>
+#include <ygm/container/detail/memory_usage.hpp>
+#include <ygm/detail/interrupt_mask.hpp>
+#include <ygm/detail/ygm_ptr.hpp>
+#include <ygm/detail/ygm_traits.hpp>
+
+namespace ygm::container::detail {
+
+template <typename Key, typename Value, typename Compare = std::less<Key>>
+class ordered_map_impl {
+ public:
+  using self_type         = ordered_map_impl<Key, Value, Compare>;
+  using ptr_type          = typename ygm::ygm_ptr<self_type>;
+  using mapped_type       = Value;
+  using key_type          = Key;
+  using size_type         = size_t;
+  using ygm_for_all_types = std::tuple<Key, Value>;
+
+  ordered_map_impl(ygm::comm &comm) : m_comm(comm), pthis(this) {
+    pthis.check(m_comm);
+  }
+
+  ordered_map_impl(const self_type &rhs) = delete;
+
+  ~ordered_map_impl() { m_comm.barrier(); }
+
+  void set_routing(const ygm::routing_type route) { m_routing = route; }
+
+  void async_insert(const key_type &key, const mapped_type &value) {
+    auto inserter = [](auto pmap, const key_type &key,
+                       const mapped_type &value) {
+      pmap->m_local_map.insert_or_assign(key, value);
+    };
+    m_comm.async(m_routing, owner(key), inserter, pthis, key, value);
+  }
+
+  template <typename Visitor, typename... VisitorArgs>
+  void async_visit(const key_type &key, Visitor visitor,
+                   const VisitorArgs &...args) {
+    auto visit_wrapper = [](auto pmap, const key_type &key,
+                            const VisitorArgs &...args) {
+      auto     itr = pmap->m_local_map.try_emplace(key).first;
+      Visitor *vis = nullptr;
+      pmap->local_visit(itr, itr, *vis, args...);
+    };
+
+    m_comm.async(m_routing, owner(key), visit_wrapper, pthis, key,
+                 std::forward<const VisitorArgs>(args)...);
+  }
+
+  template <typename Visitor, typename... VisitorArgs>
+  void async_visit_if_exists(const key_type &key, Visitor visitor,
+                             const VisitorArgs &...args) {
+    auto visit_wrapper = [](auto pmap, const key_type &key,
+                            const VisitorArgs &...args) {
+      auto itr = pmap->m_local_map.find(key);
+      if (itr != pmap->m_local_map.end()) {
+        Visitor *vis = nullptr;
+        pmap->local_visit(itr, itr, *vis, args...);
+      }
+    };
+
+    m_comm.async(m_routing, owner(key), visit_wrapper, pthis, key,
+                 std::forward<const VisitorArgs>(args)...);
+  }
+
+  template <typename Visitor, typename... VisitorArgs>
+  void async_visit_range(const key_type &lo, const key_type &hi,
+                         Visitor visitor, const VisitorArgs &...args) {
+    if (!Compare{}(lo, hi)) {
+      return;
+    }
+    auto visit_wrapper = [](auto pmap, const key_type &lo,
+                            const key_type &hi, const VisitorArgs &...args) {
+      auto first = pmap->m_local_map.lower_bound(lo);
+      auto last  = pmap->m_local_map.lower_bound(hi);
+      if (first != last) {
+        Visitor *vis = nullptr;
+        pmap->local_visit(first, std::prev(last), *vis, args...);
+      }
+    };
+
+    // Only the ranks whose ranges overlap [lo, hi)
+    const int first_rank = owner(lo);
+    const int last_rank =
+        std::lower_bound(m_splitters.begin(), m_splitters.end(), hi,
+                         Compare{}) -
+        m_splitters.begin();
+    for (int dest = first_rank; dest <= last_rank; ++dest) {
+      m_comm.async(m_routing, dest, visit_wrapper, pthis, lo, hi,
+                   std::forward<const VisitorArgs>(args)...);
+    }
+  }
+
+  void async_erase(const key_type &key) {
+    auto erase_wrapper = [](auto pmap, const key_type &key) {
+      pmap->m_local_map.erase(key);
+    };
+    m_comm.async(m_routing, owner(key), erase_wrapper, pthis, key);
+  }
+
+  template <typename Function>
+  void for_all(Function fn) {
+    m_comm.barrier();
+    local_for_all(fn);
+  }
+
+  void clear() {
+    m_comm.barrier();
+    m_local_map.clear();
+  }
+
+  size_type size() {
+    m_comm.barrier();
+    return m_comm.all_reduce_sum(m_local_map.size());
+  }
+
+  size_t count(const key_type &key) {
+    m_comm.barrier();
+    return m_comm.all_reduce_sum(m_local_map.count(key));
+  }
+
+  double imbalance() {
+    m_comm.barrier();
+    size_t total = m_comm.all_reduce_sum(m_local_map.size());
+    size_t most  = m_comm.all_reduce_max(m_local_map.size());
+    return total == 0 ? 1.0 : double(most) * m_comm.size() / total;
+  }
+
+  void rebalance() {
+    m_comm.barrier();
+    const int nranks = m_comm.size();
+
+    // Weighted regular sampling: each sample stands for the local keys up to
+    // the next one
+    using sample_type = std::pair<key_type, size_t>;
+    std::vector<std::vector<sample_type>> to_root(nranks);
+    std::vector<sample_type>             &samples = to_root[0];
+    if (!m_local_map.empty()) {
+      const size_t num_samples =
+          std::min(m_local_map.size(), samples_per_rank);
+      size_t i    = 0;
+      size_t next = 0;
+      size_t prev = 0;
+      for (const auto &kv : m_local_map) {
+        if (i == next) {
+          if (!samples.empty()) {
+            samples.back().second = i - prev;
+          }
+          samples.emplace_back(kv.first, 0);
+          prev = i;
+          next = (samples.size() * m_local_map.size()) / num_samples;
+        }
+        ++i;
+      }
+      samples.back().second = i - prev;
+    }
+
+    // Rank 0 picks the splitters from everyone's samples and broadcasts them
+    auto                  gathered = ygm::exchange(to_root, m_comm);
+    std::vector<key_type> splitters;
+    if (m_comm.rank0()) {
+      std::sort(gathered.begin(), gathered.end(),
+                [](const auto &x, const auto &y) {
+                  return Compare{}(x.first, y.first);
+                });
+      size_t total = 0;
+      for (const auto &s : gathered) {
+        total += s.second;
+      }
+      size_t seen = 0;
+      for (const auto &s : gathered) {
+        while (splitters.size() + 1 < size_t(nranks) &&
+               seen >= (splitters.size() + 1) * total / nranks) {
+          splitters.push_back(s.first);
+        }
+        seen += s.second;
+      }
+    }
+    ygm::bcast(splitters, 0, m_comm);
+    m_splitters = std::move(splitters);
+
+    // Move entries to their new owners
+    using row_type = std::pair<key_type, mapped_type>;
+    std::vector<std::vector<row_type>> to_send(nranks);
+    for (auto itr = m_local_map.begin(); itr != m_local_map.end();) {
+      int dest = owner(itr->first);
+      if (dest != m_comm.rank()) {
+        to_send[dest].emplace_back(itr->first, std::move(itr->second));
+        itr = m_local_map.erase(itr);
+      } else {
+        ++itr;
+      }
+    }
+    ygm::exchange(
+        to_send,
+        [this](row_type &kv) {
+          m_local_map.insert_or_assign(kv.first, std::move(kv.second));
+        },
+        m_comm);
+  }
+
+  template <typename Container>
+  void load(Container &input) {
+    input.for_all([this](const key_type &key, const mapped_type &value) {
+      m_local_map.insert_or_assign(key, value);
+    });
+    rebalance();
+  }
+
+  int owner(const key_type &key) const {
+    return std::upper_bound(m_splitters.begin(), m_splitters.end(), key,
+                            Compare{}) -
+           m_splitters.begin();
+  }
+
+  bool is_mine(const key_type &key) const {
+    return owner(key) == m_comm.rank();
+  }
+
+  const std::vector<key_type> &splitters() const { return m_splitters; }
+
+  template <typename Function>
+  void local_for_all(Function fn) {
+    if constexpr (std::is_invocable<decltype(fn), const key_type,
+                                    mapped_type &>()) {
+      for (auto &kv : m_local_map) {
+        fn(kv.first, kv.second);
+      }
+    } else {
+      static_assert(ygm::detail::always_false<>,
+                    "local ordered_map lambda signature must be invocable "
+                    "with (const &key_type, mapped_type&) signature");
+    }
+  }
+
+  size_type local_size() const { return m_local_map.size(); }
+
+  ygm::comm &comm() { return m_comm; }
+
+  // Estimated heap bytes held by this rank's entries and the splitters
+  size_t local_memory_bytes() const {
+    return local_container_bytes(m_local_map) +
+           local_container_bytes(m_splitters);
+  }
+
+  void set_memory_name(const std::string &name) { m_memory.rename(name); }
+
+  typename ygm::ygm_ptr<self_type> get_ygm_ptr() const { return pthis; }
+
+  // Visits the entries from first through last, inclusive, in order
+  template <typename Iterator, typename Function, typename... VisitorArgs>
+  void local_visit(Iterator first, Iterator last, Function &fn,
+                   const VisitorArgs &...args) {
+    ygm::detail::interrupt_mask mask(m_comm);
+
+    if constexpr (std::is_invocable<decltype(fn), const key_type &,
+                                    mapped_type &, VisitorArgs &...>() ||
+                  std::is_invocable<decltype(fn), ptr_type, const key_type &,
+                                    mapped_type &, VisitorArgs &...>()) {
+      for (auto itr = first;; ++itr) {
+        ygm::meta::apply_optional(
+            fn, std::make_tuple(pthis),
+            std::forward_as_tuple(itr->first, itr->second, args...));
+        if (itr == last) {
+          break;
+        }
+      }
+    } else {
+      static_assert(ygm::detail::always_false<>,
+                    "remote ordered_map lambda signature must be invocable "
+                    "with (const &key_type, mapped_type&, ...) or (ptr_type, "
+                    "const &key_type, mapped_type&, ...) signatures");
+    }
+  }
+
+ private:
+  static constexpr size_t samples_per_rank = 256;
+
+  std::map<key_type, mapped_type, Compare> m_local_map;
+  std::vector<key_type>                    m_splitters;
+  ygm::comm                               &m_comm;
+  ptr_type                                 pthis;
+  ygm::routing_type m_routing = ygm::routing_type::DEFAULT;
+
+  ygm::detail::memory_tracker m_memory{
+      m_comm.memory_sources(), "ordered_map",
+      [this]() { return local_memory_bytes(); }};
+};
+
+}  // namespace ygm::container::detail
@@ -0,0 +1,208 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <sys/mman.h>
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace ygm::container::detail {
+
+struct pool_stats {
+  size_t slabs          = 0;  // Slabs currently held
+  size_t bytes_reserved = 0;  // Bytes held in slabs
+  size_t bytes_in_use   = 0;  // Bytes handed out and not yet returned
+};
+
+/**
+ * @brief Single-threaded arena serving small fixed-size blocks, such as tree
+ * nodes, from large slabs. Freed blocks go on a free list per size class, so
+ * allocate and deallocate are a few instructions. When the last block is
+ * returned, e.g. by clear(), every slab is released at once.
+ *
+ * Slabs start at min_slab_bytes and double up to max_slab_bytes. With
+ * huge_pages they are 2 MiB aligned and advised as transparent huge pages.
+ */
+class slab_arena {
+ public:
+  static constexpr size_t granularity     = 16;
+  static constexpr size_t max_block_bytes = 256;
+  static constexpr size_t min_slab_bytes  = 4 * 1024;
+  static constexpr size_t max_slab_bytes  = 1024 * 1024;
+  static constexpr size_t huge_page_bytes = 2 * 1024 * 1024;
+
+  // Whether blocks of this size and alignment come from the slabs
+  static constexpr bool pooled(const size_t bytes, const size_t align) {
+    return bytes <= max_block_bytes && align <= granularity;
+  }
+
+  explicit slab_arena(const bool huge_pages = false)
+      : m_huge_pages(huge_pages) {}
+
+  slab_arena(const slab_arena &) = delete;
+  slab_arena &operator=(const slab_arena &) = delete;
+
+  ~slab_arena() { release(); }
+
+  void *allocate(const size_t bytes) {
+    const size_t cls        = size_class(bytes);
+    const size_t block_size = cls * granularity;
+    m_stats.bytes_in_use += block_size;
+    if (free_block *block = m_free[cls]) {
+      m_free[cls] = block->next;
+      return block;
+    }
+    if (m_bump + block_size > m_bump_end) {
+      new_slab(block_size);
+    }
+    void *p = m_bump;
+    m_bump += block_size;
+    return p;
+  }
+
+  void deallocate(void *p, const size_t bytes) {
+    const size_t cls = size_class(bytes);
+    m_free[cls]      = new (p) free_block{m_free[cls]};
+    m_stats.bytes_in_use -= cls * granularity;
+    if (m_stats.bytes_in_use == 0) {
+      release();
+    }
+  }
+
+  pool_stats stats() const { return m_stats; }
+
+ private:
+  struct free_block {
+    free_block *next;
+  };
+
+  static size_t size_class(const size_t bytes) {
+    return (std::max(bytes, sizeof(free_block)) + granularity - 1) /
+           granularity;
+  }
+
+  void new_slab(const size_t block_size) {
+    size_t bytes = m_huge_pages ? huge_page_bytes : m_next_slab_bytes;
+    while (bytes < block_size) {
+      bytes *= 2;
+    }
+    m_next_slab_bytes = std::min(m_next_slab_bytes * 2, max_slab_bytes);
+
+    void *slab = m_huge_pages ? std::aligned_alloc(huge_page_bytes, bytes)
+                              : std::aligned_alloc(granularity, bytes);
+    if (slab == nullptr) {
+      throw std::bad_alloc();
+    }
+#ifdef MADV_HUGEPAGE
+    if (m_huge_pages) {
+      ::madvise(slab, bytes, MADV_HUGEPAGE);
+    }
+#endif
+    m_slabs.push_back(slab);
+    ++m_stats.slabs;
+    m_stats.bytes_reserved += bytes;
+    m_bump     = static_cast<std::byte *>(slab);
+    m_bump_end = m_bump + bytes;
+  }
+
+  void release() {
+    for (void *slab : m_slabs) {
+      std::free(slab);
+    }
+    m_slabs.clear();
+    m_free.fill(nullptr);
+    m_bump            = nullptr;
+    m_bump_end        = nullptr;
+    m_next_slab_bytes = min_slab_bytes;
+    m_stats           = pool_stats{};
+  }
+
+  bool                                                         m_huge_pages;
+  std::array<free_block *, max_block_bytes / granularity + 1> m_free{};
+  std::vector<void *>                                          m_slabs;
+  std::byte *m_bump            = nullptr;
+  std::byte *m_bump_end        = nullptr;
+  size_t     m_next_slab_bytes = min_slab_bytes;
+  pool_stats m_stats;
+};
+
+/**
+ * @brief Allocator drawing single small objects from a slab_arena and
+ * everything else from std::allocator. A default-constructed allocator owns
+ * a new arena, shared by its copies and rebinds, so each container gets its
+ * own arena and its node memory is freed in bulk once it is emptied.
+ * Copy-constructed containers get a fresh arena.
+ *
+ * Not thread-safe; each arena belongs to one rank's local container.
+ */
+template <typename T, bool HugePages = false>
+class pool_allocator {
+ public:
+  using value_type                             = T;
+  using propagate_on_container_copy_assignment = std::false_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap            = std::true_type;
+  using is_always_equal                        = std::false_type;
+
+  template <typename U>
+  struct rebind {
+    using other = pool_allocator<U, HugePages>;
+  };
+
+  pool_allocator() : m_arena(std::make_shared<slab_arena>(HugePages)) {}
+
+  // Moves copy too, so a moved-from container can still allocate
+  pool_allocator(const pool_allocator &) = default;
+  pool_allocator &operator=(const pool_allocator &) = default;
+
+  template <typename U>
+  pool_allocator(const pool_allocator<U, HugePages> &rhs)
+      : m_arena(rhs.arena()) {}
+
+  T *allocate(const size_t n) {
+    if (n == 1 && slab_arena::pooled(sizeof(T), alignof(T))) {
+      return static_cast<T *>(m_arena->allocate(sizeof(T)));
+    }
+    return std::allocator<T>{}.allocate(n);
+  }
+
+  void deallocate(T *p, const size_t n) {
+    if (n == 1 && slab_arena::pooled(sizeof(T), alignof(T))) {
+      m_arena->deallocate(p, sizeof(T));
+    } else {
+      std::allocator<T>{}.deallocate(p, n);
+    }
+  }
+
+  pool_allocator select_on_container_copy_construction() const {
+    return pool_allocator();
+  }
+
+  pool_stats stats() const { return m_arena->stats(); }
+
+  const std::shared_ptr<slab_arena> &arena() const { return m_arena; }
+
+ private:
+  std::shared_ptr<slab_arena> m_arena;
+};
+
+template <typename T, typename U, bool HugePages>
+bool operator==(const pool_allocator<T, HugePages> &a,
+                const pool_allocator<U, HugePages> &b) {
+  return a.arena() == b.arena();
+}
+
+template <typename T, typename U, bool HugePages>
+bool operator!=(const pool_allocator<T, HugePages> &a,
+                const pool_allocator<U, HugePages> &b) {
+  return !(a == b);
+}
+
+}  // namespace ygm::container::detail
@@ -0,0 +1,97 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+#include <ygm/container/detail/flat_hash_table.hpp>
+
+namespace ygm::container::detail {
+
+/**
+ * @brief Bounded, exact record of keys seen in the current epoch. Keys live in
+ * 4-way LRU sets, so a key can be forgotten early but is never reported as
+ * seen when it was not. Entries are stamped with their epoch, so moving to a
+ * new epoch is O(1).
+ */
+template <typename Key, typename Hash = std::hash<Key>>
+class recent_keys_filter {
+ public:
+  using key_type = Key;
+
+  static constexpr size_t ways = 4;
+
+  recent_keys_filter(const size_t capacity = 0) { resize(capacity); }
+
+  void resize(const size_t capacity) {
+    size_t sets = 1;
+    while (sets * ways < capacity) {
+      sets *= 2;
+    }
+    m_num_sets = capacity == 0 ? 0 : sets;
+    m_table.assign(m_num_sets * ways, entry{});
+  }
+
+  size_t capacity() const { return m_table.size(); }
+
+  size_t memory_bytes() const { return m_table.capacity() * sizeof(entry); }
+
+  /**
+   * @brief Records key in epoch. Returns false if key was already recorded in
+   * the same epoch.
+   */
+  bool insert(const key_type &key, const uint64_t epoch) {
+    if (m_num_sets == 0) {
+      return true;
+    }
+    // Stamps start at 1 so default entries never match
+    const uint64_t stamp = epoch + 1;
+    entry *set = m_table.data() +
+                 (flat_hash::mix(Hash{}(key)) & (m_num_sets - 1)) * ways;
+    size_t i = 0;
+    for (; i < ways - 1 && set[i].stamp == stamp; ++i) {
+      if (set[i].key == key) {
+        std::rotate(set, set + i, set + i + 1);
+        return false;
+      }
+    }
+    if (set[i].stamp == stamp && set[i].key == key) {
+      std::rotate(set, set + i, set + i + 1);
+      return false;
+    }
+    // Take the first stale slot, or the least recently used one
+    set[i] = entry{key, stamp};
+    std::rotate(set, set + i, set + i + 1);
+    return true;
+  }
+
+  void erase(const key_type &key, const uint64_t epoch) {
+    if (m_num_sets == 0) {
+      return;
+    }
+    const uint64_t stamp = epoch + 1;
+    entry *set = m_table.data() +
+                 (flat_hash::mix(Hash{}(key)) & (m_num_sets - 1)) * ways;
+    for (size_t i = 0; i < ways && set[i].stamp == stamp; ++i) {
+      if (set[i].key == key) {
+        set[i].stamp = 0;
+        std::rotate(set + i, set + i + 1, set + ways);
+        return;
+      }
+    }
+  }
+
+ private:
+  struct entry {
+    key_type key   = key_type();
+    uint64_t stamp = 0;
+  };
+
+  size_t             m_num_sets = 0;
+  std::vector<entry> m_table;
+};
+
+}  // namespace ygm::container::detail
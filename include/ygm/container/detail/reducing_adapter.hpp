@@ -5,6 +5,7 @@
 
 #pragma once
 #include <ygm/container/container_traits.hpp>
+#include <ygm/container/detail/combining_cache.hpp>
 #include <ygm/detail/ygm_ptr.hpp>
 #include <ygm/detail/ygm_traits.hpp>
 
@@ -18,12 +19,15 @@ class reducing_adapter {
   using key_type          = typename Container::key_type;
   //using value_type        = typename Container::value_type;
   
-  const size_t cache_size = 1024 * 1024;
-
-  reducing_adapter(Container &c, ReductionOp reducer)
-      : m_container(c), m_reducer(reducer), pthis(this) {
+  /**
+   * @param route Routing of cached reductions. Partial reductions are cached
+   * again at every hop, so multi-hop routings combine more values per message.
+   */
+  reducing_adapter(
+      Container &c, ReductionOp reducer,
+      const ygm::detail::routing_type route = ygm::detail::routing_type::NLNR)
+      : m_container(c), m_reducer(reducer), m_route(route), pthis(this) {
     pthis.check(c.comm());
-    m_cache.resize(cache_size);
   }
 
   ~reducing_adapter() { m_container.comm().barrier(); }
@@ -32,13 +36,13 @@ class reducing_adapter {
     cache_reduce(key, value);
   }
 
- private:
-  struct cache_entry {
-    key_type      key;
-    mapped_type   value;
-    bool          occupied = false;
-  };
+  /**
+   * @brief Hit, miss and flush counts of this rank's cache. Each flush is one
+   * message.
+   */
+  combining_cache_stats cache_stats() const { return m_cache.stats(); }
 
+ private:
   void cache_reduce(const key_type &key, const mapped_type &value) {
     // Bypass cache if current rank owns key
     if (m_container.comm().rank() == m_container.owner(key)) {
@@ -50,30 +54,16 @@ class reducing_adapter {
             [this]() { this->cache_flush_all(); });
       }
 
-      size_t slot = std::hash<key_type>{}(key) % cache_size;
-
-      if (m_cache[slot].occupied == false) {
-        m_cache[slot].key      = key;
-        m_cache[slot].value    = value;
-        m_cache[slot].occupied = true;
-      } else {  // Slot is occupied
-        if (m_cache[slot].key == key) {
-          m_cache[slot].value = m_reducer(m_cache[slot].value, value);
-        } else {
-          cache_flush(slot);
-          ASSERT_DEBUG(m_cache[slot].occupied == false);
-          m_cache[slot].key      = key;
-          m_cache[slot].value    = value;
-          m_cache[slot].occupied = true;
-        }
-      }
+      m_cache.combine(key, value, m_reducer,
+                      [this](const key_type &key, const mapped_type &value) {
+                        cache_flush(key, value);
+                      });
     }
   }
 
-  void cache_flush(const size_t slot) {
-    // Use NLNR for reductions
+  void cache_flush(const key_type &key, const mapped_type &value) {
     int next_dest = m_container.comm().router().next_hop(
-        m_container.owner(m_cache[slot].key), ygm::detail::routing_type::NLNR);
+        m_container.owner(key), m_route);
 
     m_container.comm().async(
         next_dest,
@@ -81,18 +71,15 @@ class reducing_adapter {
            const mapped_type &value) {
           p_reducing_adapter->cache_reduce(key, value);
         },
-        pthis, m_cache[slot].key, m_cache[slot].value);
-
-    m_cache[slot].occupied = false;
+        pthis, key, value);
   }
 
   void cache_flush_all() {
-    for (size_t i = 0; i < cache_size; ++i) {
-      if (m_cache[i].occupied) {
-        cache_flush(i);
-      }
-    }
+    // Cleared first, so values cached while flushing register a new callback
     m_cache_empty = true;
+    m_cache.flush_all([this](const key_type &key, const mapped_type &value) {
+      cache_flush(key, value);
+    });
   }
 
   void container_reduction(const key_type &key, const mapped_type &value) {
@@ -111,18 +98,24 @@ class reducing_adapter {
     }
   }
 
-  std::vector<cache_entry> m_cache;
-  bool                     m_cache_empty = true;
+  combining_cache<key_type, mapped_type> m_cache;
+  bool                                   m_cache_empty = true;
 
   Container                       &m_container;
   ReductionOp                      m_reducer;
+  ygm::detail::routing_type        m_route;
   typename ygm::ygm_ptr<self_type> pthis;
+
+  ygm::detail::memory_tracker m_memory{
+      m_container.comm().memory_sources(), "reducing_adapter",
+      [this]() { return m_cache.memory_bytes(); }};
 };
 
 template <typename Container, typename ReductionOp>
 reducing_adapter<Container, ReductionOp> make_reducing_adapter(
-    Container &c, ReductionOp reducer) {
-  return reducing_adapter<Container, ReductionOp>(c, reducer);
+    Container &c, ReductionOp reducer,
+    const ygm::detail::routing_type route = ygm::detail::routing_type::NLNR) {
+  return reducing_adapter<Container, ReductionOp>(c, reducer, route);
 }
 
 }  // namespace ygm::container::detail
@@ -0,0 +1,116 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+#include <ygm/collective.hpp>
+#include <ygm/comm.hpp>
+
+namespace ygm::container::detail {
+
+/**
+ * @brief Rank holding global index idx when global_size items are split into
+ * contiguous blocks the way ygm::container::array partitions them
+ */
+inline int block_owner(const size_t idx, const size_t global_size,
+                       const int nranks) {
+  size_t small_block_size = global_size / nranks;
+  size_t large_block_size = small_block_size + ((global_size % nranks) > 0);
+  size_t large_block_end  = (global_size % nranks) * large_block_size;
+  if (idx < large_block_end) {
+    return idx / large_block_size;
+  }
+  return (global_size % nranks) + (idx - large_block_end) / small_block_size;
+}
+
+/**
+ * @brief Collective sample sort with regular sampling.
+ *
+ * Each rank sorts its items and contributes nranks evenly spaced samples; the
+ * gathered samples pick nranks - 1 splitters, items are exchanged into their
+ * splitter buckets and merged, then moved once more so every rank ends up
+ * with its ygm::container::array sized block of the global order.
+ *
+ * @param local This rank's unsorted items, consumed
+ * @return This rank's block of the globally sorted sequence
+ */
+template <typename Value, typename Compare>
+std::vector<Value> sample_sort(std::vector<Value> local, Compare cmp,
+                               ygm::comm &c) {
+  c.barrier();
+  const int nranks = c.size();
+
+  std::sort(local.begin(), local.end(), cmp);
+  if (nranks == 1) {
+    return local;
+  }
+
+  // Regular sampling
+  std::vector<Value> samples;
+  if (!local.empty()) {
+    for (int i = 0; i < nranks; ++i) {
+      samples.push_back(local[i * local.size() / nranks]);
+    }
+  }
+  auto merge_samples = [&cmp](const std::vector<Value> &a,
+                              const std::vector<Value> &b) {
+    std::vector<Value> out;
+    out.reserve(a.size() + b.size());
+    std::merge(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(out),
+               cmp);
+    return out;
+  };
+  samples = c.all_reduce(samples, merge_samples);
+
+  std::vector<std::vector<Value>> to_send(nranks);
+  auto                            itr = local.begin();
+  for (int dest = 0; dest < nranks; ++dest) {
+    auto bucket_end = local.end();
+    if (dest + 1 < nranks && !samples.empty()) {
+      const Value &splitter = samples[(dest + 1) * samples.size() / nranks];
+      bucket_end            = std::upper_bound(itr, local.end(), splitter, cmp);
+    }
+    to_send[dest].assign(std::make_move_iterator(itr),
+                         std::make_move_iterator(bucket_end));
+    itr = bucket_end;
+  }
+  local.clear();
+
+  // Each source's bucket arrives sorted; merge them in turn
+  std::vector<std::vector<Value>> received(nranks);
+  ygm::exchange(
+      to_send,
+      [&received](int from, Value &item) {
+        received[from].push_back(std::move(item));
+      },
+      c);
+  to_send.clear();
+
+  std::vector<Value> sorted;
+  for (auto &run : received) {
+    size_t middle = sorted.size();
+    sorted.insert(sorted.end(), std::make_move_iterator(run.begin()),
+                  std::make_move_iterator(run.end()));
+    std::inplace_merge(sorted.begin(), sorted.begin() + middle, sorted.end(),
+                       cmp);
+    std::vector<Value>().swap(run);
+  }
+
+  // Balance into array blocks. Exchange orders arrivals by source rank, which
+  // keeps them globally sorted.
+  size_t global_size = c.all_reduce_sum(sorted.size());
+  size_t prefix      = ygm::prefix_sum(sorted.size(), c);
+
+  std::vector<std::vector<Value>> to_balance(nranks);
+  for (size_t i = 0; i < sorted.size(); ++i) {
+    to_balance[block_owner(prefix + i, global_size, nranks)].push_back(
+        std::move(sorted[i]));
+  }
+  return ygm::exchange(to_balance, c);
+}
+
+}  // namespace ygm::container::detail
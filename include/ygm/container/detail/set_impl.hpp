@@ -10,16 +10,20 @@
 #include <ygm/comm.hpp>
 #include <ygm/container/container_traits.hpp>
 #include <ygm/container/detail/hash_partitioner.hpp>
+#include <ygm/container/detail/memory_usage.hpp>
+#include <ygm/container/detail/pool_allocator.hpp>
+#include <ygm/container/detail/recent_keys_filter.hpp>
 #include <ygm/detail/ygm_ptr.hpp>
 #include <ygm/detail/ygm_traits.hpp>
 
 namespace ygm::container::detail {
 template <typename Key, typename Partitioner = detail::hash_partitioner<Key>,
           typename Compare = std::less<Key>,
-          class Alloc      = std::allocator<const Key>>
+          class Alloc      = pool_allocator<Key>,
+          class LocalSet   = std::multiset<Key, Compare, Alloc>>
 class set_impl {
  public:
-  using self_type          = set_impl<Key, Partitioner, Compare, Alloc>;
+  using self_type = set_impl<Key, Partitioner, Compare, Alloc, LocalSet>;
   using key_type           = Key;
   using size_type          = size_t;
   using ygm_container_type = ygm::container::set_tag;
@@ -29,41 +33,62 @@ class set_impl {
   set_impl(ygm::comm &comm) : m_comm(comm), pthis(this) { pthis.check(m_comm); }
   set_impl(set_impl &&s) noexcept
       : m_comm(s.m_comm), pthis(this), m_local_set(std::move(s.m_local_set)) {
+    m_routing = s.m_routing;
     pthis.check(m_comm);
   }
 
   ~set_impl() { m_comm.barrier(); }
 
+  /**
+   * @brief Selects the routing used by messages sent from this container,
+   * overriding YGM_COMM_ROUTING
+   */
+  void set_routing(const ygm::routing_type route) { m_routing = route; }
+
+  void set_duplicate_filter(const size_t capacity) {
+    m_sent_filter.resize(capacity);
+  }
+
+  size_t suppressed_inserts() const { return m_suppressed_inserts; }
+
   void async_insert_multi(const key_type &key) {
     auto inserter = [](auto mailbox, auto pset, const key_type &key) {
       pset->m_local_set.insert(key);
     };
     int dest = owner(key);
-    m_comm.async(dest, inserter, pthis, key);
+    m_comm.async(m_routing, dest, inserter, pthis, key);
   }
 
   void async_insert_unique(const key_type &key) {
+    if (already_sent(key)) {
+      return;
+    }
     auto inserter = [](auto mailbox, auto pset, const key_type &key) {
       if (pset->m_local_set.count(key) == 0) {
         pset->m_local_set.insert(key);
       }
     };
     int dest = owner(key);
-    m_comm.async(dest, inserter, pthis, key);
+    m_comm.async(m_routing, dest, inserter, pthis, key);
   }
 
   void async_erase(const key_type &key) {
+    m_sent_filter.erase(key, m_comm.barrier_epoch());
     int  dest          = owner(key);
     auto erase_wrapper = [](auto pcomm, auto pset, const key_type &key) {
       pset->m_local_set.erase(key);
     };
 
-    m_comm.async(dest, erase_wrapper, pthis, key);
+    m_comm.async(m_routing, dest, erase_wrapper, pthis, key);
   }
 
   template <typename Visitor, typename... VisitorArgs>
   void async_insert_exe_if_missing(const key_type &key, Visitor visitor,
                                    const VisitorArgs &...args) {
+    // A repeat finds the key present, so its visitor would not run anyway
+    if (already_sent(key)) {
+      return;
+    }
     auto insert_and_visit = [](auto mailbox, auto pset, const key_type &key,
                                const VisitorArgs &...args) {
       if (pset->m_local_set.count(key) == 0) {
@@ -73,7 +98,7 @@ class set_impl {
       }
     };
     int dest = owner(key);
-    m_comm.async(dest, insert_and_visit, pthis, key,
+    m_comm.async(m_routing, dest, insert_and_visit, pthis, key,
                  std::forward<const VisitorArgs>(args)...);
   }
 
@@ -90,7 +115,7 @@ class set_impl {
       }
     };
     int dest = owner(key);
-    m_comm.async(dest, insert_and_visit, pthis, key,
+    m_comm.async(m_routing, dest, insert_and_visit, pthis, key,
                  std::forward<const VisitorArgs>(args)...);
   }
 
@@ -105,7 +130,7 @@ class set_impl {
       }
     };
     int dest = owner(key);
-    m_comm.async(dest, checker, pthis, key,
+    m_comm.async(m_routing, dest, checker, pthis, key,
                  std::forward<const VisitorArgs>(args)...);
   }
 
@@ -120,7 +145,7 @@ class set_impl {
       }
     };
     int dest = owner(key);
-    m_comm.async(dest, checker, pthis, key,
+    m_comm.async(m_routing, dest, checker, pthis, key,
                  std::forward<const VisitorArgs>(args)...);
   }
 
@@ -187,6 +212,14 @@ class set_impl {
 
   ygm::comm &comm() { return m_comm; }
 
+  // Estimated heap bytes held by this rank's keys and duplicate filter
+  size_t local_memory_bytes() const {
+    return local_container_bytes(m_local_set) + m_sent_filter.memory_bytes();
+  }
+
+  // Name this set is reported under by ygm::memory_report()
+  void set_memory_name(const std::string &name) { m_memory.rename(name); }
+
   template <typename Function>
   void local_for_all(Function fn) {
     if constexpr (std::is_invocable<decltype(fn), const key_type &>()) {
@@ -219,8 +252,24 @@ class set_impl {
   }
   set_impl() = delete;
 
-  std::multiset<key_type, Compare, Alloc> m_local_set;
-  ygm::comm                              &m_comm;
-  typename ygm::ygm_ptr<self_type>        pthis;
+  // Records key as sent this epoch; true if it already was
+  bool already_sent(const key_type &key) {
+    if (m_sent_filter.insert(key, m_comm.barrier_epoch())) {
+      return false;
+    }
+    ++m_suppressed_inserts;
+    return true;
+  }
+
+  LocalSet                         m_local_set;
+  ygm::comm                       &m_comm;
+  typename ygm::ygm_ptr<self_type> pthis;
+  ygm::routing_type                m_routing = ygm::routing_type::DEFAULT;
+  recent_keys_filter<key_type>     m_sent_filter;
+  size_t                           m_suppressed_inserts = 0;
+
+  ygm::detail::memory_tracker m_memory{
+      m_comm.memory_sources(), "set",
+      [this]() { return local_memory_bytes(); }};
 };
 }  // namespace ygm::container::detail
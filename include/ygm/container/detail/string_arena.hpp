@@ -0,0 +1,130 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <string_view>
+#include <vector>
+#include <ygm/container/detail/flat_hash_table.hpp>
+
+namespace ygm::container::detail {
+
+// Hash every string-keyed container uses; equal to std::hash<std::string>, so
+// keys are placed on the same ranks as by hash_partitioner<std::string>
+inline size_t string_hash(const std::string_view s) {
+  return std::hash<std::string_view>{}(s);
+}
+
+/**
+ * @brief Append-only set of interned strings. Characters of all strings sit
+ * back to back in one buffer, and each string costs one offset into it plus
+ * one slot of an open-addressing index holding its precomputed hash.
+ *
+ * Strings get dense ids 0, 1, 2, ... in insertion order, so per-string data
+ * can live in parallel vectors. Lookups take the caller's hash, so a hash
+ * computed by the sender of a message is never recomputed.
+ */
+class string_arena {
+ public:
+  using id_type = size_t;
+
+  static constexpr id_type npos = std::numeric_limits<id_type>::max();
+
+  string_arena() { clear(); }
+
+  // Id of s, or npos
+  id_type find(const std::string_view s, const size_t hash) const {
+    if (m_index.empty()) {
+      return npos;
+    }
+    size_t mask = m_index.size() - 1;
+    for (size_t i = flat_hash::mix(hash) & mask;; i = (i + 1) & mask) {
+      const slot &sl = m_index[i];
+      if (sl.id == npos) {
+        return npos;
+      }
+      if (sl.hash == hash && view(sl.id) == s) {
+        return sl.id;
+      }
+    }
+  }
+
+  /**
+   * @brief Interns s, whose string_hash is hash. Returns its id and whether it
+   * was newly added.
+   */
+  std::pair<id_type, bool> insert(const std::string_view s,
+                                  const size_t           hash) {
+    if ((size() + 1) * 4 > m_index.size() * 3) {
+      grow();
+    }
+    size_t mask = m_index.size() - 1;
+    size_t i    = flat_hash::mix(hash) & mask;
+    for (; m_index[i].id != npos; i = (i + 1) & mask) {
+      if (m_index[i].hash == hash && view(m_index[i].id) == s) {
+        return {m_index[i].id, false};
+      }
+    }
+    const id_type id = size();
+    m_chars.insert(m_chars.end(), s.begin(), s.end());
+    m_offsets.push_back(m_chars.size());
+    m_index[i] = slot{hash, id};
+    return {id, true};
+  }
+
+  std::string_view view(const id_type id) const {
+    return std::string_view(m_chars.data() + m_offsets[id],
+                            m_offsets[id + 1] - m_offsets[id]);
+  }
+
+  size_t size() const { return m_offsets.size() - 1; }
+
+  bool empty() const { return size() == 0; }
+
+  // Heap bytes held by the characters, offsets and index
+  size_t memory_bytes() const {
+    return m_chars.capacity() + m_offsets.capacity() * sizeof(size_t) +
+           m_index.capacity() * sizeof(slot);
+  }
+
+  void clear() {
+    m_chars.clear();
+    m_chars.shrink_to_fit();
+    m_offsets.assign(1, 0);
+    m_offsets.shrink_to_fit();
+    m_index.clear();
+    m_index.shrink_to_fit();
+  }
+
+ private:
+  struct slot {
+    size_t  hash = 0;
+    id_type id   = npos;
+  };
+
+  void grow() {
+    std::vector<slot> old(std::max<size_t>(16, m_index.size() * 2));
+    old.swap(m_index);
+    size_t mask = m_index.size() - 1;
+    for (const slot &sl : old) {
+      if (sl.id != npos) {
+        size_t i = flat_hash::mix(sl.hash) & mask;
+        while (m_index[i].id != npos) {
+          i = (i + 1) & mask;
+        }
+        m_index[i] = sl;
+      }
+    }
+  }
+
+  std::vector<char>   m_chars;
+  std::vector<size_t> m_offsets;  // m_offsets[id] to m_offsets[id + 1]
+  std::vector<slot>   m_index;
+};
+
+}  // namespace ygm::container::detail
@@ -0,0 +1,111 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+#include <ygm/comm.hpp>
+
+namespace ygm::container::detail {
+
+/**
+ * @brief Keeps the k best items pushed into it, where cfn(a, b) is true if a
+ * ranks before b. O(log k) per push.
+ */
+template <typename T, typename Compare>
+class topk_heap {
+ public:
+  topk_heap(const size_t k, Compare cfn) : m_k(k), m_cfn(cfn) {
+    m_heap.reserve(k);
+  }
+
+  void push(const T &item) {
+    if (m_heap.size() < m_k) {
+      m_heap.push_back(item);
+      std::push_heap(m_heap.begin(), m_heap.end(), m_cfn);
+    } else if (m_k > 0 && m_cfn(item, m_heap.front())) {
+      // The front of the heap is the worst kept item
+      std::pop_heap(m_heap.begin(), m_heap.end(), m_cfn);
+      m_heap.back() = item;
+      std::push_heap(m_heap.begin(), m_heap.end(), m_cfn);
+    }
+  }
+
+  bool full() const { return m_heap.size() == m_k; }
+
+  // Worst kept item; only valid when non-empty
+  const T &worst() const { return m_heap.front(); }
+
+  // Kept items, best first
+  std::vector<T> take_sorted() {
+    std::sort_heap(m_heap.begin(), m_heap.end(), m_cfn);
+    return std::move(m_heap);
+  }
+
+ private:
+  size_t         m_k;
+  Compare        m_cfn;
+  std::vector<T> m_heap;
+};
+
+/**
+ * @brief Collective top-k of the items every rank passes to push in
+ * for_each_local(push). Identical on every rank, sorted best first.
+ *
+ * Each rank selects its k best with a bounded heap. The best of the ranks'
+ * k-th items is then shared: at least k items globally are as good as it, so
+ * anything worse is dropped before the sorted candidates are merged pairwise
+ * up the comm::all_reduce tree, keeping k at each step.
+ */
+template <typename T, typename Compare, typename ForEachLocal>
+std::vector<T> distributed_topk(ygm::comm &c, const size_t k, Compare cfn,
+                                ForEachLocal for_each_local) {
+  topk_heap<T, Compare> heap(k, cfn);
+  for_each_local([&heap](const T &item) { heap.push(item); });
+
+  // Threshold: the best k-th item over ranks holding at least k items
+  std::vector<T> threshold;
+  if (heap.full() && k > 0) {
+    threshold.push_back(heap.worst());
+  }
+  threshold = c.all_reduce(
+      threshold, [cfn](const std::vector<T> &a, const std::vector<T> &b) {
+        if (a.empty()) {
+          return b;
+        }
+        if (b.empty()) {
+          return a;
+        }
+        return cfn(b.front(), a.front()) ? b : a;
+      });
+
+  std::vector<T> candidates = heap.take_sorted();
+  if (!threshold.empty()) {
+    const T &t = threshold.front();
+    candidates.erase(
+        std::find_if(candidates.begin(), candidates.end(),
+                     [&cfn, &t](const T &item) { return cfn(t, item); }),
+        candidates.end());
+  }
+
+  return c.all_reduce(
+      candidates, [cfn, k](const std::vector<T> &a, const std::vector<T> &b) {
+        std::vector<T> out;
+        out.reserve(std::min(k, a.size() + b.size()));
+        auto ia = a.begin();
+        auto ib = b.begin();
+        while (out.size() < k && (ia != a.end() || ib != b.end())) {
+          if (ib == b.end() || (ia != a.end() && !cfn(*ib, *ia))) {
+            out.push_back(*ia++);
+          } else {
+            out.push_back(*ib++);
+          }
+        }
+        return out;
+      });
+}
+
+}  // namespace ygm::container::detail
@@ -62,6 +62,13 @@ class disjoint_set {
     return m_impl.get_ygm_ptr();
   }
 
+  // Estimated heap bytes held by this rank's items
+  size_t local_memory_bytes() const { return m_impl.local_memory_bytes(); }
+
+  void set_memory_name(const std::string &name) {
+    m_impl.set_memory_name(name);
+  }
+
  private:
   impl_type m_impl;
 };
@@ -0,0 +1,244 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cereal/archives/json.hpp>
+#include <fstream>
+#include <string>
+#include <ygm/comm.hpp>
+#include <ygm/container/detail/flat_hash_table.hpp>
+#include <ygm/container/detail/hash_partitioner.hpp>
+#include <ygm/container/detail/hyperloglog.hpp>
+#include <ygm/detail/interrupt_mask.hpp>
+#include <ygm/detail/ygm_ptr.hpp>
+#include <ygm/detail/ygm_traits.hpp>
+
+namespace ygm::container {
+
+/**
+ * @brief Approximate count of the distinct items inserted on all ranks. Each
+ * rank keeps one HyperLogLog sketch of 2^precision bytes, so inserts send no
+ * messages; count() merges the sketches with an all_reduce. The relative
+ * standard error is about 1.04 / sqrt(2^precision), under 1% by default.
+ */
+template <typename Item>
+class distinct_counter {
+ public:
+  using self_type  = distinct_counter<Item>;
+  using value_type = Item;
+  using size_type  = size_t;
+
+  distinct_counter(
+      ygm::comm    &comm,
+      const uint8_t precision = detail::hyperloglog::default_precision)
+      : m_sketch(precision), m_comm(comm) {}
+
+  // Local; no message is sent
+  void async_insert(const value_type &item) { m_sketch.add(item); }
+
+  // Collective estimate of the number of distinct items inserted
+  size_type count() { return size_type(global_sketch().estimate() + 0.5); }
+
+  // Collective. The merge of every rank's sketch, identical on all ranks.
+  detail::hyperloglog global_sketch() {
+    m_comm.barrier();
+    return m_comm.all_reduce(
+        m_sketch, [](detail::hyperloglog a, const detail::hyperloglog &b) {
+          a.merge(b);
+          return a;
+        });
+  }
+
+  // Adds the items of another sketch of the same precision on this rank
+  void local_merge(const detail::hyperloglog &sketch) {
+    m_sketch.merge(sketch);
+  }
+
+  const detail::hyperloglog &local_sketch() const { return m_sketch; }
+
+  void clear() {
+    m_comm.barrier();
+    m_sketch.clear();
+  }
+
+  void serialize(const std::string &fname) {
+    m_comm.barrier();
+    std::string   rank_fname = fname + std::to_string(m_comm.rank());
+    std::ofstream os(rank_fname, std::ios::binary);
+    cereal::JSONOutputArchive oarchive(os);
+    oarchive(m_sketch, m_comm.size());
+  }
+
+  void deserialize(const std::string &fname) {
+    m_comm.barrier();
+
+    std::string   rank_fname = fname + std::to_string(m_comm.rank());
+    std::ifstream is(rank_fname, std::ios::binary);
+
+    cereal::JSONInputArchive iarchive(is);
+    int                      comm_size;
+    iarchive(m_sketch, comm_size);
+
+    if (comm_size != m_comm.size()) {
+      m_comm.cerr0(
+          "Attempting to deserialize distinct_counter using communicator of "
+          "different size than serialized with");
+    }
+  }
+
+  size_t local_memory_bytes() const { return m_sketch.memory_bytes(); }
+
+  ygm::comm &comm() { return m_comm; }
+
+ private:
+  detail::hyperloglog m_sketch;
+  ygm::comm          &m_comm;
+
+  ygm::detail::memory_tracker m_memory{
+      m_comm.memory_sources(), "distinct_counter",
+      [this]() { return local_memory_bytes(); }};
+};
+
+/**
+ * @brief Approximate count of the distinct items inserted under each key.
+ * Each key's HyperLogLog sketch lives on the key's owner, and an insert sends
+ * the owner the key and the item's hash. A key costs 2^precision bytes.
+ */
+template <typename Key, typename Item,
+          typename Partitioner = detail::hash_partitioner<Key>>
+class keyed_distinct_counter {
+ public:
+  using self_type         = keyed_distinct_counter<Key, Item, Partitioner>;
+  using ptr_type          = typename ygm::ygm_ptr<self_type>;
+  using key_type          = Key;
+  using value_type        = Item;
+  using size_type         = size_t;
+  using ygm_for_all_types = std::tuple<Key, size_t>;
+
+  static constexpr uint8_t default_precision = 10;
+
+  Partitioner partitioner;
+
+  keyed_distinct_counter() = delete;
+
+  keyed_distinct_counter(ygm::comm    &comm,
+                         const uint8_t precision = default_precision)
+      : m_precision(precision), m_comm(comm), pthis(this) {
+    pthis.check(m_comm);
+  }
+
+  ~keyed_distinct_counter() { m_comm.barrier(); }
+
+  void set_routing(const ygm::routing_type route) { m_routing = route; }
+
+  void async_insert(const key_type &key, const value_type &item) {
+    auto inserter = [](auto pcounter, const key_type &key,
+                       const uint64_t hash) {
+      pcounter->local_sketch(key).add_hash(hash);
+    };
+    m_comm.async(m_routing, owner(key), inserter, pthis, key,
+                 uint64_t(detail::sketch_hash(item)));
+  }
+
+  // Calls fn(key, estimate) for each key on this rank
+  template <typename Function>
+  void for_all(Function fn) {
+    m_comm.barrier();
+    for (const auto &kv : m_local_sketches) {
+      fn(kv.first, size_type(kv.second.estimate() + 0.5));
+    }
+  }
+
+  // Collective estimate of the distinct items inserted under key
+  size_type count(const key_type &key) {
+    m_comm.barrier();
+    auto itr = m_local_sketches.find(key);
+    return m_comm.all_reduce_sum(itr == m_local_sketches.end()
+                                     ? size_type(0)
+                                     : size_type(itr->second.estimate() + 0.5));
+  }
+
+  // Number of keys
+  size_type size() {
+    m_comm.barrier();
+    return m_comm.all_reduce_sum(m_local_sketches.size());
+  }
+
+  size_type local_size() const { return m_local_sketches.size(); }
+
+  void clear() {
+    m_comm.barrier();
+    m_local_sketches.clear();
+  }
+
+  void serialize(const std::string &fname) {
+    m_comm.barrier();
+    std::string   rank_fname = fname + std::to_string(m_comm.rank());
+    std::ofstream os(rank_fname, std::ios::binary);
+    cereal::JSONOutputArchive oarchive(os);
+    oarchive(m_local_sketches, m_precision, m_comm.size());
+  }
+
+  void deserialize(const std::string &fname) {
+    m_comm.barrier();
+
+    std::string   rank_fname = fname + std::to_string(m_comm.rank());
+    std::ifstream is(rank_fname, std::ios::binary);
+
+    cereal::JSONInputArchive iarchive(is);
+    int                      comm_size;
+    iarchive(m_local_sketches, m_precision, comm_size);
+
+    if (comm_size != m_comm.size()) {
+      m_comm.cerr0(
+          "Attempting to deserialize keyed_distinct_counter using "
+          "communicator of different size than serialized with");
+    }
+  }
+
+  int owner(const key_type &key) const {
+    auto [owner, rank] = partitioner(key, m_comm.size(), 1024);
+    return owner;
+  }
+
+  bool is_mine(const key_type &key) const {
+    return owner(key) == m_comm.rank();
+  }
+
+  size_t local_memory_bytes() const {
+    size_t bytes = m_local_sketches.memory_bytes();
+    for (const auto &kv : m_local_sketches) {
+      bytes += kv.second.memory_bytes();
+    }
+    return bytes;
+  }
+
+  typename ygm::ygm_ptr<self_type> get_ygm_ptr() const { return pthis; }
+
+  ygm::comm &comm() { return m_comm; }
+
+ private:
+  detail::hyperloglog &local_sketch(const key_type &key) {
+    auto itr = m_local_sketches.find(key);
+    if (itr == m_local_sketches.end()) {
+      itr = m_local_sketches.emplace(key, detail::hyperloglog(m_precision))
+                .first;
+    }
+    return itr->second;
+  }
+
+  uint8_t                                              m_precision;
+  detail::flat_hash_map<key_type, detail::hyperloglog> m_local_sketches;
+  ygm::comm                                           &m_comm;
+  ptr_type                                             pthis;
+  ygm::routing_type m_routing = ygm::routing_type::DEFAULT;
+
+  ygm::detail::memory_tracker m_memory{
+      m_comm.memory_sources(), "keyed_distinct_counter",
+      [this]() { return local_memory_bytes(); }};
+};
+
+}  // namespace ygm::container
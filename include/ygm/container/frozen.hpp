@@ -0,0 +1,331 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include <ygm/comm.hpp>
+#include <ygm/container/detail/eytzinger_index.hpp>
+#include <ygm/container/detail/hash_partitioner.hpp>
+#include <ygm/detail/interrupt_mask.hpp>
+#include <ygm/detail/ygm_ptr.hpp>
+#include <ygm/detail/ygm_traits.hpp>
+
+namespace ygm::container {
+
+/**
+ * @brief Immutable distributed map built by map::freeze(). Each rank's
+ * entries live in two flat arrays, keys in Eytzinger order and values in
+ * matching slots, so an entry costs only its key and value and a lookup walks
+ * one contiguous array. Keys stay on the ranks they were on.
+ */
+template <typename Key, typename Value,
+          typename Partitioner = detail::hash_partitioner<Key>,
+          typename Compare     = std::less<Key>>
+class frozen_map {
+ public:
+  using self_type         = frozen_map<Key, Value, Partitioner, Compare>;
+  using ptr_type          = typename ygm::ygm_ptr<self_type>;
+  using mapped_type       = Value;
+  using key_type          = Key;
+  using size_type         = size_t;
+  using ygm_for_all_types = std::tuple<Key, Value>;
+  using partitioner_type  = Partitioner;
+
+  Partitioner partitioner;
+
+  frozen_map() = delete;
+
+  /**
+   * @brief Collective. Moves every entry out of source, which is left empty.
+   * source must place keys with the same Partitioner.
+   */
+  template <typename Source>
+  frozen_map(Source &source) : m_comm(source.comm()), pthis(this) {
+    pthis.check(m_comm);
+
+    std::vector<std::pair<key_type, mapped_type>> entries;
+    source.for_all([&entries](const key_type &key, mapped_type &value) {
+      entries.emplace_back(key, std::move(value));
+    });
+    source.clear();
+    std::sort(entries.begin(), entries.end(),
+              [](const auto &a, const auto &b) {
+                return Compare{}(a.first, b.first);
+              });
+
+    std::vector<key_type> keys;
+    keys.reserve(entries.size());
+    for (auto &kv : entries) {
+      keys.push_back(std::move(kv.first));
+    }
+    auto order = m_index.build(std::move(keys));
+    m_values.reserve(order.size());
+    for (size_t from : order) {
+      m_values.push_back(std::move(entries[from].second));
+    }
+  }
+
+  frozen_map(const self_type &rhs) = delete;
+
+  ~frozen_map() { m_comm.barrier(); }
+
+  /**
+   * @brief Calls visitor(key, const value&, args...), or visitor(pmap, key,
+   * const value&, args...), on the owner of key if it is present
+   */
+  template <typename Visitor, typename... VisitorArgs>
+  void async_visit_if_exists(const key_type &key, Visitor visitor,
+                             const VisitorArgs &...args) {
+    auto visit_wrapper = [](auto pmap, const key_type &key,
+                            const VisitorArgs &...args) {
+      size_t slot = pmap->m_index.find(key);
+      if (slot != detail::eytzinger_index<key_type, Compare>::npos) {
+        Visitor *vis = nullptr;
+        pmap->local_visit(slot, *vis, args...);
+      }
+    };
+    m_comm.async(owner(key), visit_wrapper, pthis, key,
+                 std::forward<const VisitorArgs>(args)...);
+  }
+
+  /**
+   * @brief Calls fn(key, const value&) for each local entry in key order
+   */
+  template <typename Function>
+  void for_all(Function fn) {
+    m_comm.barrier();
+    local_for_all(fn);
+  }
+
+  template <typename Function>
+  void local_for_all(Function fn) const {
+    if constexpr (std::is_invocable<decltype(fn), const key_type &,
+                                    const mapped_type &>()) {
+      m_index.for_each_in_order([this, &fn](const size_t slot) {
+        fn(m_index.key(slot), m_values[slot]);
+      });
+    } else {
+      static_assert(ygm::detail::always_false<>,
+                    "local frozen_map lambda signature must be invocable "
+                    "with (const &key_type, const mapped_type&) signature");
+    }
+  }
+
+  // Value stored under key on this rank, or nullptr
+  const mapped_type *local_find(const key_type &key) const {
+    size_t slot = m_index.find(key);
+    return slot == detail::eytzinger_index<key_type, Compare>::npos
+               ? nullptr
+               : &m_values[slot];
+  }
+
+  std::vector<mapped_type> local_get(const key_type &key) const {
+    const mapped_type *value = local_find(key);
+    return value ? std::vector<mapped_type>{*value}
+                 : std::vector<mapped_type>{};
+  }
+
+  size_type size() {
+    m_comm.barrier();
+    return m_comm.all_reduce_sum(m_index.size());
+  }
+
+  size_t count(const key_type &key) {
+    m_comm.barrier();
+    return m_comm.all_reduce_sum(size_t(local_find(key) != nullptr));
+  }
+
+  size_type local_size() const { return m_index.size(); }
+
+  int owner(const key_type &key) const {
+    auto [owner, rank] = partitioner(key, m_comm.size(), 1024);
+    return owner;
+  }
+
+  bool is_mine(const key_type &key) const {
+    return owner(key) == m_comm.rank();
+  }
+
+  typename ygm::ygm_ptr<self_type> get_ygm_ptr() const { return pthis; }
+
+  ygm::comm &comm() { return m_comm; }
+
+  // Heap bytes held by this rank's keys and values
+  size_t local_memory_bytes() const {
+    return m_index.memory_bytes() + m_values.capacity() * sizeof(mapped_type);
+  }
+
+ private:
+  template <typename Function, typename... VisitorArgs>
+  void local_visit(const size_t slot, Function &fn,
+                   const VisitorArgs &...args) {
+    ygm::detail::interrupt_mask mask(m_comm);
+
+    if constexpr (std::is_invocable<decltype(fn), const key_type &,
+                                    const mapped_type &, VisitorArgs &...>() ||
+                  std::is_invocable<decltype(fn), ptr_type, const key_type &,
+                                    const mapped_type &, VisitorArgs &...>()) {
+      ygm::meta::apply_optional(
+          fn, std::make_tuple(pthis),
+          std::forward_as_tuple(m_index.key(slot), m_values[slot], args...));
+    } else {
+      static_assert(ygm::detail::always_false<>,
+                    "remote frozen_map lambda signature must be invocable "
+                    "with (const &key_type, const mapped_type&, ...) or "
+                    "(ptr_type, const &key_type, const mapped_type&, ...) "
+                    "signatures");
+    }
+  }
+
+  detail::eytzinger_index<key_type, Compare> m_index;
+  std::vector<mapped_type>                   m_values;
+  ygm::comm                                 &m_comm;
+  ptr_type                                   pthis;
+
+  ygm::detail::memory_tracker m_memory{
+      m_comm.memory_sources(), "frozen_map",
+      [this]() { return local_memory_bytes(); }};
+};
+
+/**
+ * @brief Immutable distributed set built by set::freeze(), holding each
+ * rank's keys in one Eytzinger-ordered array
+ */
+template <typename Key, typename Partitioner = detail::hash_partitioner<Key>,
+          typename Compare = std::less<Key>>
+class frozen_set {
+ public:
+  using self_type         = frozen_set<Key, Partitioner, Compare>;
+  using ptr_type          = typename ygm::ygm_ptr<self_type>;
+  using key_type          = Key;
+  using size_type         = size_t;
+  using ygm_for_all_types = std::tuple<Key>;
+  using partitioner_type  = Partitioner;
+
+  Partitioner partitioner;
+
+  frozen_set() = delete;
+
+  /**
+   * @brief Collective. Moves every key out of source, which is left empty.
+   * source must place keys with the same Partitioner.
+   */
+  template <typename Source>
+  frozen_set(Source &source) : m_comm(source.comm()), pthis(this) {
+    pthis.check(m_comm);
+
+    std::vector<key_type> keys;
+    source.for_all([&keys](const key_type &key) { keys.push_back(key); });
+    source.clear();
+    std::sort(keys.begin(), keys.end(), Compare{});
+    m_index.build(std::move(keys));
+  }
+
+  frozen_set(const self_type &rhs) = delete;
+
+  ~frozen_set() { m_comm.barrier(); }
+
+  /**
+   * @brief Calls visitor(key, args...) on the owner of key if it is present
+   */
+  template <typename Visitor, typename... VisitorArgs>
+  void async_exe_if_contains(const key_type &key, Visitor visitor,
+                             const VisitorArgs &...args) {
+    auto checker = [](auto pset, const key_type &key,
+                      const VisitorArgs &...args) {
+      if (pset->local_contains(key)) {
+        Visitor *vis = nullptr;
+        std::apply(*vis, std::forward_as_tuple(key, args...));
+      }
+    };
+    m_comm.async(owner(key), checker, pthis, key,
+                 std::forward<const VisitorArgs>(args)...);
+  }
+
+  /**
+   * @brief Calls visitor(key, args...) on the owner of key if it is absent
+   */
+  template <typename Visitor, typename... VisitorArgs>
+  void async_exe_if_missing(const key_type &key, Visitor visitor,
+                            const VisitorArgs &...args) {
+    auto checker = [](auto pset, const key_type &key,
+                      const VisitorArgs &...args) {
+      if (!pset->local_contains(key)) {
+        Visitor *vis = nullptr;
+        std::apply(*vis, std::forward_as_tuple(key, args...));
+      }
+    };
+    m_comm.async(owner(key), checker, pthis, key,
+                 std::forward<const VisitorArgs>(args)...);
+  }
+
+  /**
+   * @brief Calls fn(key) for each local key in order
+   */
+  template <typename Function>
+  void for_all(Function fn) {
+    m_comm.barrier();
+    local_for_all(fn);
+  }
+
+  template <typename Function>
+  void local_for_all(Function fn) const {
+    if constexpr (std::is_invocable<decltype(fn), const key_type &>()) {
+      m_index.for_each_in_order(
+          [this, &fn](const size_t slot) { fn(m_index.key(slot)); });
+    } else {
+      static_assert(ygm::detail::always_false<>,
+                    "local frozen_set lambda signature must be invocable with "
+                    "(const key_type &) signature");
+    }
+  }
+
+  bool local_contains(const key_type &key) const {
+    return m_index.find(key) !=
+           detail::eytzinger_index<key_type, Compare>::npos;
+  }
+
+  size_type size() {
+    m_comm.barrier();
+    return m_comm.all_reduce_sum(m_index.size());
+  }
+
+  size_t count(const key_type &key) {
+    m_comm.barrier();
+    return m_comm.all_reduce_sum(size_t(local_contains(key)));
+  }
+
+  size_type local_size() const { return m_index.size(); }
+
+  int owner(const key_type &key) const {
+    auto [owner, rank] = partitioner(key, m_comm.size(), 1024);
+    return owner;
+  }
+
+  bool is_mine(const key_type &key) const {
+    return owner(key) == m_comm.rank();
+  }
+
+  typename ygm::ygm_ptr<self_type> get_ygm_ptr() const { return pthis; }
+
+  ygm::comm &comm() { return m_comm; }
+
+  // Heap bytes held by this rank's keys
+  size_t local_memory_bytes() const { return m_index.memory_bytes(); }
+
+ private:
+  detail::eytzinger_index<key_type, Compare> m_index;
+  ygm::comm                                 &m_comm;
+  ptr_type                                   pthis;
+
+  ygm::detail::memory_tracker m_memory{
+      m_comm.memory_sources(), "frozen_set",
+      [this]() { return local_memory_bytes(); }};
+};
+
+}  // namespace ygm::container
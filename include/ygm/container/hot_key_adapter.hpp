@@ -0,0 +1,270 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <ygm/comm.hpp>
+#include <ygm/container/detail/heavy_hitters.hpp>
+#include <ygm/container/read_cache.hpp>
+
+namespace ygm::container {
+
+/**
+ * @brief Per-rank operations counts gathered by hot_key_adapter::load_stats()
+ */
+struct hot_key_load_stats {
+  // Operations each rank would serve if every one went to the key's owner
+  std::vector<size_t> direct_load;
+  // Operations each rank actually served
+  std::vector<size_t> actual_load;
+  size_t              num_hot_keys = 0;
+
+  static double imbalance(const std::vector<size_t> &load) {
+    size_t total = 0;
+    size_t most  = 0;
+    for (size_t l : load) {
+      total += l;
+      most = std::max(most, l);
+    }
+    return total == 0 ? 1.0 : double(most) * load.size() / total;
+  }
+
+  double direct_imbalance() const { return imbalance(direct_load); }
+  double actual_imbalance() const { return imbalance(actual_load); }
+};
+
+/**
+ * @brief Front end for a map that spreads the load of heavily skewed keys.
+ *
+ * Every key passing through async_reduce() and async_visit_if_exists() feeds a
+ * per-rank heavy hitter sketch. At sync(), keys making up at least
+ * hot_fraction of all traffic, along with some keys just below it, become hot
+ * on every rank until the next sync():
+ * reductions into hot keys are combined locally and then across ranks in a
+ * tree, so their owner applies one value per sync(), and reads of hot keys
+ * are served from replicas fetched at sync(). Reads of other keys go through
+ * a read_cache. Local combinations still pending at an ordinary barrier()
+ * are sent straight to their owners, so the container is always up to date
+ * after a barrier.
+ *
+ * Keys must be ordered with operator<. Replicas and cached reads reflect the
+ * container as of the last sync() or barrier().
+ */
+template <typename Container, typename ReductionOp>
+class hot_key_adapter {
+ public:
+  using self_type   = hot_key_adapter<Container, ReductionOp>;
+  using key_type    = typename Container::key_type;
+  using mapped_type = typename Container::mapped_type;
+
+  static constexpr double default_hot_fraction = 0.01;
+
+  hot_key_adapter(Container &c, ReductionOp reducer,
+                  const double hot_fraction = default_hot_fraction)
+      : m_container(c),
+        m_reducer(reducer),
+        m_hot_fraction(hot_fraction),
+        m_sketch(size_t(2.0 / hot_fraction) + 1),
+        m_reads(c),
+        m_direct_load(c.comm().size(), 0),
+        m_actual_load(c.comm().size(), 0) {}
+
+  hot_key_adapter(const self_type &rhs) = delete;
+
+  ~hot_key_adapter() {
+    flush_hot_partials();
+    comm().barrier();
+  }
+
+  void async_reduce(const key_type &key, const mapped_type &value) {
+    const int dest = m_container.owner(key);
+    m_sketch.insert(key);
+    ++m_direct_load[dest];
+
+    if (m_hot.count(key)) {
+      if (m_partials.empty()) {
+        comm().register_pre_barrier_callback(
+            [this]() { this->send_hot_partials(); });
+      }
+      auto [itr, inserted] = m_partials.try_emplace(key, value);
+      if (!inserted) {
+        itr->second = m_reducer(itr->second, value);
+      }
+    } else {
+      ++m_actual_load[dest];
+      m_container.async_reduce(key, value, m_reducer);
+    }
+  }
+
+  /**
+   * @brief Calls visitor(key, const value&, args...), or visitor(pcache, key,
+   * const value&, args...) with pcache pointing to the underlying read_cache,
+   * on this rank if key is present
+   */
+  template <typename Visitor, typename... VisitorArgs>
+  void async_visit_if_exists(const key_type &key, Visitor visitor,
+                             const VisitorArgs &...args) {
+    const int dest = m_container.owner(key);
+    m_sketch.insert(key);
+    ++m_direct_load[dest];
+
+    auto itr = m_replicas.find(key);
+    if (itr != m_replicas.end()) {
+      m_reads.visit_value(key, itr->second, visitor, args...);
+    } else {
+      size_t fetches = m_reads.fetches();
+      m_reads.async_visit_if_exists(key, visitor, args...);
+      if (dest == comm().rank() || m_reads.fetches() != fetches) {
+        ++m_actual_load[dest];
+      }
+    }
+  }
+
+  /**
+   * @brief Collective. Applies the combined reductions of hot keys, picks the
+   * hot keys for the next epoch from the traffic since the last sync(), and
+   * replicates their values to every rank.
+   */
+  void sync() {
+    flush_hot_partials();
+    comm().barrier();
+
+    auto hot = m_sketch.global_heavy(comm(), m_hot_fraction);
+    m_sketch.clear();
+    m_hot = std::unordered_set<key_type>(hot.begin(), hot.end());
+
+    std::vector<std::pair<key_type, mapped_type>> owned;
+    for (const auto &key : hot) {
+      if (m_container.is_mine(key)) {
+        for (const auto &value : m_container.local_get(key)) {
+          owned.emplace_back(key, value);
+        }
+      }
+    }
+    auto replicas = comm().all_reduce(
+        owned, [](const std::vector<std::pair<key_type, mapped_type>> &a,
+                  const std::vector<std::pair<key_type, mapped_type>> &b) {
+          std::vector<std::pair<key_type, mapped_type>> out(a);
+          out.insert(out.end(), b.begin(), b.end());
+          return out;
+        });
+    m_replicas = std::unordered_map<key_type, mapped_type>(replicas.begin(),
+                                                           replicas.end());
+  }
+
+  /**
+   * @brief Collective per-rank load since construction
+   */
+  hot_key_load_stats load_stats() {
+    auto sum = [](const std::vector<size_t> &a, const std::vector<size_t> &b) {
+      std::vector<size_t> out(a);
+      for (size_t i = 0; i < out.size(); ++i) {
+        out[i] += b[i];
+      }
+      return out;
+    };
+    hot_key_load_stats stats;
+    stats.direct_load  = comm().all_reduce(m_direct_load, sum);
+    stats.actual_load  = comm().all_reduce(m_actual_load, sum);
+    stats.num_hot_keys = m_hot.size();
+    return stats;
+  }
+
+  bool is_hot(const key_type &key) const { return m_hot.count(key); }
+
+  size_t num_hot_keys() const { return m_hot.size(); }
+
+  ygm::comm &comm() { return m_container.comm(); }
+
+  // Estimated heap bytes held by this rank's sketch, hot keys, partial
+  // reductions and replicas; the read cache reports itself
+  size_t local_memory_bytes() const {
+    return m_sketch.memory_bytes() + detail::local_container_bytes(m_hot) +
+           detail::local_container_bytes(m_partials) +
+           detail::local_container_bytes(m_replicas) +
+           detail::local_container_bytes(m_direct_load) +
+           detail::local_container_bytes(m_actual_load);
+  }
+
+ private:
+  // Sends each partial reduction of a hot key straight to its owner, for
+  // barriers outside of sync()
+  void send_hot_partials() {
+    auto partials = std::move(m_partials);
+    m_partials.clear();
+    for (const auto &kv : partials) {
+      ++m_actual_load[m_container.owner(kv.first)];
+      m_container.async_reduce(kv.first, kv.second, m_reducer);
+    }
+  }
+
+  // Combines the partial reductions of hot keys up a tree of ranks, then each
+  // owner applies its keys' totals
+  void flush_hot_partials() {
+    using row_type = std::pair<key_type, mapped_type>;
+    std::vector<row_type> partials(m_partials.begin(), m_partials.end());
+    m_partials.clear();
+    std::sort(partials.begin(), partials.end(),
+              [](const row_type &a, const row_type &b) {
+                return a.first < b.first;
+              });
+
+    auto combine = [this](const std::vector<row_type> &a,
+                          const std::vector<row_type> &b) {
+      std::vector<row_type> out;
+      out.reserve(a.size() + b.size());
+      auto ia = a.begin();
+      auto ib = b.begin();
+      while (ia != a.end() || ib != b.end()) {
+        if (ib == b.end() || (ia != a.end() && ia->first < ib->first)) {
+          out.push_back(*ia++);
+        } else if (ia == a.end() || ib->first < ia->first) {
+          out.push_back(*ib++);
+        } else {
+          out.emplace_back(ia->first, m_reducer(ia->second, ib->second));
+          ++ia;
+          ++ib;
+        }
+      }
+      return out;
+    };
+    for (const auto &kv : comm().all_reduce(partials, combine)) {
+      if (m_container.is_mine(kv.first)) {
+        ++m_actual_load[comm().rank()];
+        m_container.async_reduce(kv.first, kv.second, m_reducer);
+      }
+    }
+  }
+
+  Container  &m_container;
+  ReductionOp m_reducer;
+  double      m_hot_fraction;
+
+  detail::heavy_hitters<key_type>           m_sketch;
+  std::unordered_set<key_type>              m_hot;
+  std::unordered_map<key_type, mapped_type> m_partials;
+  std::unordered_map<key_type, mapped_type> m_replicas;
+  read_cache<Container>                     m_reads;
+
+  std::vector<size_t> m_direct_load;
+  std::vector<size_t> m_actual_load;
+
+  ygm::detail::memory_tracker m_memory{
+      m_container.comm().memory_sources(), "hot_key_adapter",
+      [this]() { return local_memory_bytes(); }};
+};
+
+template <typename Container, typename ReductionOp>
+hot_key_adapter<Container, ReductionOp> make_hot_key_adapter(
+    Container &c, ReductionOp reducer,
+    const double hot_fraction =
+        hot_key_adapter<Container, ReductionOp>::default_hot_fraction) {
+  return hot_key_adapter<Container, ReductionOp>(c, reducer, hot_fraction);
+}
+
+}  // namespace ygm::container
@@ -0,0 +1,62 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <ygm/container/detail/hash_join.hpp>
+
+namespace ygm::container {
+
+/**
+ * @brief Collective inner join of two containers on their keys.
+ *
+ * Inputs are maps, multimaps, bags of std::pairs, or anything else whose
+ * ygm_for_all_types is (key, value). fn(key, left_value, right_value) is called
+ * on the rank owning key for every pair of matching rows, and may async into
+ * other containers; all of its messages are delivered when the call returns.
+ *
+ * @param use_bloom_filter Drop rows of the input being moved (the larger one
+ * when both move) whose keys fail a Bloom filter of the other input's keys
+ */
+template <typename Left, typename Right, typename Function>
+void inner_join(Left &left, Right &right, Function fn,
+                const bool use_bloom_filter = false) {
+  detail::hash_join<detail::join_kind::inner>(left, right, fn,
+                                              use_bloom_filter);
+}
+
+/**
+ * @brief Collective left outer join of two containers on their keys.
+ *
+ * fn(key, left_value, std::optional<right_value>) is called for every matching
+ * pair of rows, and once with an empty optional for each left row without a
+ * match.
+ *
+ * @param use_bloom_filter Drop right rows whose keys fail a Bloom filter of
+ * the left keys before moving them; no effect when right is not moved
+ */
+template <typename Left, typename Right, typename Function>
+void left_join(Left &left, Right &right, Function fn,
+               const bool use_bloom_filter = false) {
+  detail::hash_join<detail::join_kind::left>(left, right, fn,
+                                             use_bloom_filter);
+}
+
+/**
+ * @brief Collective semi join: fn(key, left_value), or fn(key) for key-only
+ * left inputs such as sets, is called once for each left row whose key is
+ * present in right. Either input may be key-only.
+ *
+ * @param use_bloom_filter Drop rows of the input being moved (the larger one
+ * when both move) whose keys fail a Bloom filter of the other input's keys
+ */
+template <typename Left, typename Right, typename Function>
+void semi_join(Left &left, Right &right, Function fn,
+               const bool use_bloom_filter = false) {
+  detail::hash_join<detail::join_kind::semi>(left, right, fn,
+                                             use_bloom_filter);
+}
+
+}  // namespace ygm::container
@@ -5,7 +5,10 @@
 
 #pragma once
 
+#include <ygm/container/detail/flat_hash_table.hpp>
+#include <ygm/container/detail/grouped_multimap_impl.hpp>
 #include <ygm/container/detail/map_impl.hpp>
+#include <ygm/container/frozen.hpp>
 #include <ygm/container/container_traits.hpp>
 
 namespace ygm::container {
@@ -13,17 +16,19 @@ namespace ygm::container {
 template <typename Key, typename Value,
           typename Partitioner = detail::hash_partitioner<Key>,
           typename Compare     = std::less<Key>,
-          class Alloc          = std::allocator<std::pair<const Key, Value>>>
+          class Alloc = detail::pool_allocator<std::pair<const Key, Value>>,
+          class LocalMap       = std::multimap<Key, Value, Compare, Alloc>>
 class map {
  public:
-  using self_type           = map<Key, Value, Partitioner, Compare, Alloc>;
+  using self_type = map<Key, Value, Partitioner, Compare, Alloc, LocalMap>;
   using mapped_type         = Value;
   using key_type            = Key;
   using size_type           = size_t;
   using ygm_for_all_types   = std::tuple< Key, Value >;
   using ygm_container_type  = ygm::container::map_tag;
-  using impl_type =
-      detail::map_impl<key_type, mapped_type, Partitioner, Compare, Alloc>;
+  using partitioner_type    = Partitioner;
+  using impl_type = detail::map_impl<key_type, mapped_type, Partitioner,
+                                     Compare, Alloc, LocalMap>;
 
   map() = delete;
 
@@ -31,6 +36,16 @@ class map {
 
   map(ygm::comm& comm, const mapped_type& dv) : m_impl(comm, dv) {}
 
+  map(ygm::comm& comm, const ygm::routing_type route) : m_impl(comm) {
+    m_impl.set_routing(route);
+  }
+
+  /**
+   * @brief Selects the routing used by messages sent from this map, overriding
+   * YGM_COMM_ROUTING
+   */
+  void set_routing(const ygm::routing_type route) { m_impl.set_routing(route); }
+
   map(const self_type& rhs) : m_impl(rhs.m_impl) {}
 
   void async_insert(const std::pair<key_type, mapped_type>& kv) {
@@ -90,6 +105,14 @@ class map {
 
   void clear() { m_impl.clear(); }
 
+  /**
+   * @brief Collective. Moves every entry into an immutable, read-optimized
+   * frozen_map and leaves this map empty.
+   */
+  frozen_map<Key, Value, Partitioner, Compare> freeze() {
+    return frozen_map<Key, Value, Partitioner, Compare>(*this);
+  }
+
   size_type size() { return m_impl.size(); }
 
   size_t count(const key_type& key) { return m_impl.count(key); }
@@ -124,8 +147,50 @@ class map {
     return to_return;
   }
 
+  /**
+   * @brief Collective. Inserts every (key, value) pair of input, e.g. a
+   * bag<std::pair<Key, Value>>, combining values that share a key, including
+   * one already stored, with reducer. Pairs are shuffled to their owners in
+   * large batches rather than one message each.
+   */
+  template <typename Container, typename ReductionOp>
+  void bulk_load(Container& input, ReductionOp reducer) {
+    m_impl.bulk_load(input, reducer);
+  }
+
+  /**
+   * @brief Collective lookup calling fn(key, value) on this rank for each
+   * requested key present in the map. Repeated keys are fetched once, with
+   * one batched request and reply per pair of ranks.
+   */
+  template <typename KeyRange, typename Function>
+  void bulk_lookup(const KeyRange& keys, Function fn) {
+    detail::bulk_lookup(m_impl, keys, fn);
+  }
+
+  /**
+   * @brief Collective bulk_lookup collecting the found entries
+   */
+  template <typename KeyRange>
+  detail::flat_hash_map<key_type, mapped_type> bulk_get(const KeyRange& keys) {
+    detail::flat_hash_map<key_type, mapped_type> to_return;
+    bulk_lookup(keys, [&to_return](const key_type& key,
+                                   const mapped_type& value) {
+      to_return[key] = value;
+    });
+    return to_return;
+  }
+
   ygm::comm& comm() { return m_impl.comm(); }
 
+  // Estimated heap bytes held by this rank's entries
+  size_t local_memory_bytes() const { return m_impl.local_memory_bytes(); }
+
+  // Name this container is reported under by ygm::memory_report()
+  void set_memory_name(const std::string& name) {
+    m_impl.set_memory_name(name);
+  }
+
   template <typename CompareFunction>
   std::vector<std::pair<key_type, mapped_type>> topk(size_t          k,
                                                     CompareFunction cfn) {
@@ -141,22 +206,39 @@ class map {
 template <typename Key, typename Value,
           typename Partitioner = detail::hash_partitioner<Key>,
           typename Compare     = std::less<Key>,
-          class Alloc          = std::allocator<std::pair<const Key, Value>>>
+          class Alloc = detail::pool_allocator<std::pair<const Key, Value>>>
 class multimap {
  public:
-  using self_type     = multimap<Key, Value, Partitioner, Compare, Alloc>;
-  using mapped_type   = Value;
-  using key_type      = Key;
-  using size_type     = size_t;
+  using self_type         = multimap<Key, Value, Partitioner, Compare, Alloc>;
+  using mapped_type       = Value;
+  using key_type          = Key;
+  using size_type         = size_t;
+  using ygm_for_all_types = std::tuple<Key, Value>;
+  using partitioner_type  = Partitioner;
   using impl_type =
       detail::map_impl<key_type, mapped_type, Partitioner, Compare, Alloc>;
   multimap() = delete;
 
-  multimap(ygm::comm& comm) : m_impl(comm) {}
+  multimap(ygm::comm& comm) : m_impl(comm) { set_memory_name("multimap"); }
+
+  multimap(ygm::comm& comm, const mapped_type& dv) : m_impl(comm, dv) {
+    set_memory_name("multimap");
+  }
+
+  multimap(ygm::comm& comm, const ygm::routing_type route) : m_impl(comm) {
+    set_memory_name("multimap");
+    m_impl.set_routing(route);
+  }
 
-  multimap(ygm::comm& comm, const mapped_type& dv) : m_impl(comm, dv) {}
+  /**
+   * @brief Selects the routing used by messages sent from this multimap,
+   * overriding YGM_COMM_ROUTING
+   */
+  void set_routing(const ygm::routing_type route) { m_impl.set_routing(route); }
 
-  multimap(const self_type& rhs) : m_impl(rhs.m_impl) {}
+  multimap(const self_type& rhs) : m_impl(rhs.m_impl) {
+    set_memory_name("multimap");
+  }
 
   void async_insert(const std::pair<key_type, mapped_type>& kv) {
     async_insert(kv.first, kv.second);
@@ -231,8 +313,26 @@ class multimap {
     return to_return;
   }
 
+  /**
+   * @brief Collective lookup calling fn(key, value) on this rank for each
+   * value stored under the requested keys. Repeated keys are fetched once,
+   * with one batched request and reply per pair of ranks.
+   */
+  template <typename KeyRange, typename Function>
+  void bulk_lookup(const KeyRange& keys, Function fn) {
+    detail::bulk_lookup(m_impl, keys, fn);
+  }
+
   ygm::comm& comm() { return m_impl.comm(); }
 
+  // Estimated heap bytes held by this rank's entries
+  size_t local_memory_bytes() const { return m_impl.local_memory_bytes(); }
+
+  // Name this container is reported under by ygm::memory_report()
+  void set_memory_name(const std::string& name) {
+    m_impl.set_memory_name(name);
+  }
+
   template <typename CompareFunction>
   std::vector<std::pair<key_type, mapped_type>> topk(size_t          k,
                                                     CompareFunction cfn) {
@@ -245,4 +345,160 @@ class multimap {
   impl_type m_impl;
 };
 
+/**
+ * @brief Multimap storing the values of each key contiguously. Visitors of a
+ * group receive a span over the values instead of an iterator range, and
+ * local_get returns a view instead of a copy.
+ */
+template <typename Key, typename Value,
+          typename Partitioner = detail::hash_partitioner<Key>,
+          typename Hash        = std::hash<Key>>
+class grouped_multimap {
+ public:
+  using self_type         = grouped_multimap<Key, Value, Partitioner, Hash>;
+  using mapped_type       = Value;
+  using key_type          = Key;
+  using size_type         = size_t;
+  using ygm_for_all_types = std::tuple<Key, Value>;
+  using partitioner_type  = Partitioner;
+  using impl_type =
+      detail::grouped_multimap_impl<key_type, mapped_type, Partitioner, Hash>;
+  using group_type       = typename impl_type::group_type;
+  using const_group_type = typename impl_type::const_group_type;
+
+  grouped_multimap() = delete;
+
+  grouped_multimap(ygm::comm& comm) : m_impl(comm) {}
+
+  grouped_multimap(ygm::comm& comm, const ygm::routing_type route)
+      : m_impl(comm) {
+    m_impl.set_routing(route);
+  }
+
+  grouped_multimap(const self_type& rhs) : m_impl(rhs.m_impl) {}
+
+  void set_routing(const ygm::routing_type route) { m_impl.set_routing(route); }
+
+  void async_insert(const std::pair<key_type, mapped_type>& kv) {
+    async_insert(kv.first, kv.second);
+  }
+  void async_insert(const key_type& key, const mapped_type& value) {
+    m_impl.async_insert(key, value);
+  }
+
+  /**
+   * @brief Visits each value of key in turn with (key, value, args...). Does
+   * nothing if key is missing.
+   */
+  template <typename Visitor, typename... VisitorArgs>
+  void async_visit(const key_type& key, Visitor visitor,
+                   const VisitorArgs&... args) {
+    m_impl.async_visit(key, visitor, std::forward<const VisitorArgs>(args)...);
+  }
+
+  /**
+   * @brief Visits all values of key at once with (key, group, args...), where
+   * group is a group_type span over the contiguous values. Does nothing if key
+   * is missing.
+   */
+  template <typename Visitor, typename... VisitorArgs>
+  void async_visit_group(const key_type& key, Visitor visitor,
+                         const VisitorArgs&... args) {
+    m_impl.async_visit_group(key, visitor,
+                             std::forward<const VisitorArgs>(args)...);
+  }
+
+  void async_erase(const key_type& key) { m_impl.async_erase(key); }
+
+  size_t local_count(const key_type& key) { return m_impl.local_count(key); }
+
+  template <typename Function>
+  void for_all(Function fn) {
+    m_impl.for_all(fn);
+  }
+
+  /**
+   * @brief Calls fn(key, group) once per key
+   */
+  template <typename Function>
+  void for_all_groups(Function fn) {
+    m_impl.for_all_groups(fn);
+  }
+
+  void clear() { m_impl.clear(); }
+
+  size_type size() { return m_impl.size(); }
+
+  size_type num_keys() { return m_impl.num_keys(); }
+
+  size_t count(const key_type& key) { return m_impl.count(key); }
+
+  typename ygm::ygm_ptr<impl_type> get_ygm_ptr() const {
+    return m_impl.get_ygm_ptr();
+  }
+
+  void serialize(const std::string& fname) { m_impl.serialize(fname); }
+  void deserialize(const std::string& fname) { m_impl.deserialize(fname); }
+
+  int owner(const key_type& key) const { return m_impl.owner(key); }
+
+  bool is_mine(const key_type& key) const { return m_impl.is_mine(key); }
+
+  const_group_type local_get(const key_type& key) const {
+    return m_impl.local_get(key);
+  }
+
+  void swap(self_type& s) { m_impl.swap(s.m_impl); }
+
+  template <typename STLKeyContainer>
+  std::multimap<key_type, mapped_type> all_gather(const STLKeyContainer& keys) {
+    std::multimap<key_type, mapped_type> to_return;
+    m_impl.all_gather(keys, to_return);
+    return to_return;
+  }
+
+  std::multimap<key_type, mapped_type> all_gather(
+      const std::vector<key_type>& keys) {
+    std::multimap<key_type, mapped_type> to_return;
+    m_impl.all_gather(keys, to_return);
+    return to_return;
+  }
+
+  /**
+   * @brief Collective lookup calling fn(key, value) on this rank for each
+   * value stored under the requested keys. Repeated keys are fetched once,
+   * with one batched request and reply per pair of ranks.
+   */
+  template <typename KeyRange, typename Function>
+  void bulk_lookup(const KeyRange& keys, Function fn) {
+    detail::bulk_lookup(m_impl, keys, fn);
+  }
+
+  ygm::comm& comm() { return m_impl.comm(); }
+
+  // Estimated heap bytes held by this rank's entries
+  size_t local_memory_bytes() const { return m_impl.local_memory_bytes(); }
+
+  // Name this container is reported under by ygm::memory_report()
+  void set_memory_name(const std::string& name) {
+    m_impl.set_memory_name(name);
+  }
+
+ private:
+  impl_type m_impl;
+};
+
+/**
+ * @brief ygm::map storing each rank's partition in an open-addressing hash
+ * table instead of a tree. Faster inserts and lookups, unordered local
+ * iteration.
+ */
+template <typename Key, typename Value,
+          typename Partitioner = detail::hash_partitioner<Key>,
+          typename Hash        = std::hash<Key>>
+using flat_map =
+    map<Key, Value, Partitioner, std::less<Key>,
+        std::allocator<std::pair<const Key, Value>>,
+        detail::flat_hash_map<Key, Value, Hash>>;
+
 }  // namespace ygm::container
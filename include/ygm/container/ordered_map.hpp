@@ -0,0 +1,135 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <ygm/container/detail/ordered_map_impl.hpp>
+
+namespace ygm::container {
+
+/**
+ * @brief Distributed map partitioned by key range instead of by hash. Rank r
+ * holds the keys between splitters r - 1 and r, so keys are globally ordered
+ * by rank and then by local position.
+ *
+ * Splitters are chosen by sampling the stored keys in load() and rebalance().
+ * Until the first of those, all keys are stored on rank 0.
+ */
+template <typename Key, typename Value, typename Compare = std::less<Key>>
+class ordered_map {
+ public:
+  using self_type         = ordered_map<Key, Value, Compare>;
+  using mapped_type       = Value;
+  using key_type          = Key;
+  using size_type         = size_t;
+  using ygm_for_all_types = std::tuple<Key, Value>;
+  using impl_type         = detail::ordered_map_impl<Key, Value, Compare>;
+
+  ordered_map() = delete;
+
+  ordered_map(ygm::comm& comm) : m_impl(comm) {}
+
+  ordered_map(ygm::comm& comm, const ygm::routing_type route) : m_impl(comm) {
+    m_impl.set_routing(route);
+  }
+
+  void set_routing(const ygm::routing_type route) { m_impl.set_routing(route); }
+
+  void async_insert(const std::pair<key_type, mapped_type>& kv) {
+    async_insert(kv.first, kv.second);
+  }
+  void async_insert(const key_type& key, const mapped_type& value) {
+    m_impl.async_insert(key, value);
+  }
+
+  template <typename Visitor, typename... VisitorArgs>
+  void async_visit(const key_type& key, Visitor visitor,
+                   const VisitorArgs&... args) {
+    m_impl.async_visit(key, visitor, std::forward<const VisitorArgs>(args)...);
+  }
+
+  template <typename Visitor, typename... VisitorArgs>
+  void async_visit_if_exists(const key_type& key, Visitor visitor,
+                             const VisitorArgs&... args) {
+    m_impl.async_visit_if_exists(key, visitor,
+                                 std::forward<const VisitorArgs>(args)...);
+  }
+
+  /**
+   * @brief Visits every key k with lo <= k < hi, in order on each rank, with
+   * (key, value, args...). Only ranks whose ranges overlap [lo, hi) are sent
+   * a message.
+   */
+  template <typename Visitor, typename... VisitorArgs>
+  void async_visit_range(const key_type& lo, const key_type& hi,
+                         Visitor visitor, const VisitorArgs&... args) {
+    m_impl.async_visit_range(lo, hi, visitor,
+                             std::forward<const VisitorArgs>(args)...);
+  }
+
+  void async_erase(const key_type& key) { m_impl.async_erase(key); }
+
+  /**
+   * @brief Calls fn(key, value) for each local entry in key order
+   */
+  template <typename Function>
+  void for_all(Function fn) {
+    m_impl.for_all(fn);
+  }
+
+  void clear() { m_impl.clear(); }
+
+  size_type size() { return m_impl.size(); }
+
+  size_t count(const key_type& key) { return m_impl.count(key); }
+
+  /**
+   * @brief Collective inserts all (key, value) entries of input, then picks
+   * splitters from the combined keys
+   */
+  template <typename Container>
+  void load(Container& input) {
+    m_impl.load(input);
+  }
+
+  /**
+   * @brief Collective picks new splitters balancing the stored keys across
+   * ranks and moves entries to their new owners
+   */
+  void rebalance() { m_impl.rebalance(); }
+
+  /**
+   * @brief Collective ratio of the largest local size to the mean; 1.0 is
+   * perfectly balanced. Callers can rebalance() when it grows too large.
+   */
+  double imbalance() { return m_impl.imbalance(); }
+
+  const std::vector<key_type>& splitters() const { return m_impl.splitters(); }
+
+  int owner(const key_type& key) const { return m_impl.owner(key); }
+
+  bool is_mine(const key_type& key) const { return m_impl.is_mine(key); }
+
+  size_type local_size() const { return m_impl.local_size(); }
+
+  typename ygm::ygm_ptr<impl_type> get_ygm_ptr() const {
+    return m_impl.get_ygm_ptr();
+  }
+
+  ygm::comm& comm() { return m_impl.comm(); }
+
+  // Estimated heap bytes held by this rank's entries
+  size_t local_memory_bytes() const { return m_impl.local_memory_bytes(); }
+
+  // Name this container is reported under by ygm::memory_report()
+  void set_memory_name(const std::string& name) {
+    m_impl.set_memory_name(name);
+  }
+
+ private:
+  impl_type m_impl;
+};
+
+}  // namespace ygm::container
@@ -0,0 +1,292 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cereal/archives/json.hpp>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <ygm/comm.hpp>
+#include <ygm/container/detail/flat_hash_table.hpp>
+#include <ygm/container/detail/hash_partitioner.hpp>
+#include <ygm/container/detail/kll_sketch.hpp>
+#include <ygm/detail/interrupt_mask.hpp>
+#include <ygm/detail/ygm_ptr.hpp>
+#include <ygm/detail/ygm_traits.hpp>
+
+namespace ygm::container {
+
+/**
+ * @brief Approximate quantiles of the items inserted on all ranks. Each rank
+ * keeps one KLL sketch, so inserts send no messages; the collective queries
+ * merge the sketches up the all_reduce tree. With the default k of 200 a
+ * quantile's rank is within about 1% of count() of the true one, using a few
+ * thousand items of memory per rank however many are inserted.
+ */
+template <typename Item, typename Compare = std::less<Item>>
+class quantile_sketch {
+ public:
+  using self_type   = quantile_sketch<Item, Compare>;
+  using value_type  = Item;
+  using size_type   = size_t;
+  using sketch_type = detail::kll_sketch<Item, Compare>;
+
+  quantile_sketch(ygm::comm &comm, const uint32_t k = sketch_type::default_k)
+      : m_sketch(k, comm.rank()), m_comm(comm) {}
+
+  // Local; no message is sent
+  void async_insert(const value_type &item) { m_sketch.insert(item); }
+
+  // Collective. Item at fraction q of the way through the sorted items.
+  value_type quantile(const double q) { return global_sketch().quantile(q); }
+
+  // Collective. quantile() of each of qs from one merge.
+  std::vector<value_type> quantiles(const std::vector<double> &qs) {
+    return global_sketch().quantiles(qs);
+  }
+
+  // Collective. Estimated fraction of items not greater than item.
+  double cdf(const value_type &item) { return global_sketch().cdf(item); }
+
+  // Collective. Exact number of items inserted.
+  size_type count() {
+    m_comm.barrier();
+    return m_comm.all_reduce_sum(size_type(m_sketch.count()));
+  }
+
+  // Collective. The merge of every rank's sketch, identical on all ranks.
+  sketch_type global_sketch() {
+    m_comm.barrier();
+    return m_comm.all_reduce(m_sketch, [](sketch_type a, const sketch_type &b) {
+      a.merge(b);
+      return a;
+    });
+  }
+
+  // Adds the items of another sketch with the same k on this rank
+  void local_merge(const sketch_type &sketch) { m_sketch.merge(sketch); }
+
+  const sketch_type &local_sketch() const { return m_sketch; }
+
+  void clear() {
+    m_comm.barrier();
+    m_sketch.clear();
+  }
+
+  void serialize(const std::string &fname) {
+    m_comm.barrier();
+    std::string   rank_fname = fname + std::to_string(m_comm.rank());
+    std::ofstream os(rank_fname, std::ios::binary);
+    cereal::JSONOutputArchive oarchive(os);
+    oarchive(m_sketch, m_comm.size());
+  }
+
+  void deserialize(const std::string &fname) {
+    m_comm.barrier();
+
+    std::string   rank_fname = fname + std::to_string(m_comm.rank());
+    std::ifstream is(rank_fname, std::ios::binary);
+
+    cereal::JSONInputArchive iarchive(is);
+    int                      comm_size;
+    iarchive(m_sketch, comm_size);
+
+    if (comm_size != m_comm.size()) {
+      m_comm.cerr0(
+          "Attempting to deserialize quantile_sketch using communicator of "
+          "different size than serialized with");
+    }
+  }
+
+  size_t local_memory_bytes() const { return m_sketch.memory_bytes(); }
+
+  ygm::comm &comm() { return m_comm; }
+
+ private:
+  sketch_type m_sketch;
+  ygm::comm  &m_comm;
+
+  ygm::detail::memory_tracker m_memory{
+      m_comm.memory_sources(), "quantile_sketch",
+      [this]() { return local_memory_bytes(); }};
+};
+
+/**
+ * @brief Approximate quantiles of the items inserted under each key. Inserts
+ * go into a KLL sketch per key on the inserting rank, without messages. The
+ * collective calls first send each rank's sketches to the keys' owners and
+ * merge them there, so traffic grows with the number of keys per rank rather
+ * than with the number of items.
+ */
+template <typename Key, typename Item, typename Compare = std::less<Item>,
+          typename Partitioner = detail::hash_partitioner<Key>>
+class keyed_quantile_sketch {
+ public:
+  using self_type =
+      keyed_quantile_sketch<Key, Item, Compare, Partitioner>;
+  using ptr_type          = typename ygm::ygm_ptr<self_type>;
+  using key_type          = Key;
+  using value_type        = Item;
+  using size_type         = size_t;
+  using sketch_type       = detail::kll_sketch<Item, Compare>;
+  using ygm_for_all_types = std::tuple<Key, sketch_type>;
+
+  static constexpr uint32_t default_k = 100;
+
+  Partitioner partitioner;
+
+  keyed_quantile_sketch() = delete;
+
+  keyed_quantile_sketch(ygm::comm &comm, const uint32_t k = default_k)
+      : m_k(k), m_comm(comm), pthis(this) {
+    pthis.check(m_comm);
+  }
+
+  ~keyed_quantile_sketch() { m_comm.barrier(); }
+
+  void set_routing(const ygm::routing_type route) { m_routing = route; }
+
+  // Local until the next collective call
+  void async_insert(const key_type &key, const value_type &item) {
+    auto &sketches = is_mine(key) ? m_owned : m_pending;
+    find_or_insert(sketches, key).insert(item);
+  }
+
+  // Calls fn(key, sketch) for each key owned by this rank
+  template <typename Function>
+  void for_all(Function fn) {
+    flush();
+    for (const auto &kv : m_owned) {
+      fn(kv.first, kv.second);
+    }
+  }
+
+  // Collective. The sketch of every item inserted under key, on all ranks.
+  sketch_type sketch(const key_type &key) {
+    flush();
+    auto itr = m_owned.find(key);
+    return m_comm.all_reduce(
+        itr == m_owned.end() ? sketch_type(m_k) : itr->second,
+        [](sketch_type a, const sketch_type &b) {
+          a.merge(b);
+          return a;
+        });
+  }
+
+  // Collective. Requires at least one item under key.
+  value_type quantile(const key_type &key, const double q) {
+    return sketch(key).quantile(q);
+  }
+
+  // Collective
+  double cdf(const key_type &key, const value_type &item) {
+    return sketch(key).cdf(item);
+  }
+
+  // Number of keys
+  size_type size() {
+    flush();
+    return m_comm.all_reduce_sum(m_owned.size());
+  }
+
+  size_type local_size() const { return m_owned.size(); }
+
+  void clear() {
+    m_comm.barrier();
+    m_owned.clear();
+    m_pending.clear();
+  }
+
+  void serialize(const std::string &fname) {
+    flush();
+    std::string   rank_fname = fname + std::to_string(m_comm.rank());
+    std::ofstream os(rank_fname, std::ios::binary);
+    cereal::JSONOutputArchive oarchive(os);
+    oarchive(m_owned, m_k, m_comm.size());
+  }
+
+  void deserialize(const std::string &fname) {
+    m_comm.barrier();
+
+    std::string   rank_fname = fname + std::to_string(m_comm.rank());
+    std::ifstream is(rank_fname, std::ios::binary);
+
+    cereal::JSONInputArchive iarchive(is);
+    int                      comm_size;
+    iarchive(m_owned, m_k, comm_size);
+    m_pending.clear();
+
+    if (comm_size != m_comm.size()) {
+      m_comm.cerr0(
+          "Attempting to deserialize keyed_quantile_sketch using "
+          "communicator of different size than serialized with");
+    }
+  }
+
+  int owner(const key_type &key) const {
+    auto [owner, rank] = partitioner(key, m_comm.size(), 1024);
+    return owner;
+  }
+
+  bool is_mine(const key_type &key) const {
+    return owner(key) == m_comm.rank();
+  }
+
+  size_t local_memory_bytes() const {
+    size_t bytes = m_owned.memory_bytes() + m_pending.memory_bytes();
+    for (const auto &kv : m_owned) {
+      bytes += kv.second.memory_bytes();
+    }
+    for (const auto &kv : m_pending) {
+      bytes += kv.second.memory_bytes();
+    }
+    return bytes;
+  }
+
+  typename ygm::ygm_ptr<self_type> get_ygm_ptr() const { return pthis; }
+
+  ygm::comm &comm() { return m_comm; }
+
+ private:
+  using sketch_map = detail::flat_hash_map<key_type, sketch_type>;
+
+  sketch_type &find_or_insert(sketch_map &sketches, const key_type &key) {
+    auto itr = sketches.find(key);
+    if (itr == sketches.end()) {
+      itr = sketches.emplace(key, sketch_type(m_k, m_comm.rank())).first;
+    }
+    return itr->second;
+  }
+
+  // Collective. Merges the sketches of keys owned elsewhere into their
+  // owners' sketches.
+  void flush() {
+    m_comm.barrier();
+    auto merger = [](auto psketch, const key_type &key,
+                     const sketch_type &sketch) {
+      psketch->find_or_insert(psketch->m_owned, key).merge(sketch);
+    };
+    for (const auto &kv : m_pending) {
+      m_comm.async(m_routing, owner(kv.first), merger, pthis, kv.first,
+                   kv.second);
+    }
+    m_pending.clear();
+    m_comm.barrier();
+  }
+
+  uint32_t          m_k;
+  sketch_map        m_owned;
+  sketch_map        m_pending;
+  ygm::comm        &m_comm;
+  ptr_type          pthis;
+  ygm::routing_type m_routing = ygm::routing_type::DEFAULT;
+
+  ygm::detail::memory_tracker m_memory{
+      m_comm.memory_sources(), "keyed_quantile_sketch",
+      [this]() { return local_memory_bytes(); }};
+};
+
+}  // namespace ygm::container
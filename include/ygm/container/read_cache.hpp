@@ -0,0 +1,217 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#include <functional>
+#include <unordered_map>
+#include <vector>
+#include <ygm/comm.hpp>
+#include <ygm/container/detail/memory_usage.hpp>
+#include <ygm/detail/interrupt_mask.hpp>
+#include <ygm/detail/ygm_ptr.hpp>
+#include <ygm/detail/ygm_traits.hpp>
+
+namespace ygm::container {
+
+/**
+ * @brief Per-rank read-through cache in front of a map or multimap.
+ *
+ * Values fetched from remote owners are kept until the next barrier() on the
+ * container's comm, so repeated lookups of hot keys within an epoch cost one
+ * message per rank instead of one per lookup. Lookups of a key that is
+ * already being fetched wait for that fetch instead of sending another.
+ * Misses are cached too, so absent keys are also fetched once per epoch.
+ *
+ * Visitors run on the calling rank with const values and may capture. Writes
+ * made to the container during an epoch are not seen by cached reads until
+ * the epoch ends.
+ */
+template <typename Container>
+class read_cache {
+ public:
+  using self_type   = read_cache<Container>;
+  using ptr_type    = typename ygm::ygm_ptr<self_type>;
+  using key_type    = typename Container::key_type;
+  using mapped_type = typename Container::mapped_type;
+
+  static constexpr size_t default_capacity = 1024 * 1024;
+
+  /**
+   * @param capacity Maximum number of cached keys. When full, an arbitrary
+   * entry is evicted to make room.
+   */
+  read_cache(Container &c, const size_t capacity = default_capacity)
+      : m_container(c),
+        m_capacity(capacity),
+        m_epoch(c.comm().barrier_epoch()),
+        pthis(this) {
+    pthis.check(c.comm());
+  }
+
+  read_cache(const self_type &rhs) = delete;
+
+  ~read_cache() { m_container.comm().barrier(); }
+
+  /**
+   * @brief Calls visitor(key, const value&, args...), or visitor(pcache, key,
+   * const value&, args...), on this rank for each value stored under key.
+   * Does nothing if key is absent.
+   */
+  template <typename Visitor, typename... VisitorArgs>
+  void async_visit_if_exists(const key_type &key, Visitor visitor,
+                             const VisitorArgs &...args) {
+    check_epoch();
+
+    // The owner reads its own data directly
+    if (m_container.is_mine(key)) {
+      local_visit(key, m_container.local_get(key), visitor, args...);
+      return;
+    }
+
+    auto itr = m_cache.find(key);
+    if (itr != m_cache.end()) {
+      ++m_hits;
+      local_visit(key, itr->second, visitor, args...);
+      return;
+    }
+
+    ++m_misses;
+    auto [pending, first_miss] = m_pending.try_emplace(key);
+    pending->second.emplace_back(
+        [this, visitor, args...](const key_type                 &key,
+                                 const std::vector<mapped_type> &values) {
+          local_visit(key, values, visitor, args...);
+        });
+    if (first_miss) {
+      ++m_fetches;
+      fetch(key);
+    }
+  }
+
+  /**
+   * @brief Calls visitor on a value for key held outside of the cache, such
+   * as a replica, accepting the same signatures as async_visit_if_exists()
+   */
+  template <typename Visitor, typename... VisitorArgs>
+  void visit_value(const key_type &key, const mapped_type &value,
+                   Visitor visitor, const VisitorArgs &...args) {
+    local_visit(key, value, visitor, args...);
+  }
+
+  /**
+   * @brief Drops all cached values. Pending fetches still complete.
+   */
+  void invalidate() { m_cache.clear(); }
+
+  // Lookups served from the cache
+  size_t hits() const { return m_hits; }
+
+  // Lookups of remote keys not in the cache
+  size_t misses() const { return m_misses; }
+
+  // Messages sent to owners; misses minus the coalesced ones
+  size_t fetches() const { return m_fetches; }
+
+  size_t local_size() const { return m_cache.size(); }
+
+  // Estimated heap bytes held by cached entries and their values
+  size_t local_memory_bytes() const {
+    size_t bytes = detail::local_container_bytes(m_cache);
+    for (const auto &kv : m_cache) {
+      bytes += detail::local_container_bytes(kv.second);
+    }
+    return bytes;
+  }
+
+  ygm::comm &comm() { return m_container.comm(); }
+
+ private:
+  using callback_type = std::function<void(const key_type &,
+                                           const std::vector<mapped_type> &)>;
+
+  void check_epoch() {
+    if (m_epoch != m_container.comm().barrier_epoch()) {
+      m_epoch = m_container.comm().barrier_epoch();
+      m_cache.clear();
+    }
+  }
+
+  void fetch(const key_type &key) {
+    auto fetcher = [](auto pcache, const key_type &key, const int from) {
+      auto filler = [](auto pcache, const key_type &key,
+                       const std::vector<mapped_type> &values) {
+        pcache->fill(key, values);
+      };
+      pcache->comm().async(from, filler, pcache, key,
+                           pcache->m_container.local_get(key));
+    };
+    comm().async(m_container.owner(key), fetcher, pthis, key, comm().rank());
+  }
+
+  void fill(const key_type &key, const std::vector<mapped_type> &values) {
+    if (m_capacity > 0) {
+      if (m_cache.size() >= m_capacity) {
+        m_cache.erase(m_cache.begin());
+      }
+      m_cache.insert_or_assign(key, values);
+    }
+
+    // Visitors may look up this key again, so detach the waiters first
+    auto itr     = m_pending.find(key);
+    auto waiting = std::move(itr->second);
+    m_pending.erase(itr);
+    for (auto &fn : waiting) {
+      fn(key, values);
+    }
+  }
+
+  template <typename Function, typename... VisitorArgs>
+  void local_visit(const key_type &key, const std::vector<mapped_type> &values,
+                   Function &fn, const VisitorArgs &...args) {
+    for (const auto &value : values) {
+      local_visit(key, value, fn, args...);
+    }
+  }
+
+  template <typename Function, typename... VisitorArgs>
+  void local_visit(const key_type &key, const mapped_type &value, Function &fn,
+                   const VisitorArgs &...args) {
+    ygm::detail::interrupt_mask mask(m_container.comm());
+
+    if constexpr (std::is_invocable<decltype(fn), const key_type &,
+                                    const mapped_type &,
+                                    const VisitorArgs &...>() ||
+                  std::is_invocable<decltype(fn), ptr_type, const key_type &,
+                                    const mapped_type &,
+                                    const VisitorArgs &...>()) {
+      ygm::meta::apply_optional(fn, std::make_tuple(pthis),
+                                std::forward_as_tuple(key, value, args...));
+    } else {
+      static_assert(ygm::detail::always_false<>,
+                    "read_cache lambda signature must be invocable with "
+                    "(const &key_type, const mapped_type&, ...) or (ptr_type, "
+                    "const &key_type, const mapped_type&, ...) signatures");
+    }
+  }
+
+  Container &m_container;
+  size_t     m_capacity;
+  uint64_t   m_epoch;
+
+  std::unordered_map<key_type, std::vector<mapped_type>>   m_cache;
+  std::unordered_map<key_type, std::vector<callback_type>> m_pending;
+
+  size_t m_hits    = 0;
+  size_t m_misses  = 0;
+  size_t m_fetches = 0;
+
+  ptr_type pthis;
+
+  ygm::detail::memory_tracker m_memory{
+      m_container.comm().memory_sources(), "read_cache",
+      [this]() { return local_memory_bytes(); }};
+};
+
+}  // namespace ygm::container
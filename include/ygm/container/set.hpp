@@ -6,29 +6,39 @@
 #pragma once
 
 #include <ygm/container/container_traits.hpp>
+#include <ygm/container/detail/flat_hash_table.hpp>
 #include <ygm/container/detail/set_impl.hpp>
+#include <ygm/container/frozen.hpp>
 
 namespace ygm::container {
 
 template <typename Key, typename Partitioner = detail::hash_partitioner<Key>,
           typename Compare = std::less<Key>,
-          class Alloc      = std::allocator<const Key>>
+          class Alloc      = detail::pool_allocator<Key>>
 class multiset {
  public:
   using self_type         = multiset<Key, Partitioner, Compare, Alloc>;
   using key_type          = Key;
   using size_type         = size_t;
   using ygm_for_all_types = std::tuple<Key>;
+  using partitioner_type  = Partitioner;
   using impl_type = detail::set_impl<key_type, Partitioner, Compare, Alloc>;
 
   Partitioner partitioner;
 
   multiset() = delete;
 
-  multiset(ygm::comm& comm) : m_impl(comm) {}
+  multiset(ygm::comm& comm) : m_impl(comm) { set_memory_name("multiset"); }
+
+  multiset(ygm::comm& comm, const ygm::routing_type route) : m_impl(comm) {
+    m_impl.set_routing(route);
+    set_memory_name("multiset");
+  }
 
   void async_insert(const key_type& key) { m_impl.async_insert_multi(key); }
 
+  void set_routing(const ygm::routing_type route) { m_impl.set_routing(route); }
+
   void async_erase(const key_type& key) { m_impl.async_erase(key); }
 
   template <typename Function>
@@ -67,21 +77,32 @@ class multiset {
 
   ygm::comm& comm() { return m_impl.comm(); }
 
+  // Estimated heap bytes held by this rank's entries
+  size_t local_memory_bytes() const { return m_impl.local_memory_bytes(); }
+
+  // Name this container is reported under by ygm::memory_report()
+  void set_memory_name(const std::string& name) {
+    m_impl.set_memory_name(name);
+  }
+
  private:
   impl_type m_impl;
 };
 
 template <typename Key, typename Partitioner = detail::hash_partitioner<Key>,
           typename Compare = std::less<Key>,
-          class Alloc      = std::allocator<const Key>>
+          class Alloc      = detail::pool_allocator<Key>,
+          class LocalSet   = std::multiset<Key, Compare, Alloc>>
 class set {
  public:
-  using self_type          = set<Key, Partitioner, Compare, Alloc>;
+  using self_type          = set<Key, Partitioner, Compare, Alloc, LocalSet>;
   using key_type           = Key;
   using size_type          = size_t;
   using ygm_container_type = ygm::container::set_tag;
   using ygm_for_all_types  = std::tuple<Key>;
-  using impl_type = detail::set_impl<key_type, Partitioner, Compare, Alloc>;
+  using partitioner_type   = Partitioner;
+  using impl_type =
+      detail::set_impl<key_type, Partitioner, Compare, Alloc, LocalSet>;
 
   Partitioner partitioner;
 
@@ -89,8 +110,29 @@ class set {
 
   set(ygm::comm& comm) : m_impl(comm) {}
 
+  set(ygm::comm& comm, const ygm::routing_type route) : m_impl(comm) {
+    m_impl.set_routing(route);
+  }
+
   void async_insert(const key_type& key) { m_impl.async_insert_unique(key); }
 
+  void set_routing(const ygm::routing_type route) { m_impl.set_routing(route); }
+
+  /**
+   * @brief Skips async_insert and async_insert_exe_if_missing calls for keys
+   * this rank already sent since the last barrier(), remembering up to
+   * capacity recent keys exactly. 0, the default, turns the filter off.
+   *
+   * A skipped call could not have changed the set or run its visitor, unless
+   * another rank erased the key in between.
+   */
+  void set_duplicate_filter(const size_t capacity) {
+    m_impl.set_duplicate_filter(capacity);
+  }
+
+  // Calls skipped on this rank by the duplicate filter
+  size_t suppressed_inserts() const { return m_impl.suppressed_inserts(); }
+
   void async_erase(const key_type& key) { m_impl.async_erase(key); }
 
   template <typename Visitor, typename... VisitorArgs>
@@ -133,6 +175,14 @@ class set {
 
   void clear() { m_impl.clear(); }
 
+  /**
+   * @brief Collective. Moves every key into an immutable, read-optimized
+   * frozen_set and leaves this set empty.
+   */
+  frozen_set<Key, Partitioner, Compare> freeze() {
+    return frozen_set<Key, Partitioner, Compare>(*this);
+  }
+
   size_type size() { return m_impl.size(); }
 
   bool empty() { return m_impl.size() == 0; }
@@ -157,8 +207,27 @@ class set {
 
   ygm::comm& comm() { return m_impl.comm(); }
 
+  // Estimated heap bytes held by this rank's entries
+  size_t local_memory_bytes() const { return m_impl.local_memory_bytes(); }
+
+  // Name this container is reported under by ygm::memory_report()
+  void set_memory_name(const std::string& name) {
+    m_impl.set_memory_name(name);
+  }
+
  private:
   impl_type m_impl;
 };
 
+/**
+ * @brief ygm::set storing each rank's partition in an open-addressing hash
+ * table instead of a tree. Faster inserts and lookups, unordered local
+ * iteration.
+ */
+template <typename Key, typename Partitioner = detail::hash_partitioner<Key>,
+          typename Hash = std::hash<Key>>
+using flat_set =
+    set<Key, Partitioner, std::less<Key>, std::allocator<const Key>,
+        detail::flat_hash_set<Key, Hash>>;
+
 }  // namespace ygm::container
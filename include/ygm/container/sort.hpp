@@ -0,0 +1,56 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <functional>
+#include <ygm/container/array.hpp>
+#include <ygm/container/bag.hpp>
+#include <ygm/container/detail/sample_sort.hpp>
+
+namespace ygm::container {
+
+/**
+ * @brief Collective sort of the items of a bag into a new array, globally
+ * ordered by cmp and evenly balanced across ranks. The bag is unchanged.
+ *
+ * @tparam Compare Strict weak ordering of Item
+ * @param input Items to sort
+ * @param cmp Comparator
+ * @return ygm::container::array<Item> holding the sorted items
+ */
+template <typename Item, typename Alloc, typename Compare = std::less<Item>>
+ygm::container::array<Item> sort(bag<Item, Alloc> &input,
+                                 Compare           cmp = Compare()) {
+  std::vector<Item> local;
+  local.reserve(input.local_size());
+  input.for_all([&local](const Item &item) { local.push_back(item); });
+
+  auto sorted = detail::sample_sort(std::move(local), cmp, input.comm());
+
+  ygm::container::array<Item> to_return(
+      input.comm(), input.comm().all_reduce_sum(sorted.size()));
+  size_t i = 0;
+  to_return.for_all([&sorted, &i](const auto index, Item &value) {
+    value = std::move(sorted[i++]);
+  });
+  return to_return;
+}
+
+/**
+ * @brief Collective in-place sort of an array by cmp
+ */
+template <typename Value, typename Index, typename Compare = std::less<Value>>
+void sort(array<Value, Index> &arr, Compare cmp = Compare()) {
+  std::vector<Value> local;
+  arr.for_all([&local](const Value &value) { local.push_back(value); });
+
+  auto sorted = detail::sample_sort(std::move(local), cmp, arr.comm());
+
+  size_t i = 0;
+  arr.for_all([&sorted, &i](Value &value) { value = std::move(sorted[i++]); });
+}
+
+}  // namespace ygm::container
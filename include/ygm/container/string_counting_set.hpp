@@ -0,0 +1,125 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <ygm/comm.hpp>
+#include <ygm/container/detail/combining_cache.hpp>
+#include <ygm/container/string_map.hpp>
+#include <ygm/detail/ygm_ptr.hpp>
+
+namespace ygm::container {
+
+/**
+ * @brief counting_set<std::string> storing its counts in a string_map, so
+ * each rank keeps its words interned in one arena. Inserts are combined in a
+ * local cache before they are sent, as in counting_set.
+ */
+class string_counting_set {
+ public:
+  using self_type         = string_counting_set;
+  using mapped_type       = size_t;
+  using key_type          = std::string;
+  using size_type         = size_t;
+  using ygm_for_all_types = std::tuple<std::string, size_t>;
+
+  string_counting_set(ygm::comm &comm)
+      : m_map(comm, mapped_type(0)), pthis(this) {
+    m_map.set_memory_name("string_counting_set");
+  }
+
+  void async_insert(const key_type &key) { cache_insert(key); }
+
+  /**
+   * @brief Calls fn(key, count&) for each local word; see
+   * string_map::for_all for the key types accepted
+   */
+  template <typename Function>
+  void for_all(Function fn) {
+    m_map.for_all(fn);
+  }
+
+  void clear() { m_map.clear(); }
+
+  size_type size() { return m_map.size(); }
+
+  mapped_type count(const key_type &key) {
+    m_map.comm().barrier();
+    const mapped_type *local = m_map.local_find(key);
+    return m_map.comm().all_reduce_sum(local ? *local : mapped_type(0));
+  }
+
+  mapped_type count_all() {
+    mapped_type local_count{0};
+    for_all([&local_count](const std::string_view key, mapped_type &value) {
+      local_count += value;
+    });
+    return m_map.comm().all_reduce_sum(local_count);
+  }
+
+  bool is_mine(const key_type &key) const { return m_map.is_mine(key); }
+
+  template <typename CompareFunction>
+  std::vector<std::pair<key_type, mapped_type>> topk(size_t          k,
+                                                     CompareFunction cfn) {
+    return m_map.topk(k, cfn);
+  }
+
+  /**
+   * @brief Hit, miss and flush counts of this rank's insert cache. Each flush
+   * is one message.
+   */
+  detail::combining_cache_stats cache_stats() const {
+    return m_count_cache.stats();
+  }
+
+  // Heap bytes this rank holds for words
+  size_t local_key_bytes() const { return m_map.local_key_bytes(); }
+
+  // Estimated heap bytes held by this rank's words, counts and insert cache
+  size_t local_memory_bytes() const {
+    return m_map.local_memory_bytes() + m_count_cache.memory_bytes();
+  }
+
+  typename ygm::ygm_ptr<self_type> get_ygm_ptr() const { return pthis; }
+
+  ygm::comm &comm() { return m_map.comm(); }
+
+ private:
+  void cache_insert(const key_type &key) {
+    if (m_cache_empty) {
+      m_cache_empty = false;
+      m_map.comm().register_pre_barrier_callback(
+          [this]() { this->count_cache_flush_all(); });
+    }
+    m_count_cache.combine(
+        key, 1, std::plus<mapped_type>(),
+        [this](const key_type &key, const mapped_type &count) {
+          m_map.async_reduce(key, count, std::plus<mapped_type>());
+        });
+  }
+
+  void count_cache_flush_all() {
+    // Cleared first, so counts cached while flushing register a new callback
+    m_cache_empty = true;
+    m_count_cache.flush_all(
+        [this](const key_type &key, const mapped_type &count) {
+          m_map.async_reduce(key, count, std::plus<mapped_type>());
+        });
+  }
+
+  string_counting_set() = delete;
+
+  detail::combining_cache<key_type, mapped_type> m_count_cache;
+  bool                                           m_cache_empty = true;
+  string_map<mapped_type>                        m_map;
+  typename ygm::ygm_ptr<self_type>               pthis;
+
+  ygm::detail::memory_tracker m_cache_memory{
+      m_map.comm().memory_sources(), "string_counting_set",
+      [this]() { return m_count_cache.memory_bytes(); }};
+};
+
+}  // namespace ygm::container
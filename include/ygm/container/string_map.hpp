@@ -0,0 +1,280 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <ygm/comm.hpp>
+#include <ygm/container/detail/string_arena.hpp>
+#include <ygm/container/detail/topk.hpp>
+#include <ygm/detail/interrupt_mask.hpp>
+#include <ygm/detail/ygm_ptr.hpp>
+#include <ygm/detail/ygm_traits.hpp>
+
+namespace ygm::container {
+
+/**
+ * @brief Distributed map from std::string keys, tuned for many short keys.
+ * Each rank interns its keys into a detail::string_arena and keeps values in
+ * a parallel vector, so a stored key costs its characters, one offset and one
+ * hashed index slot instead of a heap std::string inside a tree node. Every
+ * message carries the key's hash, so the owner does not rehash it.
+ *
+ * Keys are placed like map<std::string, Value> places them. Keys cannot be
+ * erased individually; clear() releases them all. Local iteration is in
+ * insertion order.
+ */
+template <typename Value>
+class string_map {
+ public:
+  using self_type         = string_map<Value>;
+  using ptr_type          = typename ygm::ygm_ptr<self_type>;
+  using mapped_type       = Value;
+  using key_type          = std::string;
+  using size_type         = size_t;
+  using ygm_for_all_types = std::tuple<std::string, Value>;
+
+  string_map() = delete;
+
+  string_map(ygm::comm &comm) : m_default_value{}, m_comm(comm), pthis(this) {
+    pthis.check(m_comm);
+  }
+
+  string_map(ygm::comm &comm, const mapped_type &dv)
+      : m_default_value(dv), m_comm(comm), pthis(this) {
+    pthis.check(m_comm);
+  }
+
+  string_map(const self_type &rhs) = delete;
+
+  ~string_map() { m_comm.barrier(); }
+
+  /**
+   * @brief Selects the routing used by messages sent from this map, overriding
+   * YGM_COMM_ROUTING
+   */
+  void set_routing(const ygm::routing_type route) { m_routing = route; }
+
+  void async_insert(const key_type &key, const mapped_type &value) {
+    auto inserter = [](auto pmap, const size_t hash, const key_type &key,
+                       const mapped_type &value) {
+      pmap->m_values[pmap->local_intern(key, hash)] = value;
+    };
+    const size_t hash = detail::string_hash(key);
+    m_comm.async(m_routing, owner_of_hash(hash), inserter, pthis, hash, key,
+                 value);
+  }
+
+  void async_insert_if_missing(const key_type &key, const mapped_type &value) {
+    auto inserter = [](auto pmap, const size_t hash, const key_type &key,
+                       const mapped_type &value) {
+      auto [id, added] = pmap->m_arena.insert(key, hash);
+      if (added) {
+        pmap->m_values.push_back(value);
+      }
+    };
+    const size_t hash = detail::string_hash(key);
+    m_comm.async(m_routing, owner_of_hash(hash), inserter, pthis, hash, key,
+                 value);
+  }
+
+  /**
+   * @brief Calls visitor(key, value&, args...), or visitor(pmap, key, value&,
+   * args...), on the owner of key, inserting the default value first if key
+   * is absent
+   */
+  template <typename Visitor, typename... VisitorArgs>
+  void async_visit(const key_type &key, Visitor visitor,
+                   const VisitorArgs &...args) {
+    auto visit_wrapper = [](auto pmap, const size_t hash, const key_type &key,
+                            const VisitorArgs &...args) {
+      Visitor *vis = nullptr;
+      pmap->local_visit(key, pmap->local_intern(key, hash), *vis, args...);
+    };
+    const size_t hash = detail::string_hash(key);
+    m_comm.async(m_routing, owner_of_hash(hash), visit_wrapper, pthis, hash,
+                 key, std::forward<const VisitorArgs>(args)...);
+  }
+
+  template <typename Visitor, typename... VisitorArgs>
+  void async_visit_if_exists(const key_type &key, Visitor visitor,
+                             const VisitorArgs &...args) {
+    auto visit_wrapper = [](auto pmap, const size_t hash, const key_type &key,
+                            const VisitorArgs &...args) {
+      auto id = pmap->m_arena.find(key, hash);
+      if (id != detail::string_arena::npos) {
+        Visitor *vis = nullptr;
+        pmap->local_visit(key, id, *vis, args...);
+      }
+    };
+    const size_t hash = detail::string_hash(key);
+    m_comm.async(m_routing, owner_of_hash(hash), visit_wrapper, pthis, hash,
+                 key, std::forward<const VisitorArgs>(args)...);
+  }
+
+  template <typename ReductionOp>
+  void async_reduce(const key_type &key, const mapped_type &value,
+                    ReductionOp reducer) {
+    auto reduce_wrapper = [](auto pmap, const size_t hash, const key_type &key,
+                             const mapped_type &value) {
+      auto [id, added] = pmap->m_arena.insert(key, hash);
+      if (added) {
+        pmap->m_values.push_back(value);
+      } else {
+        ReductionOp *reducer = nullptr;
+        pmap->m_values[id]   = (*reducer)(pmap->m_values[id], value);
+      }
+    };
+    const size_t hash = detail::string_hash(key);
+    m_comm.async(m_routing, owner_of_hash(hash), reduce_wrapper, pthis, hash,
+                 key, value);
+  }
+
+  /**
+   * @brief Calls fn(key, value&) for each local entry. key is a
+   * std::string_view into the arena if fn accepts one, else a std::string.
+   */
+  template <typename Function>
+  void for_all(Function fn) {
+    m_comm.barrier();
+    local_for_all(fn);
+  }
+
+  template <typename Function>
+  void local_for_all(Function fn) {
+    if constexpr (std::is_invocable<decltype(fn), std::string_view,
+                                    mapped_type &>()) {
+      for (size_t id = 0; id < m_values.size(); ++id) {
+        fn(m_arena.view(id), m_values[id]);
+      }
+    } else if constexpr (std::is_invocable<decltype(fn), const key_type &,
+                                           mapped_type &>()) {
+      for (size_t id = 0; id < m_values.size(); ++id) {
+        fn(key_type(m_arena.view(id)), m_values[id]);
+      }
+    } else {
+      static_assert(ygm::detail::always_false<>,
+                    "local string_map lambda signature must be invocable "
+                    "with (std::string_view, mapped_type&) or (const "
+                    "std::string &, mapped_type&) signatures");
+    }
+  }
+
+  // Value stored under key on this rank, or nullptr
+  mapped_type *local_find(const std::string_view key) {
+    auto id = m_arena.find(key, detail::string_hash(key));
+    return id == detail::string_arena::npos ? nullptr : &m_values[id];
+  }
+
+  std::vector<mapped_type> local_get(const key_type &key) {
+    const mapped_type *value = local_find(key);
+    return value ? std::vector<mapped_type>{*value}
+                 : std::vector<mapped_type>{};
+  }
+
+  void clear() {
+    m_comm.barrier();
+    m_arena.clear();
+    m_values.clear();
+    m_values.shrink_to_fit();
+  }
+
+  size_type size() {
+    m_comm.barrier();
+    return m_comm.all_reduce_sum(m_values.size());
+  }
+
+  size_t count(const key_type &key) {
+    m_comm.barrier();
+    return m_comm.all_reduce_sum(size_t(local_find(key) != nullptr));
+  }
+
+  size_type local_size() const { return m_values.size(); }
+
+  // Heap bytes this rank holds for keys: characters, offsets and index
+  size_t local_key_bytes() const { return m_arena.memory_bytes(); }
+
+  // Estimated heap bytes held by this rank's keys and values
+  size_t local_memory_bytes() const {
+    return m_arena.memory_bytes() + m_values.capacity() * sizeof(mapped_type);
+  }
+
+  // Name this map is reported under by ygm::memory_report()
+  void set_memory_name(const std::string &name) { m_memory.rename(name); }
+
+  template <typename CompareFunction>
+  std::vector<std::pair<key_type, mapped_type>> topk(size_t          k,
+                                                     CompareFunction cfn) {
+    m_comm.barrier();
+    return detail::distributed_topk<std::pair<key_type, mapped_type>>(
+        m_comm, k, cfn, [this](auto push) {
+          for (size_t id = 0; id < m_values.size(); ++id) {
+            push(std::make_pair(key_type(m_arena.view(id)), m_values[id]));
+          }
+        });
+  }
+
+  int owner(const std::string_view key) const {
+    return owner_of_hash(detail::string_hash(key));
+  }
+
+  bool is_mine(const std::string_view key) const {
+    return owner(key) == m_comm.rank();
+  }
+
+  typename ygm::ygm_ptr<self_type> get_ygm_ptr() const { return pthis; }
+
+  ygm::comm &comm() { return m_comm; }
+
+  const mapped_type &default_value() const { return m_default_value; }
+
+ private:
+  // Same placement as hash_partitioner<std::string>
+  int owner_of_hash(const size_t hash) const { return hash % m_comm.size(); }
+
+  size_t local_intern(const key_type &key, const size_t hash) {
+    auto [id, added] = m_arena.insert(key, hash);
+    if (added) {
+      m_values.push_back(m_default_value);
+    }
+    return id;
+  }
+
+  template <typename Function, typename... VisitorArgs>
+  void local_visit(const key_type &key, const size_t id, Function &fn,
+                   const VisitorArgs &...args) {
+    ygm::detail::interrupt_mask mask(m_comm);
+
+    if constexpr (std::is_invocable<decltype(fn), const key_type &,
+                                    mapped_type &, VisitorArgs &...>() ||
+                  std::is_invocable<decltype(fn), ptr_type, const key_type &,
+                                    mapped_type &, VisitorArgs &...>()) {
+      ygm::meta::apply_optional(
+          fn, std::make_tuple(pthis),
+          std::forward_as_tuple(key, m_values[id], args...));
+    } else {
+      static_assert(ygm::detail::always_false<>,
+                    "remote string_map lambda signature must be invocable "
+                    "with (const std::string &, mapped_type&, ...) or "
+                    "(ptr_type, const std::string &, mapped_type&, ...) "
+                    "signatures");
+    }
+  }
+
+  mapped_type              m_default_value;
+  detail::string_arena     m_arena;
+  std::vector<mapped_type> m_values;
+  ygm::comm               &m_comm;
+  ptr_type                 pthis;
+  ygm::routing_type        m_routing = ygm::routing_type::DEFAULT;
+
+  ygm::detail::memory_tracker m_memory{
+      m_comm.memory_sources(), "string_map",
+      [this]() { return local_memory_bytes(); }};
+};
+
+}  // namespace ygm::container
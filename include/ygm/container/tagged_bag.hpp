@@ -29,7 +29,9 @@ class tagged_bag {
   tagged_bag(ygm::comm &comm)
       : m_next_tag(tag_type(comm.rank()) << TAG_BITS),
         m_tagged_bag(ygm::container::map<tag_type, value_type>(comm)),
-        pthis(this) {}
+        pthis(this) {
+    m_tagged_bag.set_memory_name("tagged_bag");
+  }
   ~tagged_bag() = default;
 
   tag_type async_insert(const value_type &item) {
@@ -70,6 +72,11 @@ class tagged_bag {
 
   ygm::comm &comm() { return m_tagged_bag.comm(); }
 
+  // Estimated heap bytes held by this rank's items
+  size_t local_memory_bytes() const {
+    return m_tagged_bag.local_memory_bytes();
+  }
+
   // TODO sbromberger 20230626: serialize and deserialize
 
   [[nodiscard]] int owner(const tag_type &tag) const {
@@ -0,0 +1,57 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <ygm/container/detail/topk.hpp>
+#include <ygm/detail/ygm_traits.hpp>
+
+namespace ygm::container {
+
+namespace detail {
+template <typename ForAllTypes>
+struct topk_item {
+  static_assert(ygm::detail::always_false<ForAllTypes>,
+                "topk needs a container iterating items or (key, value)");
+};
+
+template <typename Item>
+struct topk_item<std::tuple<Item>> {
+  using type = Item;
+};
+
+template <typename Key, typename Value>
+struct topk_item<std::tuple<Key, Value>> {
+  using type = std::pair<Key, Value>;
+};
+}  // namespace detail
+
+/**
+ * @brief Collective k best items of any container with for_all, best first
+ * under cfn(a, b), identical on every rank. Items of (key, value) containers
+ * are std::pairs.
+ */
+template <typename Container, typename CompareFunction>
+auto topk(Container &c, const size_t k, CompareFunction cfn) {
+  using item_type =
+      typename detail::topk_item<typename Container::ygm_for_all_types>::type;
+
+  return detail::distributed_topk<item_type>(
+      c.comm(), k, cfn, [&c](auto push) {
+        if constexpr (std::tuple_size_v<
+                          typename Container::ygm_for_all_types> == 2) {
+          c.for_all([&push](const auto &key, const auto &value) {
+            push(item_type(key, value));
+          });
+        } else {
+          c.for_all([&push](const auto &item) { push(item); });
+        }
+      });
+}
+
+}  // namespace ygm::container
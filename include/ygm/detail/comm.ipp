@@ -4,6 +4,7 @@
 // SPDX-License-Identifier: MIT
 
 #pragma once
+#include <ygm/detail/comm_autotune.hpp>
 #include <ygm/detail/meta/functional.hpp>
 #include <ygm/detail/ygm_cereal_archive.hpp>
 
@@ -26,15 +27,22 @@ struct comm::header_t {
 
 inline comm::comm(int *argc, char ***argv)
     : pimpl_if(std::make_shared<detail::mpi_init_finalize>(argc, argv)),
-      m_layout(MPI_COMM_WORLD),
-      m_router(m_layout, config.routing) {
+      config(initial_config(MPI_COMM_WORLD)),
+      m_layout(MPI_COMM_WORLD, config.fake_ranks_per_node),
+      m_router(m_layout, config) {
   // pimpl_if = std::make_shared<detail::mpi_init_finalize>(argc, argv);
   comm_setup(MPI_COMM_WORLD);
 }
 
-inline comm::comm(MPI_Comm mcomm)
-    : m_layout(mcomm), m_router(m_layout, config.routing) {
+inline comm::comm(MPI_Comm mcomm) : comm(mcomm, initial_config(mcomm)) {}
+
+inline comm::comm(MPI_Comm mcomm, const detail::comm_environment &env)
+    : config(env),
+      m_layout(mcomm, config.fake_ranks_per_node),
+      m_router(m_layout, config) {
   pimpl_if.reset();
+  // DEFAULT names the configured routing and cannot be the configuration
+  ASSERT_RELEASE(config.routing != routing_type::DEFAULT);
   int flag(0);
   ASSERT_MPI(MPI_Initialized(&flag));
   if (!flag) {
@@ -43,12 +51,51 @@ inline comm::comm(MPI_Comm mcomm)
   comm_setup(mcomm);
 }
 
+inline comm::comm(comm *parent, int color, int key)
+    : m_comm_async(MPI_COMM_NULL),
+      m_comm_other(parent->split_mpi_comm(color, key)),
+      config(parent->config),
+      m_layout(m_comm_other, parent->m_layout),
+      m_router(m_layout, config),
+      m_root(parent->m_root) {
+  ASSERT_MPI(MPI_Comm_dup(m_comm_other, &m_comm_barrier));
+
+  // Agree on an id that is unused in the root registry of every member
+  m_sub_comm_id              = all_reduce_max(m_root->m_next_sub_comm_id);
+  m_root->m_next_sub_comm_id = m_sub_comm_id + 1;
+
+  m_root->m_sub_comms[m_sub_comm_id] = this;
+
+  int root_rank = m_root->rank();
+  m_root_ranks.resize(m_layout.size());
+  ASSERT_MPI(MPI_Allgather(&root_rank, 1, MPI_INT, m_root_ranks.data(), 1,
+                           MPI_INT, m_comm_other));
+}
+
+/**
+ * @brief Reads settings from the environment, calibrating them first when
+ * YGM_COMM_AUTOTUNE is set
+ */
+inline detail::comm_environment comm::initial_config(MPI_Comm c) {
+  detail::comm_environment env;
+  if (env.autotune) {
+    int flag(0);
+    ASSERT_MPI(MPI_Initialized(&flag));
+    if (!flag) {
+      throw std::runtime_error("YGM::COMM ERROR: MPI not initialized");
+    }
+    env = detail::autotune_comm_environment(c, env, &std::cout);
+  }
+  return env;
+}
+
 inline void comm::comm_setup(MPI_Comm c) {
   ASSERT_MPI(MPI_Comm_dup(c, &m_comm_async));
   ASSERT_MPI(MPI_Comm_dup(c, &m_comm_barrier));
   ASSERT_MPI(MPI_Comm_dup(c, &m_comm_other));
 
   m_vec_send_buffers.resize(m_layout.size());
+  m_adaptive_dest_bytes.resize(m_layout.size());
 
   if (config.welcome) {
     welcome(std::cout);
@@ -60,6 +107,18 @@ inline void comm::comm_setup(MPI_Comm c) {
   }
 }
 
+inline MPI_Comm comm::split_mpi_comm(int color, int key) {
+  barrier();
+  MPI_Comm to_return;
+  ASSERT_MPI(MPI_Comm_split(m_comm_other, color, key, &to_return));
+  return to_return;
+}
+
+inline std::unique_ptr<comm> comm::split(int color, int key) {
+  ASSERT_RELEASE(color >= 0);
+  return std::unique_ptr<comm>(new comm(this, color, key));
+}
+
 inline void comm::welcome(std::ostream &os) {
   static bool already_printed = false;
   if (already_printed) return;
@@ -86,6 +145,29 @@ inline void comm::welcome(std::ostream &os) {
 }
 
 inline void comm::stats_reset() { stats.reset(); }
+
+inline detail::comm_memory_usage comm::memory_usage() const {
+  if (is_sub_comm()) {
+    return m_root->memory_usage();
+  }
+  detail::comm_memory_usage to_return;
+  for (const auto &buffer : m_vec_send_buffers) {
+    to_return.send_buffer_bytes += buffer.capacity();
+  }
+  for (const auto &request : m_send_queue) {
+    to_return.isend_buffer_bytes += request.buffer->capacity();
+  }
+  for (const auto &buffer : m_free_send_buffers) {
+    to_return.isend_buffer_bytes += buffer->capacity();
+  }
+  for (const auto &buffer : m_loopback_queue) {
+    to_return.isend_buffer_bytes += buffer->capacity();
+  }
+  to_return.irecv_buffer_bytes       = m_recv_queue.size() * config.irecv_size;
+  to_return.send_buffer_high_water   = stats.get_send_buffer_high_water();
+  to_return.pending_isend_high_water = stats.get_pending_isend_high_water();
+  return to_return;
+}
 inline void comm::stats_print(const std::string &name, std::ostream &os) {
   std::stringstream sstr;
   sstr << "============== STATS =================\n"
@@ -97,11 +179,17 @@ inline void comm::stats_print(const std::string &name, std::ostream &os) {
        << all_reduce_sum(stats.get_isend_count()) << "\n"
        << "GLOBAL_ISEND_BYTES       = "
        << all_reduce_sum(stats.get_isend_bytes()) << "\n"
+       << "GLOBAL_LOOPBACK_BYTES    = "
+       << all_reduce_sum(stats.get_loopback_bytes()) << "\n"
        << "MAX_WAITSOME_ISEND_IRECV = "
        << all_reduce_max(stats.get_waitsome_isend_irecv_time()) << "\n"
        << "MAX_WAITSOME_IALLREDUCE  = "
        << all_reduce_max(stats.get_waitsome_iallreduce_time()) << "\n"
        << "COUNT_IALLREDUCE         = " << stats.get_iallreduce_count() << "\n"
+       << "MAX_SEND_BUFFER_HWM      = "
+       << all_reduce_max(stats.get_send_buffer_high_water()) << "\n"
+       << "MAX_PENDING_ISEND_HWM    = "
+       << all_reduce_max(stats.get_pending_isend_high_water()) << "\n"
        << "======================================";
 
   if (rank0()) {
@@ -112,9 +200,19 @@ inline void comm::stats_print(const std::string &name, std::ostream &os) {
 inline comm::~comm() {
   barrier();
 
+  if (is_sub_comm()) {
+    m_root->m_sub_comms.erase(m_sub_comm_id);
+    ASSERT_RELEASE(MPI_Comm_free(&m_comm_barrier) == MPI_SUCCESS);
+    ASSERT_RELEASE(MPI_Comm_free(&m_comm_other) == MPI_SUCCESS);
+    return;
+  }
+
+  ASSERT_RELEASE(m_sub_comms.empty());
+
   ASSERT_RELEASE(MPI_Barrier(m_comm_async) == MPI_SUCCESS);
 
   ASSERT_RELEASE(m_send_queue.empty());
+  ASSERT_RELEASE(m_loopback_queue.empty());
   ASSERT_RELEASE(m_send_dest_queue.empty());
   ASSERT_RELEASE(m_send_buffer_bytes == 0);
   ASSERT_RELEASE(m_pending_isend_bytes == 0);
@@ -132,6 +230,13 @@ inline comm::~comm() {
 
 template <typename AsyncFunction, typename... SendArgs>
 inline void comm::async(int dest, AsyncFunction fn, const SendArgs &...args) {
+  async(routing_type::DEFAULT, dest, fn,
+        std::forward<const SendArgs>(args)...);
+}
+
+template <typename AsyncFunction, typename... SendArgs>
+inline void comm::async(const routing_type route, int dest, AsyncFunction fn,
+                        const SendArgs &...args) {
   static_assert(std::is_trivially_copyable<AsyncFunction>::value &&
                     std::is_standard_layout<AsyncFunction>::value,
                 "comm::async() AsyncFunction must be is_trivially_copyable & "
@@ -139,41 +244,107 @@ inline void comm::async(int dest, AsyncFunction fn, const SendArgs &...args) {
   ASSERT_RELEASE(dest < m_layout.size());
   stats.async(dest);
 
+  // Sub-communicator messages always go directly, whatever route is given
+  if (is_sub_comm()) {
+    m_send_count++;
+    m_root->async_sub_comm(m_sub_comm_id, m_root_ranks[dest], fn,
+                           std::forward<const SendArgs>(args)...);
+    return;
+  }
+
   check_if_production_halt_required();
   m_send_count++;
 
-  //
-  //
-  int next_dest = dest;
-  if (config.routing != detail::routing_type::NONE) {
-    // next_dest = next_hop(dest);
-    next_dest = m_router.next_hop(dest);
-  }
+  queue_message(dest, route, [&](std::vector<std::byte> &packed) {
+    return pack_lambda(packed, fn, std::forward<const SendArgs>(args)...);
+  });
+}
+
+/**
+ * @brief Sends a message on behalf of a sub-communicator. Called on the root
+ * comm, with the destination already translated to a root rank.
+ */
+template <typename AsyncFunction, typename... SendArgs>
+inline void comm::async_sub_comm(const uint32_t sub_comm_id, int root_dest,
+                                 AsyncFunction fn, const SendArgs &...args) {
+  ASSERT_DEBUG(!is_sub_comm());
+  check_if_production_halt_required();
+  m_send_count++;
+
+  // Sub-communicator messages are delivered directly so that no rank outside
+  // of the sub-communicator is needed to make progress on them.
+  queue_message(root_dest, routing_type::NONE,
+                [&](std::vector<std::byte> &packed) {
+                  return pack_lambda_sub_comm(
+                      packed, sub_comm_id, fn,
+                      std::forward<const SendArgs>(args)...);
+                });
+}
+
+/**
+ * @brief Appends a message for dest to the send buffer of its next hop along
+ * route, adding a routing header when required.
+ *
+ * Messages carry a header whenever the configured routing is not NONE. A
+ * message following a routing other than the configured one is additionally
+ * marked with route_marker(), placed before the header when the configured
+ * routing is NONE and after it otherwise.
+ *
+ * @param pack_fn Serializes the message body into the given buffer and
+ * returns the number of bytes written
+ */
+template <typename PackFunction>
+inline void comm::queue_message(const int dest, const routing_type route,
+                                PackFunction pack_fn) {
+  const bool adaptive = route == routing_type::ADAPTIVE ||
+                        (route == routing_type::DEFAULT &&
+                         config.routing == routing_type::ADAPTIVE);
+  const routing_type resolved  = resolve_route(dest, route);
+  const int          next_dest = m_router.next_hop(dest, resolved);
+
+  const bool has_header =
+      config.routing != routing_type::NONE || resolved != routing_type::NONE;
+  const bool marked = resolved != routing_type::NONE &&
+                      resolved != m_router.default_route();
+
+  std::vector<std::byte> &send_buff = m_vec_send_buffers[next_dest];
 
   //
   // add data to the to dest buffer
-  if (m_vec_send_buffers[next_dest].empty()) {
+  if (send_buff.empty()) {
     m_send_dest_queue.push_back(next_dest);
-    m_vec_send_buffers[next_dest].reserve(config.buffer_size /
-                                          m_layout.node_size());
+    send_buff.reserve(config.buffer_size / m_layout.node_size());
   }
 
-  // // Add header without message size
   size_t header_bytes = 0;
-  if (config.routing != detail::routing_type::NONE) {
-    header_bytes = pack_header(m_vec_send_buffers[next_dest], dest, 0);
-    m_send_buffer_bytes += header_bytes;
+  if (marked && config.routing == routing_type::NONE) {
+    header_bytes += pack_marker(send_buff, resolved);
   }
 
-  uint32_t bytes = pack_lambda(m_vec_send_buffers[next_dest], fn,
-                               std::forward<const SendArgs>(args)...);
-  m_send_buffer_bytes += bytes;
+  // // Add header without message size
+  size_t header_offset = send_buff.size();
+  if (has_header) {
+    header_bytes += pack_header(send_buff, dest, 0);
+  }
+
+  size_t body_bytes = 0;
+  if (marked && config.routing != routing_type::NONE) {
+    body_bytes += pack_marker(send_buff, resolved);
+  }
+
+  uint32_t bytes = pack_fn(send_buff) + body_bytes;
+  m_send_buffer_bytes += header_bytes + bytes;
+  stats.send_buffer_bytes(m_send_buffer_bytes);
 
   // // Add message size to header
-  if (config.routing != detail::routing_type::NONE) {
-    auto iter = m_vec_send_buffers[next_dest].end();
-    iter -= (header_bytes + bytes);
-    std::memcpy(&*iter, &bytes, sizeof(header_t::dest));
+  if (has_header) {
+    std::memcpy(send_buff.data() + header_offset, &bytes,
+                sizeof(header_t::message_size));
+  }
+
+  if (adaptive) {
+    m_adaptive_dest_bytes[dest] += bytes;
+    m_adaptive_total_bytes += bytes;
   }
 
   //
@@ -183,6 +354,35 @@ inline void comm::async(int dest, AsyncFunction fn, const SendArgs &...args) {
   }
 }
 
+/**
+ * @brief Replaces routing_type::DEFAULT and routing_type::ADAPTIVE by the
+ * routing a message to dest should take.
+ *
+ * Adaptive routing sends directly when dest's share of the adaptive traffic is
+ * expected to fill at least config.adaptive_direct_bytes of a send buffer
+ * before it is flushed, and aggregates through NLNR otherwise.
+ */
+inline routing_type comm::resolve_route(const int          dest,
+                                        const routing_type route) {
+  if (route == routing_type::DEFAULT) {
+    return resolve_route(dest, config.routing);
+  }
+  if (route != routing_type::ADAPTIVE) {
+    return route;
+  }
+  if (m_layout.is_local(dest)) {
+    return routing_type::NONE;
+  }
+  // Direct buffer fill ~ buffer_size * (dest_bytes / total_bytes)
+  const double expected_fill =
+      m_adaptive_total_bytes == 0
+          ? 0.0
+          : double(config.buffer_size) * m_adaptive_dest_bytes[dest] /
+                m_adaptive_total_bytes;
+  return expected_fill >= config.adaptive_direct_bytes ? routing_type::NONE
+                                                       : routing_type::NLNR;
+}
+
 template <typename AsyncFunction, typename... SendArgs>
 inline void comm::async_bcast(AsyncFunction fn, const SendArgs &...args) {
   static_assert(
@@ -190,6 +390,13 @@ inline void comm::async_bcast(AsyncFunction fn, const SendArgs &...args) {
           std::is_standard_layout<AsyncFunction>::value,
       "comm::async_bcast() AsyncFunction must be is_trivially_copyable & "
       "is_standard_layout.");
+  if (is_sub_comm()) {
+    for (int dest = 0; dest < size(); ++dest) {
+      async(dest, fn, std::forward<const SendArgs>(args)...);
+    }
+    return;
+  }
+
   check_if_production_halt_required();
 
   pack_lambda_broadcast(fn, std::forward<const SendArgs>(args)...);
@@ -243,7 +450,17 @@ inline void comm::barrier() {
     }
   }
   ASSERT_RELEASE(m_pre_barrier_callbacks.empty());
-  ASSERT_RELEASE(m_send_dest_queue.empty());
+  ASSERT_RELEASE(m_root->m_send_dest_queue.empty());
+
+  // Decay adaptive routing history so that it follows changing traffic
+  if (m_root->m_adaptive_total_bytes > 0) {
+    for (auto &bytes : m_root->m_adaptive_dest_bytes) {
+      bytes /= 2;
+    }
+    m_root->m_adaptive_total_bytes /= 2;
+  }
+
+  ++m_barrier_epoch;
 }
 
 /**
@@ -442,6 +659,15 @@ inline std::string comm::outstr(Args &&...args) const {
   return ss.str();
 }
 
+inline size_t comm::pack_marker(std::vector<std::byte> &packed,
+                                const routing_type      route) {
+  const uint16_t marker      = route_marker(route);
+  size_t         size_before = packed.size();
+  packed.resize(size_before + sizeof(marker));
+  std::memcpy(packed.data() + size_before, &marker, sizeof(marker));
+  return sizeof(marker);
+}
+
 inline size_t comm::pack_header(std::vector<std::byte> &packed, const int dest,
                                 size_t size) {
   size_t size_before = packed.size();
@@ -463,8 +689,9 @@ inline std::pair<uint64_t, uint64_t> comm::barrier_reduce_counts() {
   uint64_t local_counts[2]  = {m_recv_count, m_send_count};
   uint64_t global_counts[2] = {0, 0};
 
-  ASSERT_RELEASE(m_pending_isend_bytes == 0);
-  ASSERT_RELEASE(m_send_buffer_bytes == 0);
+  ASSERT_RELEASE(m_root->m_pending_isend_bytes == 0);
+  ASSERT_RELEASE(m_root->m_send_buffer_bytes == 0);
+  ASSERT_RELEASE(m_root->m_loopback_queue.empty());
 
   MPI_Request req = MPI_REQUEST_NULL;
   ASSERT_MPI(MPI_Iallreduce(local_counts, global_counts, 2, MPI_UINT64_T,
@@ -474,7 +701,7 @@ inline std::pair<uint64_t, uint64_t> comm::barrier_reduce_counts() {
   while (!iallreduce_complete) {
     MPI_Request twin_req[2];
     twin_req[0] = req;
-    twin_req[1] = m_recv_queue.front().request;
+    twin_req[1] = m_root->m_recv_queue.front().request;
 
     int        outcount;
     int        twin_indices[2];
@@ -492,9 +719,9 @@ inline std::pair<uint64_t, uint64_t> comm::barrier_reduce_counts() {
         // std::cout << m_layout.rank() << ": iallreduce_complete: " <<
         // global_counts[0] << " " << global_counts[1] << std::endl;
       } else {
-        mpi_irecv_request req_buffer = m_recv_queue.front();
-        m_recv_queue.pop_front();
-        handle_next_receive(twin_status[i], req_buffer.buffer);
+        mpi_irecv_request req_buffer = m_root->m_recv_queue.front();
+        m_root->m_recv_queue.pop_front();
+        m_root->handle_next_receive(twin_status[i], req_buffer.buffer);
         flush_all_local_and_process_incoming();
       }
     }
@@ -518,6 +745,16 @@ inline void comm::flush_send_buffer(int dest) {
       m_free_send_buffers.pop_back();
     }
     request.buffer->swap(m_vec_send_buffers[dest]);
+    if (dest == m_layout.rank()) {
+      // Hand buffers for this rank over by pointer instead of through MPI
+      stats.loopback(request.buffer->size());
+      m_send_buffer_bytes -= request.buffer->size();
+      m_loopback_queue.push_back(request.buffer);
+      if (!m_in_process_receive_queue) {
+        process_receive_queue();
+      }
+      return;
+    }
     if (config.freq_issend > 0 && counter++ % config.freq_issend == 0) {
       ASSERT_MPI(MPI_Issend(request.buffer->data(), request.buffer->size(),
                             MPI_BYTE, dest, 0, m_comm_async,
@@ -530,6 +767,7 @@ inline void comm::flush_send_buffer(int dest) {
     stats.isend(dest, request.buffer->size());
     m_pending_isend_bytes += request.buffer->size();
     m_send_buffer_bytes -= request.buffer->size();
+    stats.pending_isend_bytes(m_pending_isend_bytes);
     m_send_queue.push_back(request);
     if (!m_in_process_receive_queue) {
       process_receive_queue();
@@ -549,6 +787,10 @@ inline void comm::check_if_production_halt_required() {
  * one buffer.
  */
 inline void comm::local_progress() {
+  if (is_sub_comm()) {
+    m_root->local_progress();
+    return;
+  }
   if (not m_in_process_receive_queue) {
     process_receive_queue();
   }
@@ -577,10 +819,14 @@ inline void comm::local_wait_until(Function fn) {
  * Notifies any registered barrier watchers.
  */
 inline void comm::flush_all_local_and_process_incoming() {
+  // Pre-barrier callbacks belong to this comm, while buffers and the receive
+  // queue belong to the root comm.
+  comm *root = m_root;
+
   // Keep flushing until all local work is complete
   bool did_something = true;
   while (did_something) {
-    did_something = process_receive_queue();
+    did_something = root->process_receive_queue();
     //
     //  Notify registered barrier watchers
     while (!m_pre_barrier_callbacks.empty()) {
@@ -592,18 +838,18 @@ inline void comm::flush_all_local_and_process_incoming() {
 
     //
     //  Flush each send buffer
-    while (!m_send_dest_queue.empty()) {
+    while (!root->m_send_dest_queue.empty()) {
       did_something = true;
-      int dest      = m_send_dest_queue.front();
-      m_send_dest_queue.pop_front();
-      flush_send_buffer(dest);
-      process_receive_queue();
+      int dest      = root->m_send_dest_queue.front();
+      root->m_send_dest_queue.pop_front();
+      root->flush_send_buffer(dest);
+      root->process_receive_queue();
     }
 
     //
     // Wait on isends
-    while (!m_send_queue.empty()) {
-      did_something |= process_receive_queue();
+    while (!root->m_send_queue.empty()) {
+      did_something |= root->process_receive_queue();
     }
   }
 }
@@ -663,6 +909,41 @@ inline size_t comm::pack_lambda(std::vector<std::byte> &packed, Lambda l,
                              std::forward<const PackArgs>(args)...);
 }
 
+/**
+ * @brief Packs a lambda addressed to a sub-communicator. The sub-communicator
+ * id travels with the arguments, and the receiving root comm dispatches the
+ * lambda with a pointer to its matching sub-communicator.
+ */
+template <typename Lambda, typename... PackArgs>
+inline size_t comm::pack_lambda_sub_comm(std::vector<std::byte> &packed,
+                                         const uint32_t sub_comm_id, Lambda l,
+                                         const PackArgs &...args) {
+  auto dispatch_lambda = [](comm *c, cereal::YGMInputArchive *bia, Lambda l) {
+    Lambda *pl = nullptr;
+    size_t  l_storage[sizeof(Lambda) / sizeof(size_t) +
+                     (sizeof(Lambda) % sizeof(size_t) > 0)];
+    if constexpr (!std::is_empty<Lambda>::value) {
+      bia->loadBinary(l_storage, sizeof(Lambda));
+      pl = (Lambda *)l_storage;
+    }
+
+    std::tuple<uint32_t, std::tuple<PackArgs...>> ta;
+    (*bia)(ta);
+
+    comm *sub_comm = c->m_sub_comms.at(std::get<0>(ta));
+    sub_comm->m_recv_count++;
+    sub_comm->stats.rpc_execute();
+
+    auto t1 = std::make_tuple((comm *)sub_comm);
+
+    ygm::meta::apply_optional(*pl, std::move(t1),
+                              std::get<1>(std::move(ta)));
+  };
+
+  return pack_lambda_generic(packed, l, dispatch_lambda, sub_comm_id,
+                             std::tuple<PackArgs...>(args...));
+}
+
 template <typename Lambda, typename... PackArgs>
 inline void comm::pack_lambda_broadcast(Lambda l, const PackArgs &...args) {
   const std::tuple<PackArgs...> tuple_args(
@@ -845,7 +1126,7 @@ inline void comm::queue_message_bytes(const std::vector<std::byte> &packed,
   // Add dummy header with dest of -1 and size of 0.
   // This is to avoid peeling off and replacing the dest as messages are
   // forwarded in a bcast
-  if (config.routing != detail::routing_type::NONE) {
+  if (config.routing != routing_type::NONE) {
     size_t header_bytes = pack_header(send_buff, -1, 0);
     m_send_buffer_bytes += header_bytes;
   }
@@ -855,6 +1136,7 @@ inline void comm::queue_message_bytes(const std::vector<std::byte> &packed,
   std::memcpy(send_buff.data() + size_before, packed.data(), packed.size());
 
   m_send_buffer_bytes += packed.size();
+  stats.send_buffer_bytes(m_send_buffer_bytes);
 }
 
 inline void comm::handle_next_receive(MPI_Status                   status,
@@ -862,46 +1144,114 @@ inline void comm::handle_next_receive(MPI_Status                   status,
   int count{0};
   ASSERT_MPI(MPI_Get_count(&status, MPI_BYTE, &count));
   stats.irecv(status.MPI_SOURCE, count);
-  cereal::YGMInputArchive iarchive(buffer.get(), count);
+  handle_received_bytes(buffer.get(), count);
+  post_new_irecv(buffer);
+  flush_to_capacity();
+}
+
+/**
+ * @brief Executes or forwards every message in a received buffer
+ */
+inline void comm::handle_received_bytes(std::byte *data, int count) {
+  cereal::YGMInputArchive iarchive(data, count);
   while (!iarchive.empty()) {
-    if (config.routing != detail::routing_type::NONE) {
+    if (config.routing != routing_type::NONE) {
       header_t h;
       iarchive.loadBinary(&h, sizeof(header_t));
       if (h.dest == m_layout.rank() || (h.dest == -1 && h.message_size == 0)) {
         uint16_t lid;
         iarchive.loadBinary(&lid, sizeof(lid));
+        if (is_route_marker(lid)) {
+          iarchive.loadBinary(&lid, sizeof(lid));
+        }
         m_lambda_map.execute(lid, this, &iarchive);
         m_recv_count++;
         stats.rpc_execute();
       } else {
-        int next_dest = m_router.next_hop(h.dest);
-
-        if (m_vec_send_buffers[next_dest].empty()) {
-          m_send_dest_queue.push_back(next_dest);
-        }
-
-        size_t header_bytes =
-            pack_header(m_vec_send_buffers[next_dest], h.dest, h.message_size);
-        m_send_buffer_bytes += header_bytes;
-
-        size_t precopy_size = m_vec_send_buffers[next_dest].size();
-        m_vec_send_buffers[next_dest].resize(precopy_size + h.message_size);
-        iarchive.loadBinary(&m_vec_send_buffers[next_dest][precopy_size],
-                            h.message_size);
-
-        m_send_buffer_bytes += h.message_size;
-
-        flush_to_capacity();
+        forward_message(h, m_router.default_route(), iarchive);
       }
     } else {
       uint16_t lid;
       iarchive.loadBinary(&lid, sizeof(lid));
+      if (is_route_marker(lid)) {
+        // Routed message sent through an unrouted communicator
+        auto     route = static_cast<routing_type>(lid - route_marker_base);
+        header_t h;
+        iarchive.loadBinary(&h, sizeof(header_t));
+        if (h.dest != m_layout.rank()) {
+          forward_message(h, route, iarchive);
+          continue;
+        }
+        iarchive.loadBinary(&lid, sizeof(lid));
+      }
       m_lambda_map.execute(lid, this, &iarchive);
       m_recv_count++;
       stats.rpc_execute();
     }
   }
-  post_new_irecv(buffer);
+}
+
+/**
+ * @brief Processes send buffers this rank addressed to itself. Emptied buffers
+ * are recycled as send buffers.
+ *
+ * @return True if the loopback queue was non-empty, else false
+ */
+inline bool comm::process_loopback_queue() {
+  bool received_to_return = false;
+  while (!m_loopback_queue.empty()) {
+    received_to_return = true;
+    auto buffer        = m_loopback_queue.front();
+    m_loopback_queue.pop_front();
+    handle_received_bytes(buffer->data(), buffer->size());
+    buffer->clear();
+    m_free_send_buffers.push_back(buffer);
+    flush_to_capacity();
+  }
+  return received_to_return;
+}
+
+/**
+ * @brief Forwards the body of a received message towards h.dest.
+ *
+ * @param route Routing of the message unless its body starts with a route
+ * marker
+ */
+inline void comm::forward_message(const header_t &h, routing_type route,
+                                  cereal::YGMInputArchive &iarchive) {
+  // With a routed configuration the marker, if any, leads the body
+  uint16_t lead       = 0;
+  size_t   lead_bytes = 0;
+  if (config.routing != routing_type::NONE) {
+    iarchive.loadBinary(&lead, sizeof(lead));
+    lead_bytes = sizeof(lead);
+    if (is_route_marker(lead)) {
+      route = static_cast<routing_type>(lead - route_marker_base);
+    }
+  }
+
+  int next_dest = m_router.next_hop(h.dest, route);
+  stats.routing();
+
+  std::vector<std::byte> &send_buff = m_vec_send_buffers[next_dest];
+  if (send_buff.empty()) {
+    m_send_dest_queue.push_back(next_dest);
+  }
+
+  if (config.routing == routing_type::NONE) {
+    m_send_buffer_bytes += pack_marker(send_buff, route);
+  }
+  m_send_buffer_bytes += pack_header(send_buff, h.dest, h.message_size);
+
+  size_t precopy_size = send_buff.size();
+  send_buff.resize(precopy_size + h.message_size);
+  std::memcpy(&send_buff[precopy_size], &lead, lead_bytes);
+  iarchive.loadBinary(&send_buff[precopy_size + lead_bytes],
+                      h.message_size - lead_bytes);
+
+  m_send_buffer_bytes += h.message_size;
+  stats.send_buffer_bytes(m_send_buffer_bytes);
+
   flush_to_capacity();
 }
 
@@ -963,14 +1313,17 @@ inline bool comm::process_receive_queue() {
     }
   }
 
-  received_to_return != local_process_incoming();
+  received_to_return |= local_process_incoming();
 
   m_in_process_receive_queue = false;
   return received_to_return;
 }
 
 inline bool comm::local_process_incoming() {
-  bool received_to_return = false;
+  if (is_sub_comm()) {
+    return m_root->local_process_incoming();
+  }
+  bool received_to_return = process_loopback_queue();
 
   while (true) {
     int        flag(0);
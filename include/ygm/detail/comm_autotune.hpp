@@ -0,0 +1,119 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <ostream>
+#include <vector>
+#include <ygm/detail/comm_environment.hpp>
+#include <ygm/detail/layout.hpp>
+
+namespace ygm::detail {
+
+/**
+ * @brief Measures the global message rate of an all-to-all probe run by a
+ * temporary comm using the given settings
+ *
+ * @param mcomm Communicator to probe, collectively
+ * @param num_messages Messages sent by each rank
+ * @return Messages delivered per second, identical on all ranks
+ */
+inline double measure_message_rate(MPI_Comm mcomm, const comm_environment &env,
+                                   const size_t num_messages) {
+  // Probe messages are tiny, so receive buffers only need to hold one full
+  // send buffer rather than the configured irecv_size
+  comm_environment probe_env = env;
+  probe_env.irecv_size       = std::min(env.irecv_size, 2 * env.buffer_size);
+  probe_env.welcome          = false;
+  ygm::comm world(mcomm, probe_env);
+
+  auto probe = [](const uint64_t &payload) {};
+
+  // Untimed warm-up round to allocate buffers
+  for (int i = 0; i < world.size(); ++i) {
+    world.async((world.rank() + i) % world.size(), probe, uint64_t(i));
+  }
+  world.barrier();
+
+  world.cf_barrier();
+  double start = MPI_Wtime();
+  for (size_t i = 0; i < num_messages; ++i) {
+    world.async((world.rank() + i) % world.size(), probe, uint64_t(i));
+  }
+  world.barrier();
+  double elapsed = world.all_reduce_max(MPI_Wtime() - start);
+
+  return double(num_messages) * world.size() / elapsed;
+}
+
+/**
+ * @brief Picks comm buffer settings and routing for mcomm by measuring the
+ * message rate of short all-to-all probes.
+ *
+ * Parameters are tuned one at a time, starting from base, keeping the best
+ * value of each before moving to the next. Every candidate and its measured
+ * rate is written to report on rank 0.
+ *
+ * @return base with the tuned settings applied
+ */
+inline comm_environment autotune_comm_environment(MPI_Comm                mcomm,
+                                                  const comm_environment &base,
+                                                  std::ostream *report) {
+  comm_environment best = base;
+  best.autotune         = false;
+
+  int rank;
+  ASSERT_MPI(MPI_Comm_rank(mcomm, &rank));
+  const bool print = report != nullptr && rank == 0;
+
+  double best_rate =
+      measure_message_rate(mcomm, best, best.autotune_messages);
+  if (print) {
+    *report << "YGM_COMM_AUTOTUNE baseline: " << best_rate << " msgs/sec\n";
+  }
+
+  auto tune = [&](const char *name, const std::vector<std::string> &values) {
+    comm_environment start = best;
+    for (const auto &value : values) {
+      comm_environment candidate = start;
+      candidate.set(name, value.c_str());
+      double rate =
+          measure_message_rate(mcomm, candidate, best.autotune_messages);
+      if (print) {
+        *report << "YGM_COMM_AUTOTUNE " << name << " = " << value << ": "
+                << rate << " msgs/sec\n";
+      }
+      if (rate > best_rate) {
+        best_rate = rate;
+        best      = candidate;
+      }
+    }
+  };
+
+  tune("YGM_COMM_BUFFER_SIZE_KB", {"256", "1024", "4096", "16384"});
+  tune("YGM_COMM_NUM_ISENDS_WAIT", {"1", "4", "16"});
+  tune("YGM_COMM_ISSEND_FREQ", {"0", "8", "64"});
+  tune("YGM_COMM_NUM_IRECVS", {"4", "8", "16"});
+
+  // Routing only matters across nodes
+  layout l(mcomm, base.fake_ranks_per_node);
+  if (l.node_size() > 1) {
+    std::vector<std::string> routings{"NONE", "NR", "NLNR"};
+    if (!base.routing_levels.empty()) {
+      routings.push_back("HIER");
+    }
+    tune("YGM_COMM_ROUTING", routings);
+  }
+
+  if (print) {
+    *report << "YGM_COMM_AUTOTUNE selected: " << best_rate << " msgs/sec\n";
+    best.write_file(*report);
+  }
+  return best;
+}
+
+}  // namespace ygm::detail
@@ -6,20 +6,59 @@
 #pragma once
 
 #include <cstdlib>
+#include <fstream>
 #include <iostream>
+#include <mpi.h>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 namespace ygm {
 
 namespace detail {
 
-enum class routing_type { NONE, NR, NLNR };
+// ADAPTIVE chooses between NONE and NLNR per destination from observed send
+// volume. DEFAULT is only used to request the communicator's configured
+// routing from per-call or per-container overrides.
+enum class routing_type { NONE, NR, NLNR, HIER, ADAPTIVE, DEFAULT };
+
+inline std::string routing_to_string(const routing_type route) {
+  switch (route) {
+    case routing_type::NONE:
+      return "NONE";
+    case routing_type::NR:
+      return "NR";
+    case routing_type::NLNR:
+      return "NLNR";
+    case routing_type::HIER:
+      return "HIER";
+    case routing_type::ADAPTIVE:
+      return "ADAPTIVE";
+    case routing_type::DEFAULT:
+      return "DEFAULT";
+  }
+  return "UNKNOWN";
+}
+
+inline routing_type routing_from_string(const std::string& str) {
+  for (auto route : {routing_type::NONE, routing_type::NR, routing_type::NLNR,
+                     routing_type::HIER, routing_type::ADAPTIVE}) {
+    if (str == routing_to_string(route)) {
+      return route;
+    }
+  }
+  throw std::runtime_error("comm_enviornment -- unknown routing type");
+}
 
 /**
  * @brief Configuration enviornment for ygm::comm.
  *
- * @todo Add support for a ".ygm" file and YGM_CONFIG_FILE.
+ * Settings are read from the file named by YGM_CONFIG_FILE, which must exist,
+ * or else from ".ygm" in the working directory if present, and then from
+ * environment variables of the same names, which take precedence. Config
+ * files hold one "NAME = VALUE" setting per line; blank lines and lines
+ * starting with '#' are ignored.
  */
 class comm_environment {
   /**
@@ -34,37 +73,151 @@ class comm_environment {
     return to_return;
   }
 
+  /**
+   * @brief Converts comma separated char* to vector of type T
+   */
+  template <typename T>
+  std::vector<T> convert_list(const char* str) {
+    std::vector<T>    to_return;
+    std::stringstream sstr(str);
+    std::string       item;
+    while (std::getline(sstr, item, ',')) {
+      if (!item.empty()) {
+        to_return.push_back(convert<T>(item.c_str()));
+      }
+    }
+    return to_return;
+  }
+
+  // Rank in MPI_COMM_WORLD, or 0 before MPI is initialized
+  static int world_rank() {
+    int flag(0);
+    MPI_Initialized(&flag);
+    int rank(0);
+    if (flag) {
+      MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    }
+    return rank;
+  }
+
+  static std::string trim(const std::string& str) {
+    const char* ws    = " \t\r\n";
+    size_t      begin = str.find_first_not_of(ws);
+    if (begin == std::string::npos) {
+      return "";
+    }
+    return str.substr(begin, str.find_last_not_of(ws) - begin + 1);
+  }
+
  public:
   comm_environment() {
-    if (const char* cc = std::getenv("YGM_COMM_BUFFER_SIZE_KB")) {
-      buffer_size = convert<size_t>(cc) * 1024;
-    }
-    if (const char* cc = std::getenv("YGM_COMM_NUM_IRECVS")) {
-      num_irecvs = convert<size_t>(cc);
+    if (const char* cc = std::getenv("YGM_CONFIG_FILE")) {
+      load_file(cc);
+    } else {
+      load_file(".ygm", false);
     }
-    if (const char* cc = std::getenv("YGM_COMM_IRECV_SIZE_KB")) {
-      irecv_size = convert<size_t>(cc) * 1024;
+
+    for (const char* name : setting_names) {
+      if (const char* cc = std::getenv(name)) {
+        set(name, cc);
+      }
     }
-    if (const char* cc = std::getenv("YGM_COMM_WELCOME")) {
-      welcome = convert<bool>(cc);
+  }
+
+  /**
+   * @brief Applies one setting by its environment variable name
+   *
+   * @return False if name is not a known setting
+   */
+  bool set(const std::string& name, const char* value) {
+    if (name == "YGM_COMM_BUFFER_SIZE_KB") {
+      buffer_size = convert<size_t>(value) * 1024;
+    } else if (name == "YGM_COMM_NUM_IRECVS") {
+      num_irecvs = convert<size_t>(value);
+    } else if (name == "YGM_COMM_IRECV_SIZE_KB") {
+      irecv_size = convert<size_t>(value) * 1024;
+    } else if (name == "YGM_COMM_WELCOME") {
+      welcome = convert<bool>(value);
+    } else if (name == "YGM_COMM_NUM_ISENDS_WAIT") {
+      num_isends_wait = convert<size_t>(value);
+    } else if (name == "YGM_COMM_ISSEND_FREQ") {
+      freq_issend = convert<size_t>(value);
+    } else if (name == "YGM_COMM_ROUTING") {
+      routing = routing_from_string(value);
+    } else if (name == "YGM_COMM_ADAPTIVE_DIRECT_KB") {
+      adaptive_direct_bytes = convert<size_t>(value) * 1024;
+    } else if (name == "YGM_COMM_ROUTING_LEVELS") {
+      routing_levels = convert_list<size_t>(value);
+    } else if (name == "YGM_COMM_RANKS_PER_SOCKET") {
+      ranks_per_socket = convert<size_t>(value);
+    } else if (name == "YGM_FAKE_RANKS_PER_NODE") {
+      fake_ranks_per_node = convert<size_t>(value);
+    } else if (name == "YGM_COMM_AUTOTUNE") {
+      autotune = convert<bool>(value);
+    } else if (name == "YGM_COMM_AUTOTUNE_MESSAGES") {
+      autotune_messages = convert<size_t>(value);
+    } else {
+      return false;
     }
-    if (const char* cc = std::getenv("YGM_COMM_NUM_ISENDS_WAIT")) {
-      num_isends_wait = convert<size_t>(cc);
+    return true;
+  }
+
+  /**
+   * @brief Applies the settings of a config file
+   *
+   * @param required Throw if the file is missing or has a line that is not a
+   * known setting. Otherwise a missing file is ignored and bad lines are
+   * skipped with a warning on rank 0.
+   */
+  void load_file(const std::string& fname, const bool required = true) {
+    std::ifstream ifs(fname);
+    if (!ifs && required) {
+      throw std::runtime_error("comm_enviornment -- cannot open config file " +
+                               fname);
     }
-    if (const char* cc = std::getenv("YGM_COMM_ISSEND_FREQ")) {
-      freq_issend = convert<size_t>(cc);
+    std::string line;
+    while (std::getline(ifs, line)) {
+      line = trim(line);
+      if (line.empty() || line[0] == '#') {
+        continue;
+      }
+      size_t eq = line.find('=');
+      if (eq == std::string::npos ||
+          !set(trim(line.substr(0, eq)), trim(line.substr(eq + 1)).c_str())) {
+        if (required) {
+          throw std::runtime_error("comm_enviornment -- bad line in " + fname +
+                                   ": " + line);
+        }
+        if (world_rank() == 0) {
+          std::cerr << "YGM WARNING: ignoring bad line in " << fname << ": "
+                    << line << std::endl;
+        }
+      }
     }
-    if (const char* cc = std::getenv("YGM_COMM_ROUTING")) {
-      if (std::string(cc) == "NONE") {
-        routing = routing_type::NONE;
-      } else if (std::string(cc) == "NR") {
-        routing = routing_type::NR;
-      } else if (std::string(cc) == "NLNR") {
-        routing = routing_type::NLNR;
-      } else {
-        throw std::runtime_error("comm_enviornment -- unknown routing type");
+  }
+
+  /**
+   * @brief Writes the communication settings in config file format
+   */
+  void write_file(std::ostream& os) const {
+    os << "# ygm::comm settings\n"
+       << "YGM_COMM_BUFFER_SIZE_KB = " << buffer_size / 1024 << "\n"
+       << "YGM_COMM_NUM_IRECVS = " << num_irecvs << "\n"
+       << "YGM_COMM_IRECV_SIZE_KB = " << irecv_size / 1024 << "\n"
+       << "YGM_COMM_NUM_ISENDS_WAIT = " << num_isends_wait << "\n"
+       << "YGM_COMM_ISSEND_FREQ = " << freq_issend << "\n"
+       << "YGM_COMM_ROUTING = " << routing_to_string(routing) << "\n"
+       << "YGM_COMM_ADAPTIVE_DIRECT_KB = " << adaptive_direct_bytes / 1024
+       << "\n";
+    if (!routing_levels.empty()) {
+      os << "YGM_COMM_ROUTING_LEVELS = ";
+      for (size_t i = 0; i < routing_levels.size(); ++i) {
+        os << (i > 0 ? "," : "") << routing_levels[i];
       }
+      os << "\n";
     }
+    os << "YGM_COMM_RANKS_PER_SOCKET = " << ranks_per_socket << "\n"
+       << "YGM_FAKE_RANKS_PER_NODE = " << fake_ranks_per_node << "\n";
   }
 
   void print(std::ostream& os = std::cout) const {
@@ -74,18 +227,17 @@ class comm_environment {
        << "YGM_COMM_IRECVS_SIZE_KB  = " << irecv_size / 1024 << "\n"
        << "YGM_COMM_NUM_ISENDS_WAIT = " << num_isends_wait << "\n"
        << "YGM_COMM_ISSEND_FREQ     = " << freq_issend << "\n"
-       << "YGM_COMM_ROUTING         = ";
-    switch (routing) {
-      case routing_type::NONE:
-        os << "NONE\n";
-        break;
-      case routing_type::NR:
-        os << "NR\n";
-        break;
-      case routing_type::NLNR:
-        os << "NLNR\n";
-        break;
+       << "YGM_COMM_ROUTING         = " << routing_to_string(routing) << "\n";
+    os << "YGM_COMM_ADAPTIVE_DIRECT_KB = " << adaptive_direct_bytes / 1024
+       << "\n";
+    os << "YGM_COMM_ROUTING_LEVELS  = ";
+    for (size_t i = 0; i < routing_levels.size(); ++i) {
+      os << (i > 0 ? "," : "") << routing_levels[i];
     }
+    os << "\n"
+       << "YGM_COMM_RANKS_PER_SOCKET = " << ranks_per_socket << "\n"
+       << "YGM_FAKE_RANKS_PER_NODE  = " << fake_ranks_per_node << "\n"
+       << "YGM_COMM_AUTOTUNE        = " << autotune << "\n";
     os << "======================================\n";
   }
 
@@ -101,7 +253,35 @@ class comm_environment {
 
   routing_type routing = routing_type::NONE;
 
+  // ADAPTIVE routing sends directly to destinations expected to fill at least
+  // this many bytes of a send buffer before it is flushed
+  size_t adaptive_direct_bytes = 64 * 1024;
+
+  // Nodes per group at each routing level above the node, innermost first.
+  // E.g., {8, 4} describes switches of 8 nodes and pods of 4 switches.
+  std::vector<size_t> routing_levels;
+
+  // Ranks per socket for on-node routing; 0 treats the node as one socket
+  size_t ranks_per_socket = 0;
+
+  // Simulate nodes of this many consecutive ranks; 0 uses shared memory
+  size_t fake_ranks_per_node = 0;
+
   bool welcome = false;
+
+  // Calibrate the settings above with all-to-all probes when a comm is built
+  bool   autotune          = false;
+  size_t autotune_messages = 100000;
+
+  // Environment variables read by the constructor
+  static constexpr const char* setting_names[] = {
+      "YGM_COMM_BUFFER_SIZE_KB",     "YGM_COMM_NUM_IRECVS",
+      "YGM_COMM_IRECV_SIZE_KB",      "YGM_COMM_WELCOME",
+      "YGM_COMM_NUM_ISENDS_WAIT",    "YGM_COMM_ISSEND_FREQ",
+      "YGM_COMM_ROUTING",            "YGM_COMM_ADAPTIVE_DIRECT_KB",
+      "YGM_COMM_ROUTING_LEVELS",     "YGM_COMM_RANKS_PER_SOCKET",
+      "YGM_FAKE_RANKS_PER_NODE",     "YGM_COMM_AUTOTUNE",
+      "YGM_COMM_AUTOTUNE_MESSAGES"};
 };
 
 }  // namespace detail
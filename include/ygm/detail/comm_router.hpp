@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <vector>
 #include <ygm/detail/comm_environment.hpp>
 #include <ygm/detail/layout.hpp>
 
@@ -18,7 +19,20 @@ namespace detail {
 class comm_router {
  public:
   comm_router(const layout &l, const routing_type route = routing_type::NONE)
-      : m_layout(l), m_default_route(route) {}
+      : m_layout(l), m_default_route(concrete_route(route)) {}
+
+  comm_router(const layout &l, const comm_environment &config)
+      : m_layout(l),
+        m_default_route(concrete_route(config.routing)),
+        m_ranks_per_socket(config.ranks_per_socket) {
+    // Number of nodes spanned by a group at each level, innermost first.
+    // Level 0 is a single node.
+    for (const auto group_size : config.routing_levels) {
+      if (group_size > 1) {
+        m_level_spans.push_back(m_level_spans.back() * group_size);
+      }
+    }
+  }
 
   /**
    * @brief Calculates the next hop based on the given routing scheme and final
@@ -33,6 +47,9 @@ class comm_router {
    * remote hop, followed by an on-node hop
    * 4. The pairs of remote processes communicating in routing_type::NLNR is a
    * subset of those communicating in routing_type::NR
+   * 5. routing_type::HIER makes at most one remote hop per routing level plus
+   * the node level, followed by at most two on-node hops (socket then rank).
+   * With a single level this matches routing_type::NR.
    */
   int next_hop(const int dest, const routing_type route) const {
     int to_return;
@@ -65,6 +82,21 @@ class comm_router {
           }
         }
         break;
+      case routing_type::HIER:
+        if (m_layout.is_local(dest)) {
+          to_return = hier_local_hop(dest);
+        } else {
+          to_return = m_layout.strided_ranks()[hier_node_hop(
+              m_layout.node_id(), m_layout.node_id(dest))];
+        }
+        break;
+      case routing_type::ADAPTIVE:
+        // Adaptive routes are resolved by comm; forward them as NLNR
+        to_return = next_hop(dest, routing_type::NLNR);
+        break;
+      case routing_type::DEFAULT:
+        to_return = next_hop(dest, m_default_route);
+        break;
       default:
         std::cerr << "Unknown routing type" << std::endl;
         return -1;
@@ -75,9 +107,74 @@ class comm_router {
 
   int next_hop(const int dest) const { return next_hop(dest, m_default_route); }
 
+  /**
+   * @brief Routing used for messages without an explicit routing type. Never
+   * routing_type::ADAPTIVE or routing_type::DEFAULT.
+   */
+  routing_type default_route() const { return m_default_route; }
+
+  /**
+   * @brief Number of node levels used by routing_type::HIER, including the
+   * node level itself
+   */
+  size_t num_levels() const { return m_level_spans.size(); }
+
  private:
-  routing_type  m_default_route;
-  const layout &m_layout;
+  static routing_type concrete_route(const routing_type route) {
+    if (route == routing_type::ADAPTIVE) return routing_type::NLNR;
+    if (route == routing_type::DEFAULT) return routing_type::NONE;
+    return route;
+  }
+
+  /**
+   * @brief Picks the node to forward to when moving from my_node towards
+   * dest_node. Node ids are treated as mixed-radix coordinates, one digit per
+   * routing level, and the most significant differing digit is corrected
+   * first while the less significant digits are kept. Each rank therefore only
+   * communicates with the members of its group at each level, and messages
+   * are aggregated at every level they pass through.
+   */
+  int hier_node_hop(const int my_node, const int dest_node) const {
+    const int num_nodes = m_layout.node_size();
+    for (size_t level = m_level_spans.size(); level-- > 0;) {
+      const int span = m_level_spans[level];
+      if (my_node / span != dest_node / span) {
+        const int group_start = (dest_node / span) * span;
+        int       offset      = my_node % span;
+        // The last group at a level may be partially filled
+        if (group_start + offset >= num_nodes) {
+          offset %= num_nodes - group_start;
+        }
+        return group_start + offset;
+      }
+    }
+    return dest_node;
+  }
+
+  /**
+   * @brief On-node hop, crossing sockets before delivering to dest
+   */
+  int hier_local_hop(const int dest) const {
+    if (m_ranks_per_socket == 0) {
+      return dest;
+    }
+    const int my_local   = m_layout.local_id();
+    const int dest_local = m_layout.local_id(dest);
+    const int rps        = m_ranks_per_socket;
+    if (my_local / rps == dest_local / rps) {
+      return dest;
+    }
+    int next_local = (dest_local / rps) * rps + my_local % rps;
+    if (next_local >= m_layout.local_size()) {
+      return dest;
+    }
+    return m_layout.local_ranks()[next_local];
+  }
+
+  const layout    &m_layout;
+  routing_type     m_default_route;
+  std::vector<int> m_level_spans{1};
+  int              m_ranks_per_socket = 0;
 };
 
 }  // namespace detail
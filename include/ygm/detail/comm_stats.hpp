@@ -6,9 +6,28 @@
 #pragma once
 
 #include <mpi.h>
+#include <algorithm>
 
 namespace ygm {
 namespace detail {
+
+/**
+ * @brief Bytes held by one rank's message buffers. High-water marks count
+ * bytes queued rather than allocated and cover the time since the last
+ * comm::stats_reset().
+ */
+struct comm_memory_usage {
+  size_t send_buffer_bytes        = 0;  // Per-destination send buffers
+  size_t isend_buffer_bytes       = 0;  // Buffers in flight or pooled
+  size_t irecv_buffer_bytes       = 0;  // Posted receive buffers
+  size_t send_buffer_high_water   = 0;  // Most bytes waiting to be sent
+  size_t pending_isend_high_water = 0;  // Most bytes in flight
+
+  size_t total() const {
+    return send_buffer_bytes + isend_buffer_bytes + irecv_buffer_bytes;
+  }
+};
+
 class comm_stats {
  public:
   class timer {
@@ -36,6 +55,11 @@ class comm_stats {
 
   void async(int dest) { m_async_count += 1; }
 
+  void loopback(size_t bytes) {
+    m_loopback_count += 1;
+    m_loopback_bytes += bytes;
+  }
+
   void rpc_execute() { m_rpc_count += 1; }
 
   void routing() { m_route_count += 1; }
@@ -46,6 +70,15 @@ class comm_stats {
 
   void iallreduce() { m_iallreduce_count += 1; }
 
+  // Records the bytes currently buffered for sending and in flight
+  void send_buffer_bytes(size_t bytes) {
+    m_send_buffer_high_water = std::max(m_send_buffer_high_water, bytes);
+  }
+
+  void pending_isend_bytes(size_t bytes) {
+    m_pending_isend_high_water = std::max(m_pending_isend_high_water, bytes);
+  }
+
   timer waitsome_isend_irecv() {
     m_waitsome_isend_irecv_count += 1;
     return timer(m_waitsome_isend_irecv_time);
@@ -66,11 +99,15 @@ class comm_stats {
     m_irecv_count                = 0;
     m_irecv_bytes                = 0;
     m_irecv_test_count           = 0;
+    m_loopback_count             = 0;
+    m_loopback_bytes             = 0;
     m_waitsome_isend_irecv_time  = 0.0f;
     m_waitsome_isend_irecv_count = 0.0f;
     m_iallreduce_count           = 0;
     m_waitsome_iallreduce_time   = 0.0f;
     m_waitsome_iallreduce_count  = 0;
+    m_send_buffer_high_water     = 0;
+    m_pending_isend_high_water   = 0;
     m_time_start                 = MPI_Wtime();
   }
 
@@ -86,6 +123,9 @@ class comm_stats {
   size_t get_irecv_bytes() const { return m_irecv_bytes; }
   size_t get_irecv_test_count() const { return m_irecv_test_count; }
 
+  size_t get_loopback_count() const { return m_loopback_count; }
+  size_t get_loopback_bytes() const { return m_loopback_bytes; }
+
   double get_waitsome_isend_irecv_time() const {
     return m_waitsome_isend_irecv_time;
   }
@@ -101,6 +141,13 @@ class comm_stats {
     return m_waitsome_iallreduce_count;
   }
 
+  size_t get_send_buffer_high_water() const {
+    return m_send_buffer_high_water;
+  }
+  size_t get_pending_isend_high_water() const {
+    return m_pending_isend_high_water;
+  }
+
   double get_elapsed_time() const { return MPI_Wtime() - m_time_start; }
 
  private:
@@ -116,6 +163,9 @@ class comm_stats {
   size_t m_irecv_bytes      = 0;
   size_t m_irecv_test_count = 0;
 
+  size_t m_loopback_count = 0;
+  size_t m_loopback_bytes = 0;
+
   double m_waitsome_isend_irecv_time  = 0.0f;
   size_t m_waitsome_isend_irecv_count = 0.0f;
 
@@ -123,6 +173,9 @@ class comm_stats {
   double m_waitsome_iallreduce_time  = 0.0f;
   size_t m_waitsome_iallreduce_count = 0;
 
+  size_t m_send_buffer_high_water   = 0;
+  size_t m_pending_isend_high_water = 0;
+
   double m_time_start = 0.0;
 };
 }  // namespace detail
@@ -13,7 +13,9 @@ namespace detail {
 
 class interrupt_mask {
  public:
-  interrupt_mask(ygm::comm &c) : m_comm(c) {
+  // Interrupts are owned by the root comm's progress engine, which is shared
+  // with all of its sub-communicators.
+  interrupt_mask(ygm::comm &c) : m_comm(*c.m_root) {
     m_comm.m_enable_interrupts = false;
   }
 
@@ -22,6 +22,9 @@ class lambda_map {
  public:
   using func_id = FuncId;
 
+  // The largest ids are never assigned so they can mark message headers
+  static constexpr FuncId num_reserved_ids = 8;
+
   template <typename LambdaType>
   static FuncId register_lambda(LambdaType l) {
     return lambda_enumerator<LambdaType>::id;
@@ -34,7 +37,8 @@ class lambda_map {
  private:
   template <typename LambdaType>
   static FuncId record() {
-    ASSERT_RELEASE(s_map.size() < std::numeric_limits<FuncId>::max());
+    ASSERT_RELEASE(s_map.size() <
+                   std::numeric_limits<FuncId>::max() - num_reserved_ids);
     FuncId      to_return = s_map.size();
     LambdaType *lp;  // scary, but by definition can't capture
     s_map.push_back(*lp);
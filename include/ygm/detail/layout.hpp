@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <exception>
 #include <iostream>
 #include <sstream>
@@ -30,33 +31,43 @@ class layout {
   std::vector<int> m_rank_to_local;
 
  public:
-  layout(MPI_Comm comm) {
+  /**
+   * @param fake_ranks_per_node When non-zero, simulates nodes made of this
+   * many consecutive ranks instead of grouping ranks by shared memory.
+   * Must evenly divide the size of comm.
+   */
+  layout(MPI_Comm comm, const size_t fake_ranks_per_node = 0) {
     // global ranks
     ASSERT_MPI(MPI_Comm_size(comm, &m_comm_size));
     ASSERT_MPI(MPI_Comm_rank(comm, &m_comm_rank));
+    ASSERT_RELEASE(fake_ranks_per_node == 0 ||
+                   m_comm_size % fake_ranks_per_node == 0);
 
     // local ranks
     MPI_Comm comm_local;
-    ASSERT_MPI(MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, m_comm_rank,
-                                   MPI_INFO_NULL, &comm_local));
-    ASSERT_MPI(MPI_Comm_size(comm_local, &m_local_size));
-    ASSERT_MPI(MPI_Comm_rank(comm_local, &m_local_id));
-
-    _mpi_allgather(m_comm_rank, m_local_ranks, m_local_size, comm_local);
-
-    // node ranks
-    MPI_Comm comm_node;
-    ASSERT_MPI(MPI_Comm_split(comm, m_local_id, m_comm_rank, &comm_node));
-    ASSERT_MPI(MPI_Comm_size(comm_node, &m_node_size));
-    ASSERT_MPI(MPI_Comm_rank(comm_node, &m_node_id));
-
-    _mpi_allgather(m_comm_rank, m_strided_ranks, m_node_size, comm_node);
+    if (fake_ranks_per_node > 0) {
+      ASSERT_MPI(MPI_Comm_split(comm, m_comm_rank / fake_ranks_per_node,
+                                m_comm_rank, &comm_local));
+    } else {
+      ASSERT_MPI(MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, m_comm_rank,
+                                     MPI_INFO_NULL, &comm_local));
+    }
+    _init(comm, comm_local);
+  }
 
-    _mpi_allgather(m_local_id, m_rank_to_local, m_comm_size, comm);
-    _mpi_allgather(m_node_id, m_rank_to_node, m_comm_size, comm);
+  /**
+   * @brief Layout of comm, a sub-communicator of the comm described by parent.
+   * Every rank stays on its node in parent, even when comm holds only some of
+   * that node's ranks.
+   */
+  layout(MPI_Comm comm, const layout &parent) {
+    ASSERT_MPI(MPI_Comm_size(comm, &m_comm_size));
+    ASSERT_MPI(MPI_Comm_rank(comm, &m_comm_rank));
 
-    ASSERT_RELEASE(MPI_Comm_free(&comm_local) == MPI_SUCCESS);
-    ASSERT_RELEASE(MPI_Comm_free(&comm_node) == MPI_SUCCESS);
+    MPI_Comm comm_local;
+    ASSERT_MPI(
+        MPI_Comm_split(comm, parent.node_id(), m_comm_rank, &comm_local));
+    _init(comm, comm_local);
   }
 
   layout(const layout &rhs)
@@ -155,6 +166,45 @@ class layout {
   }
 
  private:
+  // Fills in node and local ids from comm_local, which groups comm's ranks by
+  // node with comm ranks as keys, and frees it
+  void _init(MPI_Comm comm, MPI_Comm comm_local) {
+    ASSERT_MPI(MPI_Comm_size(comm_local, &m_local_size));
+    ASSERT_MPI(MPI_Comm_rank(comm_local, &m_local_id));
+
+    _mpi_allgather(m_comm_rank, m_local_ranks, m_local_size, comm_local);
+
+    // Nodes are numbered in order of their lowest rank, which stays consistent
+    // across ranks when nodes hold different numbers of ranks
+    int              leader = m_local_ranks[0];
+    std::vector<int> rank_to_leader;
+    _mpi_allgather(leader, rank_to_leader, m_comm_size, comm);
+    std::vector<int> leaders(rank_to_leader);
+    std::sort(leaders.begin(), leaders.end());
+    leaders.erase(std::unique(leaders.begin(), leaders.end()), leaders.end());
+    m_node_size = leaders.size();
+    m_rank_to_node.resize(m_comm_size);
+    for (int rank = 0; rank < m_comm_size; ++rank) {
+      m_rank_to_node[rank] =
+          std::lower_bound(leaders.begin(), leaders.end(),
+                           rank_to_leader[rank]) -
+          leaders.begin();
+    }
+    m_node_id = m_rank_to_node[m_comm_rank];
+
+    // strided ranks share this rank's local id
+    MPI_Comm comm_node;
+    ASSERT_MPI(MPI_Comm_split(comm, m_local_id, m_comm_rank, &comm_node));
+    int strided_size;
+    ASSERT_MPI(MPI_Comm_size(comm_node, &strided_size));
+    _mpi_allgather(m_comm_rank, m_strided_ranks, strided_size, comm_node);
+
+    _mpi_allgather(m_local_id, m_rank_to_local, m_comm_size, comm);
+
+    ASSERT_RELEASE(MPI_Comm_free(&comm_local) == MPI_SUCCESS);
+    ASSERT_RELEASE(MPI_Comm_free(&comm_node) == MPI_SUCCESS);
+  }
+
   template <typename T>
   void _mpi_allgather(T &_t, std::vector<T> &out_vec, int size, MPI_Comm comm) {
     out_vec.resize(size);
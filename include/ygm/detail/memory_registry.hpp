@@ -0,0 +1,68 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <functional>
+#include <map>
+#include <string>
+#include <utility>
+
+namespace ygm::detail {
+
+/**
+ * @brief Named estimates of the memory held on this rank, one per live
+ * container. Estimates are only evaluated when totals() is called.
+ */
+class memory_registry {
+ public:
+  size_t add(const std::string &name, std::function<size_t()> bytes_fn) {
+    m_sources.emplace(m_next_id, std::make_pair(name, std::move(bytes_fn)));
+    return m_next_id++;
+  }
+
+  void remove(const size_t id) { m_sources.erase(id); }
+
+  void rename(const size_t id, const std::string &name) {
+    m_sources.at(id).first = name;
+  }
+
+  // Current estimates summed per name
+  std::map<std::string, size_t> totals() const {
+    std::map<std::string, size_t> to_return;
+    for (const auto &[id, source] : m_sources) {
+      to_return[source.first] += source.second();
+    }
+    return to_return;
+  }
+
+ private:
+  std::map<size_t, std::pair<std::string, std::function<size_t()>>> m_sources;
+  size_t m_next_id = 0;
+};
+
+/**
+ * @brief Keeps one estimate registered for as long as it lives. Containers
+ * hold one as their last member.
+ */
+class memory_tracker {
+ public:
+  memory_tracker(memory_registry &registry, const std::string &name,
+                 std::function<size_t()> bytes_fn)
+      : m_registry(registry), m_id(registry.add(name, std::move(bytes_fn))) {}
+
+  memory_tracker(const memory_tracker &) = delete;
+  memory_tracker &operator=(const memory_tracker &) = delete;
+
+  ~memory_tracker() { m_registry.remove(m_id); }
+
+  void rename(const std::string &name) { m_registry.rename(m_id, name); }
+
+ private:
+  memory_registry &m_registry;
+  size_t           m_id;
+};
+
+}  // namespace ygm::detail
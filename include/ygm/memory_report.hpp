@@ -0,0 +1,142 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <algorithm>
+#include <cereal/types/map.hpp>
+#include <cereal/types/string.hpp>
+#include <cereal/types/vector.hpp>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <ygm/comm.hpp>
+
+namespace ygm {
+
+/**
+ * @brief Bytes reported under one name, summarized across ranks. Ranks
+ * without an entry under the name count as zero.
+ */
+struct memory_report_row {
+  std::string name;
+  size_t      min   = 0;
+  size_t      max   = 0;
+  size_t      total = 0;
+
+  double avg(const int nranks) const { return double(total) / nranks; }
+};
+
+namespace detail {
+
+// Value of a "kB" line such as VmRSS from /proc/self/status, in bytes, or 0
+inline size_t proc_status_bytes(const std::string &field) {
+  std::ifstream status("/proc/self/status");
+  std::string   line;
+  while (std::getline(status, line)) {
+    if (line.compare(0, field.size(), field) == 0 &&
+        line.size() > field.size() && line[field.size()] == ':') {
+      std::istringstream iss(line.substr(field.size() + 1));
+      size_t             kib = 0;
+      iss >> kib;
+      return kib * 1024;
+    }
+  }
+  return 0;
+}
+
+// This rank's estimates: live containers, then comm buffers, then process
+inline std::map<std::string, size_t> local_memory_estimates(comm &c) {
+  std::map<std::string, size_t> to_return = c.memory_sources().totals();
+
+  const comm_memory_usage usage          = c.memory_usage();
+  to_return["comm.send_buffers"]         = usage.send_buffer_bytes;
+  to_return["comm.isend_buffers"]        = usage.isend_buffer_bytes;
+  to_return["comm.irecv_buffers"]        = usage.irecv_buffer_bytes;
+  to_return["comm.send_buffer_hwm"]      = usage.send_buffer_high_water;
+  to_return["comm.pending_isend_hwm"]    = usage.pending_isend_high_water;
+  to_return["process.rss"]               = proc_status_bytes("VmRSS");
+  to_return["process.rss_hwm"]           = proc_status_bytes("VmHWM");
+  return to_return;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Collective summary of the memory held on each rank: the estimated
+ * bytes of every live container, grouped by container name, the comm's
+ * message buffers and their high-water marks, and the process's resident
+ * set size and its peak where /proc is available.
+ *
+ * Container estimates count each container's own storage, not memory owned
+ * by its elements. Rank 0 prints the table to os; every rank returns the
+ * rows, sorted by name.
+ */
+inline std::vector<memory_report_row> memory_report(
+    comm &c, std::ostream &os = std::cout) {
+  c.barrier();
+  const std::map<std::string, size_t> local = detail::local_memory_estimates(c);
+
+  // Names seen on any rank, so every rank reduces the same vectors
+  std::map<std::string, size_t> names = c.all_reduce(
+      local, [](std::map<std::string, size_t> a,
+                const std::map<std::string, size_t> &b) {
+        a.insert(b.begin(), b.end());
+        return a;
+      });
+
+  std::vector<size_t> values;
+  values.reserve(names.size());
+  for (const auto &[name, ignored] : names) {
+    auto itr = local.find(name);
+    values.push_back(itr == local.end() ? 0 : itr->second);
+  }
+
+  auto elementwise = [&c, &values](auto op) {
+    return c.all_reduce(values, [op](std::vector<size_t>        a,
+                                     const std::vector<size_t> &b) {
+      for (size_t i = 0; i < a.size(); ++i) {
+        a[i] = op(a[i], b[i]);
+      }
+      return a;
+    });
+  };
+  std::vector<size_t> mins = elementwise(
+      [](const size_t a, const size_t b) { return std::min(a, b); });
+  std::vector<size_t> maxs = elementwise(
+      [](const size_t a, const size_t b) { return std::max(a, b); });
+  std::vector<size_t> totals =
+      elementwise([](const size_t a, const size_t b) { return a + b; });
+
+  std::vector<memory_report_row> to_return;
+  to_return.reserve(names.size());
+  size_t i = 0;
+  for (const auto &[name, ignored] : names) {
+    to_return.push_back(memory_report_row{name, mins[i], maxs[i], totals[i]});
+    ++i;
+  }
+
+  if (c.rank0()) {
+    std::stringstream sstr;
+    sstr << "============== MEMORY (bytes per rank) ==============\n"
+         << std::left << std::setw(24) << "NAME" << std::right
+         << std::setw(14) << "MIN" << std::setw(14) << "AVG"
+         << std::setw(14) << "MAX" << "\n";
+    for (const auto &row : to_return) {
+      sstr << std::left << std::setw(24) << row.name << std::right
+           << std::setw(14) << row.min << std::setw(14)
+           << size_t(row.avg(c.size())) << std::setw(14) << row.max << "\n";
+    }
+    sstr << "=====================================================";
+    os << sstr.str() << std::endl;
+  }
+  return to_return;
+}
+
+}  // namespace ygm
@@ -189,4 +189,52 @@ int main(int argc, char** argv) {
     ASSERT_RELEASE(*std::max_element(value_set.begin(), value_set.end()) ==
                    199);
   }
+  //
+  // Test rebalance keeps global order
+  {
+    ygm::container::bag<int> bbag(world);
+    for (int i = 0; i < 10 * (world.rank() + 1); i++) {
+      bbag.async_insert(world.rank() * 1000 + i, world.rank());
+    }
+    bbag.rebalance();
+
+    auto v = bbag.gather_to_vector();
+    ASSERT_RELEASE(std::is_sorted(v.begin(), v.end()));
+  }
+
+  //
+  // Test rebalance keeps global order over many exchange rounds
+  {
+    ygm::container::bag<int> bbag(world);
+    for (int i = 0; i < 100 * (world.rank() + 1); i++) {
+      bbag.async_insert(world.rank() * 1000 + i, world.rank());
+    }
+    bbag.rebalance(16 * world.size());
+
+    std::vector<int> expected;
+    for (int rank = 0; rank < world.size(); ++rank) {
+      for (int i = 0; i < 100 * (rank + 1); i++) {
+        expected.push_back(rank * 1000 + i);
+      }
+    }
+    size_t offset = ygm::prefix_sum(bbag.local_size(), world);
+    bbag.local_for_all([&expected, &offset](const int &item) {
+      ASSERT_RELEASE(item == expected[offset++]);
+    });
+  }
+
+  //
+  // Test repartition
+  {
+    ygm::container::bag<int> bbag(world);
+    for (int i = 0; i < 100; i++) {
+      bbag.async_insert(i);
+    }
+    bbag.repartition([&world](const int &item) { return item % world.size(); });
+
+    ASSERT_RELEASE(bbag.size() == 100 * size_t(world.size()));
+    bbag.for_all([&world](const int &item) {
+      ASSERT_RELEASE(item % world.size() == world.rank());
+    });
+  }
 }
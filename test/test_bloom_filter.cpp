@@ -0,0 +1,109 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#undef NDEBUG
+#include <string>
+#include <ygm/comm.hpp>
+#include <ygm/container/bloom_filter.hpp>
+#include <ygm/container/detail/block_bloom_filter.hpp>
+
+int main(int argc, char **argv) {
+  ygm::comm world(&argc, &argv);
+
+  //
+  // Test local filter: no false negatives, few false positives, OR merge
+  {
+    using ygm::container::detail::block_bloom_filter;
+    block_bloom_filter evens(10000), odds(10000);
+    for (int i = 0; i < 20000; i += 2) {
+      evens.insert(i);
+      odds.insert(i + 1);
+    }
+    size_t false_positives = 0;
+    for (int i = 0; i < 20000; i += 2) {
+      ASSERT_RELEASE(evens.maybe_contains(i));
+      false_positives += evens.maybe_contains(i + 1);
+    }
+    ASSERT_RELEASE(false_positives < 300);
+
+    evens.merge(odds);
+    for (int i = 0; i < 20000; ++i) {
+      ASSERT_RELEASE(evens.maybe_contains(i));
+    }
+    ASSERT_RELEASE(evens.fill_ratio() > odds.fill_ratio());
+  }
+
+  //
+  // Test distributed inserts and remote tests
+  {
+    ygm::container::bloom_filter<std::string> bf(world, 1000);
+    if (world.rank0()) {
+      for (int i = 0; i < 1000; ++i) {
+        bf.async_insert("in" + std::to_string(i));
+      }
+    }
+    world.barrier();
+
+    static size_t positives;
+    static size_t negatives;
+    positives = 0;
+    negatives = 0;
+    for (int i = world.rank(); i < 1000; i += world.size()) {
+      bf.async_test_and_execute("in" + std::to_string(i),
+                                [](const std::string &key, bool present) {
+                                  ASSERT_RELEASE(present);
+                                  ++positives;
+                                });
+      bf.async_test_and_execute(
+          "out" + std::to_string(i),
+          [](auto pbf, const std::string &key, bool present, int tag) {
+            ASSERT_RELEASE(tag == 7);
+            positives += present;
+            negatives += !present;
+          },
+          7);
+    }
+    world.barrier();
+    ASSERT_RELEASE(world.all_reduce_sum(positives) >= 1000);
+    ASSERT_RELEASE(world.all_reduce_sum(positives) < 1050);
+    ASSERT_RELEASE(world.all_reduce_sum(negatives) > 950);
+
+    //
+    // Replicated tests agree with the shards
+    bf.replicate();
+    ASSERT_RELEASE(bf.is_replicated());
+    size_t replica_positives = 0;
+    for (int i = 0; i < 1000; ++i) {
+      ASSERT_RELEASE(bf.local_maybe_contains("in" + std::to_string(i)));
+      replica_positives += bf.local_maybe_contains("out" + std::to_string(i));
+    }
+    ASSERT_RELEASE(replica_positives ==
+                   world.all_reduce_sum(positives) - 1000);
+
+    bf.serialize("/tmp/test_bloom_filter");
+    bf.clear();
+    ASSERT_RELEASE(!bf.is_replicated());
+    ASSERT_RELEASE(bf.fill_ratio() == 0);
+    bf.deserialize("/tmp/test_bloom_filter");
+    ASSERT_RELEASE(bf.fill_ratio() > 0);
+  }
+
+  //
+  // Test duplicate suppression
+  {
+    ygm::container::bloom_filter<int> seen(world, 100);
+    static size_t                     first_visits;
+    first_visits = 0;
+    for (int i = 0; i < 100; ++i) {
+      seen.async_insert_exe_if_missing(
+          i, [](const int &key, bool present) { ++first_visits; });
+    }
+    world.barrier();
+    ASSERT_RELEASE(world.all_reduce_sum(first_visits) <= 100);
+    ASSERT_RELEASE(world.all_reduce_sum(first_visits) > 90);
+  }
+
+  return 0;
+}
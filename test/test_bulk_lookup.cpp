@@ -0,0 +1,95 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#undef NDEBUG
+#include <map>
+#include <string>
+#include <ygm/comm.hpp>
+#include <ygm/container/counting_set.hpp>
+#include <ygm/container/map.hpp>
+
+int main(int argc, char **argv) {
+  ygm::comm world(&argc, &argv);
+
+  //
+  // Test repeated keys are looked up once and absent keys skipped
+  {
+    ygm::container::map<int, std::string> smap(world);
+    if (world.rank0()) {
+      for (int i = 0; i < 1000; ++i) {
+        smap.async_insert(i, std::to_string(i));
+      }
+    }
+
+    std::vector<int> keys;
+    for (int round = 0; round < 5; ++round) {
+      for (int i = world.rank(); i < 2000; i += world.size()) {
+        keys.push_back(i);
+      }
+    }
+
+    std::map<int, size_t> seen;
+    smap.bulk_lookup(keys, [&seen](const int &key, const std::string &value) {
+      ASSERT_RELEASE(value == std::to_string(key));
+      ++seen[key];
+    });
+    for (const auto &kv : seen) {
+      ASSERT_RELEASE(kv.first < 1000);
+      ASSERT_RELEASE(kv.first % world.size() == world.rank());
+      ASSERT_RELEASE(kv.second == 1);
+    }
+    size_t expected = 0;
+    for (int i = world.rank(); i < 1000; i += world.size()) {
+      ++expected;
+    }
+    ASSERT_RELEASE(seen.size() == expected);
+
+    auto found = smap.bulk_get(std::vector<int>{1, 1, 500, 5000});
+    ASSERT_RELEASE(found.size() == 2);
+    ASSERT_RELEASE(found[500] == "500");
+
+    // all_gather goes through the same path
+    auto gathered = smap.all_gather({7, 7, 999, 1000});
+    ASSERT_RELEASE(gathered.size() == 2);
+    ASSERT_RELEASE(gathered[999] == "999");
+  }
+
+  //
+  // Test every value of a multimap key is returned
+  {
+    ygm::container::multimap<int, int> mmap(world);
+    mmap.async_insert(42, world.rank());
+
+    int count = 0;
+    int sum   = 0;
+    mmap.bulk_lookup(std::vector<int>{42, 42},
+                     [&count, &sum](const int &key, const int &value) {
+                       ++count;
+                       sum += value;
+                     });
+    ASSERT_RELEASE(count == world.size());
+    ASSERT_RELEASE(sum == world.size() * (world.size() - 1) / 2);
+  }
+
+  //
+  // Test counting_set counts many keys at once
+  {
+    ygm::container::counting_set<std::string> cset(world);
+    cset.async_insert("dog");
+    cset.async_insert("dog");
+    cset.async_insert("cat");
+
+    std::map<std::string, size_t> counts;
+    cset.bulk_lookup(std::vector<std::string>{"dog", "cat", "bird"},
+                     [&counts](const std::string &key, const size_t &count) {
+                       counts[key] = count;
+                     });
+    ASSERT_RELEASE(counts.size() == 2);
+    ASSERT_RELEASE(counts["dog"] == 2 * size_t(world.size()));
+    ASSERT_RELEASE(counts["cat"] == size_t(world.size()));
+  }
+
+  return 0;
+}
@@ -0,0 +1,120 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#undef NDEBUG
+#include <map>
+#include <ygm/comm.hpp>
+#include <ygm/container/counting_set.hpp>
+#include <ygm/container/detail/combining_cache.hpp>
+#include <ygm/container/detail/reducing_adapter.hpp>
+#include <ygm/container/map.hpp>
+
+int main(int argc, char **argv) {
+  ygm::comm world(&argc, &argv);
+
+  auto plus = [](const size_t a, const size_t b) { return a + b; };
+
+  //
+  // Test combining and flushing keep every value exactly once
+  {
+    ygm::container::detail::combining_cache<int, size_t> cache(4, 64);
+    std::map<int, size_t>                                 flushed;
+    auto flush = [&flushed](const int &key, const size_t &value) {
+      flushed[key] += value;
+    };
+
+    for (int i = 0; i < 100000; ++i) {
+      cache.combine((i * 7919) % 1000, 1, plus, flush);
+    }
+    auto stats = cache.stats();
+    ASSERT_RELEASE(stats.hits + stats.misses == 100000);
+    ASSERT_RELEASE(stats.capacity == 64 * cache.ways);
+
+    cache.flush_all(flush);
+    ASSERT_RELEASE(cache.empty());
+    ASSERT_RELEASE(flushed.size() == 1000);
+    for (const auto &kv : flushed) {
+      ASSERT_RELEASE(kv.second == 100);
+    }
+    ASSERT_RELEASE(cache.stats().flushes == stats.misses);
+  }
+
+  //
+  // Test a thrashing stream grows the cache until it mostly holds the working
+  // set
+  {
+    ygm::container::detail::combining_cache<int, size_t> cache(1, 1024);
+    size_t                                                flushes = 0;
+    auto flush = [&flushes](const int &key, const size_t &value) { ++flushes; };
+
+    for (int round = 0; round < 100; ++round) {
+      for (int key = 0; key < 500; ++key) {
+        cache.combine(key, 1, plus, flush);
+      }
+    }
+    ASSERT_RELEASE(cache.capacity() >= 500);
+    size_t before = flushes;
+    for (int key = 0; key < 500; ++key) {
+      cache.combine(key, 1, plus, flush);
+    }
+    ASSERT_RELEASE(flushes - before < 500 / 8);
+
+    // A mostly empty cache shrinks when flushed
+    cache.flush_all(flush);
+    for (int i = 0; i < 10; ++i) {
+      cache.combine(i, 1, plus, flush);
+    }
+    size_t grown = cache.capacity();
+    cache.flush_all(flush);
+    ASSERT_RELEASE(cache.capacity() < grown);
+  }
+
+  //
+  // Test LRU replacement keeps a recently used key
+  {
+    ygm::container::detail::combining_cache<int, size_t> cache(1, 1);
+    std::vector<int>                                      evicted;
+    auto flush = [&evicted](const int &key, const size_t &value) {
+      evicted.push_back(key);
+    };
+    for (int key = 0; key < 4; ++key) {
+      cache.combine(key, 1, plus, flush);
+    }
+    cache.combine(0, 1, plus, flush);
+    cache.combine(4, 1, plus, flush);
+    ASSERT_RELEASE(evicted.size() == 1 && evicted[0] == 1);
+    ASSERT_RELEASE(cache.erase(0));
+    ASSERT_RELEASE(!cache.erase(0));
+    ASSERT_RELEASE(cache.size() == 3);
+  }
+
+  //
+  // Test counting_set and reducing_adapter report cache counters
+  {
+    ygm::container::counting_set<int> cset(world);
+    for (int i = 0; i < 10000; ++i) {
+      cset.async_insert(i % 10);
+    }
+    auto stats = cset.cache_stats();
+    ASSERT_RELEASE(stats.hits + stats.misses == 10000);
+    ASSERT_RELEASE(stats.misses <= 10);
+    ASSERT_RELEASE(cset.count(3) == 1000 * world.size());
+
+    ygm::container::map<int, size_t> sums(world);
+    {
+      auto adapter =
+          ygm::container::detail::make_reducing_adapter(sums, plus);
+      for (int i = 0; i < 10000; ++i) {
+        adapter.async_reduce(i % 10, 2);
+      }
+      auto astats = adapter.cache_stats();
+      ASSERT_RELEASE(astats.misses <= 10);
+    }
+    auto totals = sums.all_gather({3});
+    ASSERT_RELEASE(totals[3] == 2000 * world.size());
+  }
+
+  return 0;
+}
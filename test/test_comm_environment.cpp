@@ -0,0 +1,119 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#undef NDEBUG
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <ygm/comm.hpp>
+
+int main(int argc, char** argv) {
+  ASSERT_MPI(MPI_Init(nullptr, nullptr));
+  int rank;
+  ASSERT_MPI(MPI_Comm_rank(MPI_COMM_WORLD, &rank));
+
+  const std::string fname = "test_comm_environment.ygm";
+
+  //
+  // Settings round trip through a config file
+  {
+    ygm::detail::comm_environment env;
+    env.buffer_size         = 2 * 1024 * 1024;
+    env.num_isends_wait     = 7;
+    env.routing             = ygm::routing_type::NLNR;
+    env.routing_levels      = {4, 2};
+    env.fake_ranks_per_node = 1;
+    if (rank == 0) {
+      std::ofstream ofs(fname);
+      env.write_file(ofs);
+      ofs << "\n# comment\n  YGM_COMM_ISSEND_FREQ=3  \n";
+    }
+    ASSERT_MPI(MPI_Barrier(MPI_COMM_WORLD));
+
+    setenv("YGM_CONFIG_FILE", fname.c_str(), 1);
+    unsetenv("YGM_COMM_ROUTING");
+    unsetenv("YGM_COMM_ROUTING_LEVELS");
+    ygm::detail::comm_environment loaded;
+    ASSERT_RELEASE(loaded.buffer_size == 2 * 1024 * 1024);
+    ASSERT_RELEASE(loaded.num_isends_wait == 7);
+    ASSERT_RELEASE(loaded.freq_issend == 3);
+    ASSERT_RELEASE(loaded.routing == ygm::routing_type::NLNR);
+    ASSERT_RELEASE(loaded.routing_levels.size() == 2);
+    ASSERT_RELEASE(loaded.routing_levels[0] == 4);
+    ASSERT_RELEASE(loaded.fake_ranks_per_node == 1);
+
+    // Environment variables take precedence over the file
+    setenv("YGM_COMM_NUM_ISENDS_WAIT", "9", 1);
+    ygm::detail::comm_environment overridden;
+    ASSERT_RELEASE(overridden.num_isends_wait == 9);
+    ASSERT_RELEASE(overridden.buffer_size == 2 * 1024 * 1024);
+    unsetenv("YGM_COMM_NUM_ISENDS_WAIT");
+
+    // A comm picks up the file
+    ygm::comm world(MPI_COMM_WORLD);
+    static int count = 0;
+    world.async((world.rank() + 1) % world.size(), []() { ++count; });
+    world.barrier();
+    ASSERT_RELEASE(count == 1);
+
+    ASSERT_MPI(MPI_Barrier(MPI_COMM_WORLD));
+    if (rank == 0) {
+      std::remove(fname.c_str());
+    }
+    unsetenv("YGM_CONFIG_FILE");
+  }
+
+  //
+  // A config file named by YGM_CONFIG_FILE must exist
+  {
+    setenv("YGM_CONFIG_FILE", "test_comm_environment_missing.ygm", 1);
+    bool threw = false;
+    try {
+      ygm::detail::comm_environment env;
+    } catch (const std::runtime_error&) {
+      threw = true;
+    }
+    ASSERT_RELEASE(threw);
+    unsetenv("YGM_CONFIG_FILE");
+  }
+
+  //
+  // Autotuning picks one of the candidates on every rank
+  {
+    setenv("YGM_COMM_AUTOTUNE_MESSAGES", "1000", 1);
+    ygm::detail::comm_environment env;
+    env.welcome = true;
+
+    std::stringstream report;
+    auto              tuned =
+        ygm::detail::autotune_comm_environment(MPI_COMM_WORLD, env, &report);
+    ASSERT_RELEASE(!tuned.autotune);
+    ASSERT_RELEASE(tuned.welcome);
+    ASSERT_RELEASE(tuned.buffer_size == 256 * 1024 ||
+                   tuned.buffer_size == 1024 * 1024 ||
+                   tuned.buffer_size == 4 * 1024 * 1024 ||
+                   tuned.buffer_size == 16 * 1024 * 1024);
+    size_t min_buffer_size = tuned.buffer_size;
+    ASSERT_MPI(MPI_Allreduce(MPI_IN_PLACE, &min_buffer_size, 1,
+                             MPI_UNSIGNED_LONG, MPI_MIN, MPI_COMM_WORLD));
+    ASSERT_RELEASE(min_buffer_size == tuned.buffer_size);
+    if (rank == 0) {
+      ASSERT_RELEASE(report.str().find("YGM_COMM_BUFFER_SIZE_KB = 1024") !=
+                     std::string::npos);
+    }
+
+    // Autotuning while building a comm
+    setenv("YGM_COMM_AUTOTUNE", "1", 1);
+    ygm::comm world(MPI_COMM_WORLD);
+    static int count = 0;
+    world.async((world.rank() + 1) % world.size(), []() { ++count; });
+    world.barrier();
+    ASSERT_RELEASE(count == 1);
+    unsetenv("YGM_COMM_AUTOTUNE");
+  }
+
+  ASSERT_MPI(MPI_Finalize());
+  return 0;
+}
@@ -0,0 +1,98 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#undef NDEBUG
+#include <set>
+#include <ygm/comm.hpp>
+#include <ygm/detail/comm_router.hpp>
+
+//
+// Gathers every rank's next hop table and checks that all routes terminate
+// within the expected number of hops.
+void check_routes(ygm::comm& world, ygm::detail::routing_type route,
+                  int max_hops, int max_remote_peers) {
+  std::vector<int> my_hops(world.size());
+  for (int dest = 0; dest < world.size(); ++dest) {
+    my_hops[dest] = world.router().next_hop(dest, route);
+  }
+  std::vector<int> all_hops(world.size() * world.size());
+  ASSERT_MPI(MPI_Allgather(my_hops.data(), world.size(), MPI_INT,
+                           all_hops.data(), world.size(), MPI_INT,
+                           world.get_mpi_comm()));
+
+  for (int src = 0; src < world.size(); ++src) {
+    for (int dest = 0; dest < world.size(); ++dest) {
+      int curr = src;
+      int hops = 0;
+      while (curr != dest) {
+        curr = all_hops[curr * world.size() + dest];
+        ++hops;
+        ASSERT_RELEASE(hops <= max_hops);
+      }
+    }
+  }
+
+  std::set<int> remote_peers;
+  for (int dest = 0; dest < world.size(); ++dest) {
+    if (!world.layout().is_local(my_hops[dest])) {
+      remote_peers.insert(my_hops[dest]);
+    }
+  }
+  ASSERT_RELEASE(remote_peers.size() <= size_t(max_remote_peers));
+}
+
+int main(int argc, char** argv) {
+  ASSERT_MPI(MPI_Init(nullptr, nullptr));
+  int world_size;
+  ASSERT_MPI(MPI_Comm_size(MPI_COMM_WORLD, &world_size));
+
+  //
+  // One rank per node, nodes grouped in pairs
+  {
+    setenv("YGM_FAKE_RANKS_PER_NODE", "1", 1);
+    setenv("YGM_COMM_ROUTING_LEVELS", "2", 1);
+    ygm::comm world(MPI_COMM_WORLD);
+    ASSERT_RELEASE(world.layout().node_size() == world.size());
+    ASSERT_RELEASE(world.router().num_levels() == 2);
+
+    int nodes      = world.layout().node_size();
+    int num_groups = (nodes + 1) / 2;
+    check_routes(world, ygm::detail::routing_type::NR, 1, nodes - 1);
+    check_routes(world, ygm::detail::routing_type::HIER, 2,
+                 (num_groups - 1) + 1);
+  }
+
+  //
+  // Two ranks per node and two sockets per node
+  if (world_size % 2 == 0) {
+    setenv("YGM_FAKE_RANKS_PER_NODE", "2", 1);
+    setenv("YGM_COMM_ROUTING_LEVELS", "2", 1);
+    setenv("YGM_COMM_RANKS_PER_SOCKET", "1", 1);
+    ygm::comm world(MPI_COMM_WORLD);
+    ASSERT_RELEASE(world.layout().local_size() == 2);
+    int nodes      = world.layout().node_size();
+    int num_groups = (nodes + 1) / 2;
+    check_routes(world, ygm::detail::routing_type::NLNR, 3, nodes - 1);
+    check_routes(world, ygm::detail::routing_type::HIER, 4,
+                 (num_groups - 1) + 1);
+  }
+
+  //
+  // No levels configured makes HIER equivalent to NR
+  {
+    setenv("YGM_FAKE_RANKS_PER_NODE", "1", 1);
+    setenv("YGM_COMM_ROUTING_LEVELS", "", 1);
+    setenv("YGM_COMM_RANKS_PER_SOCKET", "0", 1);
+    ygm::comm world(MPI_COMM_WORLD);
+    for (int dest = 0; dest < world.size(); ++dest) {
+      ASSERT_RELEASE(
+          world.router().next_hop(dest, ygm::detail::routing_type::HIER) ==
+          world.router().next_hop(dest, ygm::detail::routing_type::NR));
+    }
+  }
+
+  ASSERT_MPI(MPI_Finalize());
+  return 0;
+}
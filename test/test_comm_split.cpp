@@ -0,0 +1,153 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#undef NDEBUG
+#include <ygm/comm.hpp>
+#include <ygm/detail/ygm_ptr.hpp>
+
+int main(int argc, char** argv) {
+  ASSERT_MPI(MPI_Init(nullptr, nullptr));
+
+  std::vector<std::string> routing_schemes{"NONE", "NR", "NLNR"};
+  for (const auto& routing_scheme : routing_schemes) {
+    setenv("YGM_COMM_ROUTING", routing_scheme.c_str(), 1);
+
+    ygm::comm world(MPI_COMM_WORLD);
+
+    //
+    // Test split layout
+    {
+      auto sub = world.split(world.rank() % 2, world.rank());
+      int  expected_size =
+          world.size() / 2 + (world.rank() % 2 < world.size() % 2);
+      ASSERT_RELEASE(sub->size() == expected_size);
+      ASSERT_RELEASE(sub->rank() == world.rank() / 2);
+    }
+
+    //
+    // Test all ranks async to all others within sub-communicator
+    {
+      auto   sub = world.split(world.rank() % 2, world.rank());
+      size_t counter{};
+      auto   pcounter = sub->make_ygm_ptr(counter);
+      for (int dest = 0; dest < sub->size(); ++dest) {
+        sub->async(
+            dest,
+            [](auto pcomm, auto pcounter, int world_size) {
+              ASSERT_RELEASE(world_size == 1 || pcomm->size() < world_size);
+              (*pcounter)++;
+            },
+            pcounter, world.size());
+      }
+      sub->barrier();
+      ASSERT_RELEASE(counter == (size_t)sub->size());
+    }
+
+    //
+    // Test recursive async uses sub-communicator ranks
+    {
+      auto   sub = world.split(world.rank() % 2, world.rank());
+      size_t counter{};
+      auto   pcounter = sub->make_ygm_ptr(counter);
+      sub->async(
+          (sub->rank() + 1) % sub->size(),
+          [](auto pcomm, auto pcounter, int origin) {
+            pcomm->async(
+                origin, [](auto pcounter) { (*pcounter)++; }, pcounter);
+          },
+          pcounter, sub->rank());
+      sub->barrier();
+      ASSERT_RELEASE(counter == 1);
+    }
+
+    //
+    // Test sub-communicator and world messages interleave
+    {
+      auto   sub = world.split(world.rank() % 2, world.rank());
+      size_t world_counter{};
+      size_t sub_counter{};
+      auto   pworld_counter = world.make_ygm_ptr(world_counter);
+      auto   psub_counter   = sub->make_ygm_ptr(sub_counter);
+      for (int i = 0; i < 100; ++i) {
+        world.async(
+            i % world.size(), [](auto p) { (*p)++; }, pworld_counter);
+        sub->async(
+            i % sub->size(), [](auto p) { (*p)++; }, psub_counter);
+      }
+      sub->barrier();
+      world.barrier();
+      ASSERT_RELEASE(world.all_reduce_sum(world_counter) ==
+                     100 * (size_t)world.size());
+      ASSERT_RELEASE(sub->all_reduce_sum(sub_counter) ==
+                     100 * (size_t)sub->size());
+    }
+
+    //
+    // Test async_bcast and collectives on a sub-communicator
+    {
+      auto   sub = world.split(world.rank() < world.size() / 2, world.rank());
+      size_t counter{};
+      auto   pcounter = sub->make_ygm_ptr(counter);
+      if (sub->rank0()) {
+        sub->async_bcast([](auto pcounter) { (*pcounter)++; }, pcounter);
+      }
+      sub->barrier();
+      ASSERT_RELEASE(counter == 1);
+
+      auto sum = sub->all_reduce_sum(size_t(1));
+      ASSERT_RELEASE(sum == (size_t)sub->size());
+    }
+
+    //
+    // Test splitting a sub-communicator
+    {
+      auto   sub    = world.split(world.rank() % 2, world.rank());
+      auto   subsub = sub->split(0, sub->size() - sub->rank());
+      size_t counter{};
+      auto   pcounter = subsub->make_ygm_ptr(counter);
+      ASSERT_RELEASE(subsub->size() == sub->size());
+      ASSERT_RELEASE(subsub->rank() == sub->size() - sub->rank() - 1);
+      for (int dest = 0; dest < subsub->size(); ++dest) {
+        subsub->async(
+            dest, [](auto pcounter) { (*pcounter)++; }, pcounter);
+      }
+      subsub->barrier();
+      ASSERT_RELEASE(counter == (size_t)subsub->size());
+    }
+  }
+
+  //
+  // Test uneven splits of fake nodes keep each rank on its parent node
+  {
+    int world_size;
+    ASSERT_MPI(MPI_Comm_size(MPI_COMM_WORLD, &world_size));
+    if (world_size % 2 == 0) {
+      setenv("YGM_FAKE_RANKS_PER_NODE", "2", 1);
+      setenv("YGM_COMM_ROUTING", "NLNR", 1);
+      ygm::comm world(MPI_COMM_WORLD);
+
+      // Rank 0 alone, every other rank together
+      auto sub    = world.split(world.rank() == 0, world.rank());
+      int  offset = world.rank() == 0 ? 0 : 1;
+      for (int dest = 0; dest < sub->size(); ++dest) {
+        ASSERT_RELEASE(sub->layout().is_local(dest) ==
+                       world.layout().is_local(dest + offset));
+      }
+
+      size_t counter{};
+      auto   pcounter = sub->make_ygm_ptr(counter);
+      for (int dest = 0; dest < sub->size(); ++dest) {
+        sub->async(
+            dest, [](auto pcounter) { (*pcounter)++; }, pcounter);
+      }
+      sub->barrier();
+      ASSERT_RELEASE(counter == (size_t)sub->size());
+      unsetenv("YGM_FAKE_RANKS_PER_NODE");
+    }
+  }
+
+  ASSERT_MPI(MPI_Finalize());
+  return 0;
+}
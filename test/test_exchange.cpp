@@ -0,0 +1,73 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#undef NDEBUG
+#include <string>
+#include <ygm/collective.hpp>
+#include <ygm/comm.hpp>
+
+int main(int argc, char **argv) {
+  ygm::comm world(&argc, &argv);
+
+  //
+  // Test exchange of trivially copyable items, ordered by source
+  {
+    std::vector<std::vector<int>> outgoing(world.size());
+    for (int dest = 0; dest < world.size(); ++dest) {
+      for (int i = 0; i < dest + 1; ++i) {
+        outgoing[dest].push_back(world.rank() * 1000 + i);
+      }
+    }
+    auto received = ygm::exchange(outgoing, world);
+
+    ASSERT_RELEASE(received.size() ==
+                   size_t(world.size() * (world.rank() + 1)));
+    size_t index = 0;
+    for (int from = 0; from < world.size(); ++from) {
+      for (int i = 0; i < world.rank() + 1; ++i) {
+        ASSERT_RELEASE(received[index++] == from * 1000 + i);
+      }
+    }
+  }
+
+  //
+  // Test exchange of serialized items in small chunks
+  {
+    std::vector<std::vector<std::string>> outgoing(world.size());
+    for (int dest = 0; dest < world.size(); ++dest) {
+      for (int i = 0; i < 1000; ++i) {
+        outgoing[dest].push_back(std::to_string(world.rank()) + "->" +
+                                 std::to_string(dest));
+      }
+    }
+
+    size_t           count = 0;
+    std::vector<int> per_source(world.size(), 0);
+    ygm::exchange(
+        outgoing,
+        [&](int from, const std::string &item) {
+          ASSERT_RELEASE(item == std::to_string(from) + "->" +
+                                     std::to_string(world.rank()));
+          ++per_source[from];
+          ++count;
+        },
+        world, 256);
+
+    ASSERT_RELEASE(count == 1000 * size_t(world.size()));
+    for (int n : per_source) {
+      ASSERT_RELEASE(n == 1000);
+    }
+  }
+
+  //
+  // Test exchange with nothing to send
+  {
+    std::vector<std::vector<double>> outgoing(world.size());
+    auto received = ygm::exchange(outgoing, world);
+    ASSERT_RELEASE(received.empty());
+  }
+
+  return 0;
+}
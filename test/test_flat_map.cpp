@@ -0,0 +1,139 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#undef NDEBUG
+#include <map>
+#include <random>
+#include <string>
+#include <ygm/comm.hpp>
+#include <ygm/container/map.hpp>
+
+int main(int argc, char **argv) {
+  ygm::comm world(&argc, &argv);
+
+  //
+  // Test local flat_hash_map against std::map
+  {
+    ygm::container::detail::flat_hash_map<uint64_t, uint64_t> table;
+    std::map<uint64_t, uint64_t>                              reference;
+    std::mt19937_64                                           rng(world.rank());
+    for (int i = 0; i < 100000; ++i) {
+      uint64_t key = rng() % 5000;
+      switch (rng() % 3) {
+        case 0:
+          ASSERT_RELEASE(table.insert({key, uint64_t(i)}).second ==
+                         reference.insert({key, uint64_t(i)}).second);
+          break;
+        case 1:
+          ASSERT_RELEASE(table.erase(key) == reference.erase(key));
+          break;
+        case 2:
+          ASSERT_RELEASE(table.count(key) == reference.count(key));
+          if (table.count(key)) {
+            ASSERT_RELEASE(table.find(key)->second == reference[key]);
+          }
+          break;
+      }
+      ASSERT_RELEASE(table.size() == reference.size());
+    }
+    size_t iterated = 0;
+    for (const auto &kv : table) {
+      ASSERT_RELEASE(reference.at(kv.first) == kv.second);
+      ++iterated;
+    }
+    ASSERT_RELEASE(iterated == reference.size());
+
+    auto copy = table;
+    table.clear();
+    ASSERT_RELEASE(table.empty() && table.begin() == table.end());
+    ASSERT_RELEASE(copy.size() == reference.size());
+  }
+
+  //
+  // Test basic tagging
+  {
+    ygm::container::flat_map<std::string, int> smap(world);
+
+    static_assert(std::is_same_v<decltype(smap)::self_type, decltype(smap)>);
+    static_assert(std::is_same_v<decltype(smap)::mapped_type, int>);
+    static_assert(std::is_same_v<decltype(smap)::key_type, std::string>);
+    static_assert(
+        std::is_same_v<
+            decltype(smap)::ygm_for_all_types,
+            std::tuple<decltype(smap)::key_type, decltype(smap)::mapped_type>>);
+  }
+
+  //
+  // Test all ranks async_insert & async_erase
+  {
+    ygm::container::flat_map<std::string, std::string> smap(world);
+
+    smap.async_insert("dog", "cat");
+    smap.async_insert("apple", "orange");
+    smap.async_insert("red", "green");
+
+    ASSERT_RELEASE(smap.size() == 3);
+    ASSERT_RELEASE(smap.count("dog") == 1);
+    ASSERT_RELEASE(smap.count("apple") == 1);
+    ASSERT_RELEASE(smap.count("red") == 1);
+
+    if (world.rank0()) {
+      smap.async_erase("dog");
+    }
+    ASSERT_RELEASE(smap.size() == 2);
+    ASSERT_RELEASE(smap.count("dog") == 0);
+  }
+
+  //
+  // Test async_insert_if_missing & async_visit
+  {
+    ygm::container::flat_map<std::string, std::string> smap(world);
+
+    smap.async_insert_if_missing("dog", "cat");
+    world.barrier();
+    smap.async_insert_if_missing("dog", "dog");
+    world.barrier();
+
+    smap.async_visit(
+        "dog", [](auto key, auto &value) { ASSERT_RELEASE(value == "cat"); });
+    smap.async_visit("new", [](auto key, auto &value) { value = "default"; });
+    world.barrier();
+    ASSERT_RELEASE(smap.size() == 2);
+  }
+
+  //
+  // Test async_reduce over many keys
+  {
+    ygm::container::flat_map<int, int> imap(world);
+    int                                num_keys = 10000;
+    for (int i = 0; i < num_keys; ++i) {
+      imap.async_reduce(i, 1, std::plus<int>());
+    }
+    world.barrier();
+    ASSERT_RELEASE(imap.size() == size_t(num_keys));
+    imap.for_all([&world](const int &key, const int &value) {
+      ASSERT_RELEASE(value == world.size());
+    });
+  }
+
+  //
+  // Test serialization round trip
+  {
+    ygm::container::flat_map<std::string, int> smap(world);
+    smap.async_insert("one", 1);
+    smap.async_insert("two", 2);
+    smap.serialize("test_flat_map.serialized");
+
+    ygm::container::flat_map<std::string, int> reloaded(world);
+    reloaded.deserialize("test_flat_map.serialized");
+    ASSERT_RELEASE(reloaded.size() == 2);
+    reloaded.for_all([](const std::string &key, const int &value) {
+      ASSERT_RELEASE((key == "one" && value == 1) ||
+                     (key == "two" && value == 2));
+    });
+  }
+
+  return 0;
+}
@@ -0,0 +1,74 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#undef NDEBUG
+#include <set>
+#include <string>
+#include <ygm/comm.hpp>
+#include <ygm/container/set.hpp>
+
+int main(int argc, char **argv) {
+  ygm::comm world(&argc, &argv);
+
+  //
+  // Test local flat_hash_set against std::set, including erase by iterator
+  {
+    ygm::container::detail::flat_hash_set<std::string> table;
+    std::set<std::string>                              reference;
+    for (int i = 0; i < 10000; ++i) {
+      std::string key = std::to_string(i % 3000);
+      if (i % 4 == 3) {
+        ASSERT_RELEASE(table.erase(key) == reference.erase(key));
+      } else {
+        ASSERT_RELEASE(table.insert(key).second ==
+                       reference.insert(key).second);
+      }
+    }
+    ASSERT_RELEASE(table.size() == reference.size());
+    while (!table.empty()) {
+      ASSERT_RELEASE(reference.erase(*table.begin()) == 1);
+      table.erase(table.begin());
+    }
+    ASSERT_RELEASE(reference.empty());
+  }
+
+  //
+  // Test all ranks async_insert
+  {
+    ygm::container::flat_set<std::string> sset(world);
+    sset.async_insert("dog");
+    sset.async_insert("apple");
+    sset.async_insert("red");
+    ASSERT_RELEASE(sset.size() == 3);
+    ASSERT_RELEASE(sset.count("dog") == 1);
+    ASSERT_RELEASE(sset.count("cat") == 0);
+  }
+
+  //
+  // Test async_insert_exe_if_missing
+  {
+    ygm::container::flat_set<int> iset(world);
+    static int                    first_inserts = 0;
+    iset.async_insert_exe_if_missing(
+        42, [](const int &key) { ++first_inserts; });
+    world.barrier();
+    ASSERT_RELEASE(world.all_reduce_sum(first_inserts) == 1);
+  }
+
+  //
+  // Test consume_all
+  {
+    ygm::container::flat_set<int> iset1(world);
+    ygm::container::flat_set<int> iset2(world);
+    for (int i = 0; i < 1000; ++i) {
+      iset1.async_insert(i);
+    }
+    iset1.consume_all([&iset2](const int &key) { iset2.async_insert(key); });
+    ASSERT_RELEASE(iset1.empty());
+    ASSERT_RELEASE(iset2.size() == 1000);
+  }
+
+  return 0;
+}
@@ -0,0 +1,122 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#undef NDEBUG
+#include <string>
+#include <ygm/comm.hpp>
+#include <ygm/container/detail/bulk_lookup.hpp>
+#include <ygm/container/map.hpp>
+#include <ygm/container/set.hpp>
+
+int main(int argc, char **argv) {
+  ygm::comm world(&argc, &argv);
+
+  //
+  // Test eytzinger_index finds every key and walks them in order
+  {
+    for (int n = 0; n < 70; ++n) {
+      std::vector<int> sorted;
+      for (int i = 0; i < n; ++i) {
+        sorted.push_back(2 * i);
+      }
+      ygm::container::detail::eytzinger_index<int> index;
+      auto order = index.build(std::vector<int>(sorted));
+      ASSERT_RELEASE(index.size() == size_t(n));
+
+      for (int i = 0; i < n; ++i) {
+        size_t slot = index.find(2 * i);
+        ASSERT_RELEASE(slot != index.npos);
+        ASSERT_RELEASE(index.key(slot) == 2 * i);
+        ASSERT_RELEASE(order[slot] == size_t(i));
+        ASSERT_RELEASE(index.find(2 * i + 1) == index.npos);
+      }
+      ASSERT_RELEASE(index.find(-1) == index.npos);
+
+      std::vector<int> walked;
+      index.for_each_in_order(
+          [&](const size_t slot) { walked.push_back(index.key(slot)); });
+      ASSERT_RELEASE(walked == sorted);
+    }
+  }
+
+  //
+  // Test freezing a map keeps every entry in place
+  {
+    ygm::container::map<int, std::string> smap(world);
+    for (int i = world.rank(); i < 1000; i += world.size()) {
+      smap.async_insert(i, std::to_string(i));
+    }
+    size_t local = 0;
+    smap.for_all([&local](const int &key, std::string &value) { ++local; });
+
+    auto frozen = smap.freeze();
+    ASSERT_RELEASE(smap.size() == 0);
+    ASSERT_RELEASE(frozen.size() == 1000);
+    ASSERT_RELEASE(frozen.local_size() == local);
+    ASSERT_RELEASE(frozen.count(10) == 1);
+    ASSERT_RELEASE(frozen.count(1000) == 0);
+
+    int prev = -1;
+    frozen.for_all([&prev, &frozen](const int &key, const std::string &value) {
+      ASSERT_RELEASE(key > prev);
+      ASSERT_RELEASE(value == std::to_string(key));
+      ASSERT_RELEASE(frozen.is_mine(key));
+      prev = key;
+    });
+
+    static size_t visited;
+    visited = 0;
+    world.cf_barrier();
+    for (int i = 0; i < 1100; ++i) {
+      frozen.async_visit_if_exists(
+          i, [](const int &key, const std::string &value) {
+            ASSERT_RELEASE(value == std::to_string(key));
+            ++visited;
+          });
+    }
+    world.barrier();
+    ASSERT_RELEASE(world.all_reduce_sum(visited) == 1000 * world.size());
+
+    // Works with bulk lookups like any map
+    size_t found = 0;
+    ygm::container::detail::bulk_lookup(
+        frozen, std::vector<int>{1, 2, 2000},
+        [&found](const int &key, const std::string &value) { ++found; });
+    ASSERT_RELEASE(found == 2);
+  }
+
+  //
+  // Test freezing a set
+  {
+    ygm::container::flat_set<std::string> sset(world);
+    sset.async_insert("dog");
+    sset.async_insert("cat");
+
+    auto frozen = sset.freeze();
+    ASSERT_RELEASE(frozen.size() == 2);
+    ASSERT_RELEASE(sset.size() == 0);
+
+    static int present;
+    static int missing;
+    present = 0;
+    missing = 0;
+    world.cf_barrier();
+    for (const std::string &key : {"dog", "cat", "bird"}) {
+      frozen.async_exe_if_contains(key,
+                                   [](const std::string &key) { ++present; });
+      frozen.async_exe_if_missing(key,
+                                  [](const std::string &key) { ++missing; });
+    }
+    world.barrier();
+    ASSERT_RELEASE(world.all_reduce_sum(present) == 2 * world.size());
+    ASSERT_RELEASE(world.all_reduce_sum(missing) == world.size());
+
+    std::vector<std::string> keys;
+    frozen.for_all([&keys](const std::string &key) { keys.push_back(key); });
+    ASSERT_RELEASE(std::is_sorted(keys.begin(), keys.end()));
+  }
+
+  return 0;
+}
@@ -0,0 +1,136 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#undef NDEBUG
+#include <numeric>
+#include <string>
+#include <ygm/comm.hpp>
+#include <ygm/container/map.hpp>
+
+int main(int argc, char **argv) {
+  ygm::comm world(&argc, &argv);
+
+  //
+  // Test all ranks async_insert
+  {
+    ygm::container::grouped_multimap<std::string, std::string> smap(world);
+
+    smap.async_insert("dog", "bark");
+    smap.async_insert("dog", "woof");
+    smap.async_insert("cat", "meow");
+
+    ASSERT_RELEASE(smap.size() == 3 * size_t(world.size()));
+    ASSERT_RELEASE(smap.num_keys() == 2);
+    ASSERT_RELEASE(smap.count("dog") == 2 * size_t(world.size()));
+    ASSERT_RELEASE(smap.count("cat") == size_t(world.size()));
+    ASSERT_RELEASE(smap.count("red") == 0);
+  }
+
+  //
+  // Test async_visit_group receives contiguous values
+  {
+    ygm::container::grouped_multimap<int, int> imap(world);
+
+    for (int i = 0; i < 100; ++i) {
+      imap.async_insert(i % 10, i);
+    }
+    world.barrier();
+
+    for (int k = 0; k < 10; ++k) {
+      imap.async_visit_group(k, [](auto pmap, const int &key, auto group) {
+        ASSERT_RELEASE(group.size() == 10 * size_t(pmap->comm().size()));
+        ASSERT_RELEASE(&group.back() - &group.front() ==
+                       std::ptrdiff_t(group.size()) - 1);
+        for (const auto &v : group) {
+          ASSERT_RELEASE(v % 10 == key);
+        }
+      });
+    }
+    world.barrier();
+
+    // Group values are mutable in place
+    imap.async_visit_group(3, [](const int &key, auto group) {
+      for (auto &v : group) {
+        v = -1;
+      }
+    });
+    world.barrier();
+    imap.async_visit(3, [](const int &key, int &value) {
+      ASSERT_RELEASE(value == -1);
+    });
+  }
+
+  //
+  // Test local_get returns a view
+  {
+    ygm::container::grouped_multimap<int, int> imap(world);
+
+    imap.async_insert(7, world.rank());
+    world.barrier();
+
+    auto group = imap.local_get(7);
+    if (imap.is_mine(7)) {
+      ASSERT_RELEASE(group.size() == size_t(world.size()));
+      int sum = std::accumulate(group.begin(), group.end(), 0);
+      ASSERT_RELEASE(sum == world.size() * (world.size() - 1) / 2);
+    } else {
+      ASSERT_RELEASE(group.empty());
+    }
+  }
+
+  //
+  // Test async_erase, for_all & for_all_groups
+  {
+    ygm::container::grouped_multimap<int, int> imap(world);
+
+    for (int i = 0; i < 20; ++i) {
+      imap.async_insert(i % 4, i);
+    }
+    world.barrier();
+    if (world.rank0()) {
+      imap.async_erase(0);
+    }
+    ASSERT_RELEASE(imap.size() == 15 * size_t(world.size()));
+
+    size_t local_values = 0;
+    imap.for_all([&local_values](const int &key, int &value) {
+      ASSERT_RELEASE(key != 0);
+      ++local_values;
+    });
+    ASSERT_RELEASE(world.all_reduce_sum(local_values) == imap.size());
+
+    size_t local_groups = 0;
+    imap.for_all_groups([&local_groups](const int &key, auto group) {
+      ASSERT_RELEASE(group.size() > 0);
+      ++local_groups;
+    });
+    ASSERT_RELEASE(world.all_reduce_sum(local_groups) == 3);
+  }
+
+  //
+  // Test all_gather, swap & serialization
+  {
+    ygm::container::grouped_multimap<std::string, int> smap(world);
+    smap.async_insert("one", 1);
+    smap.async_insert("two", 2);
+
+    auto gathered = smap.all_gather(std::vector<std::string>{"one", "three"});
+    ASSERT_RELEASE(gathered.count("one") == size_t(world.size()));
+    ASSERT_RELEASE(gathered.count("three") == 0);
+
+    ygm::container::grouped_multimap<std::string, int> smap2(world);
+    smap2.swap(smap);
+    ASSERT_RELEASE(smap.size() == 0);
+    ASSERT_RELEASE(smap2.size() == 2 * size_t(world.size()));
+
+    smap2.serialize("test_grouped_multimap.serialized");
+    ygm::container::grouped_multimap<std::string, int> reloaded(world);
+    reloaded.deserialize("test_grouped_multimap.serialized");
+    ASSERT_RELEASE(reloaded.size() == 2 * size_t(world.size()));
+    ASSERT_RELEASE(reloaded.count("two") == size_t(world.size()));
+  }
+
+  return 0;
+}
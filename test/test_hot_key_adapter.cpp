@@ -0,0 +1,92 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#undef NDEBUG
+#include <ygm/comm.hpp>
+#include <ygm/container/detail/heavy_hitters.hpp>
+#include <ygm/container/hot_key_adapter.hpp>
+#include <ygm/container/map.hpp>
+
+int main(int argc, char **argv) {
+  ygm::comm world(&argc, &argv);
+
+  //
+  // Test heavy_hitters finds the skewed keys of a stream
+  {
+    ygm::container::detail::heavy_hitters<int> sketch(20);
+    for (int i = 0; i < 10000; ++i) {
+      sketch.insert(i % 2 == 0 ? 7 : (i % 3 == 0 ? 11 : i));
+    }
+    ASSERT_RELEASE(sketch.total() == 10000);
+
+    auto heavy = sketch.global_heavy(world, 0.1);
+    ASSERT_RELEASE(heavy.size() == 2);
+    ASSERT_RELEASE(heavy[0] == 7 && heavy[1] == 11);
+  }
+
+  //
+  // Test hot keys are pre-aggregated and replicated
+  {
+    ygm::container::map<int, size_t> counts(world);
+    const size_t                     num_ops = 20000;
+
+    {
+      auto adapter = ygm::container::make_hot_key_adapter(
+          counts, [](const size_t a, const size_t b) { return a + b; });
+
+      // Half of all traffic hits key 0
+      for (size_t round = 0; round < 2; ++round) {
+        for (size_t i = 0; i < num_ops; ++i) {
+          adapter.async_reduce(i % 2 == 0 ? 0 : int(1 + (i / 2) % 1000), 1);
+        }
+        adapter.sync();
+        ASSERT_RELEASE(adapter.num_hot_keys() == 1);
+        ASSERT_RELEASE(adapter.is_hot(0));
+      }
+
+      // Replica holds the combined total
+      size_t seen = 0;
+      adapter.async_visit_if_exists(
+          0, [&seen](const int &key, const size_t &count) { seen = count; });
+      ASSERT_RELEASE(seen == num_ops * world.size());
+
+      // Replicas accept visitors taking the cache pointer too
+      static size_t seen_ptr;
+      seen_ptr = 0;
+      adapter.async_visit_if_exists(
+          0, [](auto pcache, const int &key, const size_t &count) {
+            seen_ptr = count;
+          });
+      ASSERT_RELEASE(seen_ptr == num_ops * world.size());
+
+      size_t cold = 0;
+      adapter.async_visit_if_exists(
+          1, [&cold](const int &key, const size_t &count) { cold = count; });
+      world.barrier();
+      ASSERT_RELEASE(cold == 20 * world.size());
+
+      auto stats = adapter.load_stats();
+      ASSERT_RELEASE(stats.num_hot_keys == 1);
+      if (world.size() > 1) {
+        ASSERT_RELEASE(stats.actual_imbalance() < stats.direct_imbalance());
+      }
+
+      // Reductions into hot keys reach the map at an ordinary barrier
+      ASSERT_RELEASE(adapter.is_hot(0));
+      adapter.async_reduce(0, 1);
+      world.barrier();
+      auto hot_total = counts.all_gather({0});
+      ASSERT_RELEASE(hot_total[0] == (num_ops + 1) * world.size());
+    }
+
+    ASSERT_RELEASE(counts.size() == 1001);
+    auto totals = counts.all_gather({0, 1, 1000});
+    ASSERT_RELEASE(totals[0] == (num_ops + 1) * world.size());
+    ASSERT_RELEASE(totals[1] == 20 * world.size());
+    ASSERT_RELEASE(totals[1000] == 20 * world.size());
+  }
+
+  return 0;
+}
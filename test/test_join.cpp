@@ -0,0 +1,122 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#undef NDEBUG
+#include <string>
+#include <ygm/comm.hpp>
+#include <ygm/container/bag.hpp>
+#include <ygm/container/join.hpp>
+#include <ygm/container/map.hpp>
+#include <ygm/container/set.hpp>
+
+int main(int argc, char **argv) {
+  ygm::comm world(&argc, &argv);
+
+  // Keys 0..99 on the left, even keys 0..198 on the right
+  ygm::container::map<int, int>               names(world);
+  ygm::container::bag<std::pair<int, int>>    left_bag(world);
+  ygm::container::bag<std::pair<int, double>> right_bag(world);
+  ygm::container::multimap<int, double>       right_multimap(world);
+  ygm::container::set<int>                    right_set(world);
+  if (world.rank0()) {
+    for (int i = 0; i < 100; ++i) {
+      names.async_insert(i, 10 * i);
+      left_bag.async_insert(std::make_pair(i, 10 * i));
+    }
+    for (int i = 0; i < 200; i += 2) {
+      right_bag.async_insert(std::make_pair(i, i / 2.0));
+      right_multimap.async_insert(i, i / 2.0);
+      right_multimap.async_insert(i, i / 4.0);
+      right_set.async_insert(i);
+    }
+  }
+  world.barrier();
+
+  for (bool bloom : {false, true}) {
+    //
+    // Test inner join of a bag against a bag
+    {
+      size_t matches = 0;
+      ygm::container::inner_join(
+          left_bag, right_bag,
+          [&matches](const int &key, const int &lv, const double &rv) {
+            ASSERT_RELEASE(key % 2 == 0 && key < 100);
+            ASSERT_RELEASE(lv == 10 * key);
+            ASSERT_RELEASE(rv == key / 2.0);
+            ++matches;
+          },
+          bloom);
+      ASSERT_RELEASE(world.all_reduce_sum(matches) == 50);
+    }
+
+    //
+    // Test inner join of a map against a multimap, which is co-partitioned
+    {
+      size_t matches = 0;
+      ygm::container::inner_join(
+          names, right_multimap,
+          [&names, &matches](const int &key, const int &lv, const double &rv) {
+            ASSERT_RELEASE(names.is_mine(key));
+            ASSERT_RELEASE(rv == key / 2.0 || rv == key / 4.0);
+            ++matches;
+          },
+          bloom);
+      ASSERT_RELEASE(world.all_reduce_sum(matches) == 100);
+    }
+
+    //
+    // Test inner join of a bag against a map, where only the bag moves
+    {
+      size_t matches = 0;
+      ygm::container::inner_join(
+          right_bag, names,
+          [&names, &matches](const int &key, const double &lv, const int &rv) {
+            ASSERT_RELEASE(names.is_mine(key));
+            ASSERT_RELEASE(rv == 10 * key);
+            ++matches;
+          },
+          bloom);
+      ASSERT_RELEASE(world.all_reduce_sum(matches) == 50);
+    }
+
+    //
+    // Test left join of a map against a bag, into an output container
+    {
+      ygm::container::map<int, double> joined(world);
+      ygm::container::left_join(
+          names, right_bag,
+          [&joined](const int &key, const int &lv,
+                    const std::optional<double> &rv) {
+            joined.async_insert(key, rv ? *rv : -1.0);
+          },
+          bloom);
+      ASSERT_RELEASE(joined.size() == 100);
+      joined.for_all([](const int &key, const double &value) {
+        ASSERT_RELEASE(value == (key % 2 == 0 ? key / 2.0 : -1.0));
+      });
+    }
+
+    //
+    // Test semi joins against a set
+    {
+      size_t matches = 0;
+      ygm::container::semi_join(
+          left_bag, right_set,
+          [&matches](const int &key, const int &lv) {
+            ASSERT_RELEASE(key % 2 == 0);
+            ++matches;
+          },
+          bloom);
+      ASSERT_RELEASE(world.all_reduce_sum(matches) == 50);
+
+      matches = 0;
+      ygm::container::semi_join(
+          right_set, names, [&matches](const int &key) { ++matches; }, bloom);
+      ASSERT_RELEASE(world.all_reduce_sum(matches) == 50);
+    }
+  }
+
+  return 0;
+}
@@ -7,6 +7,7 @@
 #include <algorithm>
 #include <string>
 #include <ygm/comm.hpp>
+#include <ygm/container/bag.hpp>
 #include <ygm/container/map.hpp>
 
 int main(int argc, char **argv) {
@@ -256,5 +257,36 @@ int main(int argc, char **argv) {
     ASSERT_RELEASE(smap2.count("red") == 1);
   }
 
+  //
+  // Test bulk_load
+  {
+    ygm::container::bag<std::pair<std::string, int>> edges(world);
+    for (int i = 0; i < 100; ++i) {
+      edges.async_insert({std::to_string(i % 10), 1});
+    }
+
+    ygm::container::map<std::string, int> smap(world);
+    smap.async_insert("0", 1000);
+    smap.bulk_load(edges, std::plus<int>());
+    ASSERT_RELEASE(smap.size() == 10);
+    smap.for_all([&world](const std::string &key, const int &value) {
+      int expected = 10 * world.size() + (key == "0" ? 1000 : 0);
+      ASSERT_RELEASE(value == expected);
+    });
+
+    ygm::container::flat_map<int, int> fmap(world);
+    ygm::container::bag<std::pair<int, int>> pairs(world);
+    for (int i = 0; i < 100; ++i) {
+      pairs.async_insert({i % 7, i});
+    }
+    fmap.bulk_load(pairs, [](const int &a, const int &b) {
+      return std::max(a, b);
+    });
+    ASSERT_RELEASE(fmap.size() == 7);
+    fmap.for_all([](const int &key, const int &value) {
+      ASSERT_RELEASE(value == 99 - (99 - key) % 7);
+    });
+  }
+
   return 0;
 }
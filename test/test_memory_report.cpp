@@ -0,0 +1,109 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#undef NDEBUG
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <ygm/comm.hpp>
+#include <ygm/container/bag.hpp>
+#include <ygm/container/counting_set.hpp>
+#include <ygm/container/map.hpp>
+#include <ygm/container/set.hpp>
+#include <ygm/memory_report.hpp>
+
+// Row reported under name, or a zero row if there is none
+ygm::memory_report_row find_row(
+    const std::vector<ygm::memory_report_row> &rows, const std::string &name) {
+  auto itr = std::find_if(rows.begin(), rows.end(), [&name](const auto &row) {
+    return row.name == name;
+  });
+  return itr == rows.end() ? ygm::memory_report_row{name} : *itr;
+}
+
+int main(int argc, char **argv) {
+  ygm::comm world(&argc, &argv);
+
+  //
+  // Test registry lifetime and naming
+  {
+    ygm::detail::memory_registry registry;
+    {
+      ygm::detail::memory_tracker a(registry, "x", []() { return size_t(5); });
+      ygm::detail::memory_tracker b(registry, "x", []() { return size_t(7); });
+      ygm::detail::memory_tracker c(registry, "y", []() { return size_t(1); });
+      ASSERT_RELEASE(registry.totals().at("x") == 12);
+      c.rename("x");
+      ASSERT_RELEASE(registry.totals().at("x") == 13);
+      ASSERT_RELEASE(registry.totals().count("y") == 0);
+    }
+    ASSERT_RELEASE(registry.totals().empty());
+  }
+
+  //
+  // Test containers register while alive and grow with their contents
+  {
+    std::stringstream out;
+    size_t            map_bytes = 0;
+    {
+      ygm::container::map<int, int> imap(world);
+      ygm::container::bag<int>      ibag(world);
+      ASSERT_RELEASE(find_row(ygm::memory_report(world, out), "map").total ==
+                     0);
+
+      for (int i = 0; i < 1000; ++i) {
+        imap.async_insert(i * world.size() + world.rank(), i);
+        ibag.async_insert(i);
+      }
+      auto rows = ygm::memory_report(world, out);
+      ASSERT_RELEASE(find_row(rows, "map").min > 0);
+      ASSERT_RELEASE(find_row(rows, "bag").min > 0);
+      ASSERT_RELEASE(find_row(rows, "map").min <= find_row(rows, "map").max);
+      ASSERT_RELEASE(imap.local_memory_bytes() >= find_row(rows, "map").min);
+      ASSERT_RELEASE(world.all_reduce_sum(imap.local_memory_bytes()) ==
+                     find_row(rows, "map").total);
+      map_bytes = find_row(rows, "map").total;
+
+      imap.set_memory_name("edges");
+      rows = ygm::memory_report(world, out);
+      ASSERT_RELEASE(find_row(rows, "edges").total == map_bytes);
+      ASSERT_RELEASE(find_row(rows, "map").total == 0);
+    }
+    auto rows = ygm::memory_report(world, out);
+    ASSERT_RELEASE(find_row(rows, "edges").total == 0);
+    ASSERT_RELEASE(find_row(rows, "bag").total == 0);
+  }
+
+  //
+  // Test composite containers report under their own name
+  {
+    std::stringstream                out;
+    ygm::container::counting_set<int> cset(world);
+    ygm::container::multiset<int>     mset(world);
+    for (int i = 0; i < 1000; ++i) {
+      cset.async_insert(i % 100);
+      mset.async_insert(i);
+    }
+    auto rows = ygm::memory_report(world, out);
+    ASSERT_RELEASE(find_row(rows, "counting_set").max > 0);
+    ASSERT_RELEASE(find_row(rows, "multiset").max > 0);
+    ASSERT_RELEASE(find_row(rows, "map").total == 0);
+    ASSERT_RELEASE(find_row(rows, "set").total == 0);
+  }
+
+  //
+  // Test comm buffers and process rows
+  {
+    std::stringstream out;
+    auto              rows = ygm::memory_report(world, out);
+    ASSERT_RELEASE(find_row(rows, "comm.irecv_buffers").min > 0);
+    ASSERT_RELEASE(world.memory_usage().total() > 0);
+    if (world.rank0()) {
+      ASSERT_RELEASE(out.str().find("comm.send_buffers") != std::string::npos);
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,119 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#undef NDEBUG
+#include <ygm/comm.hpp>
+#include <ygm/container/bag.hpp>
+#include <ygm/container/ordered_map.hpp>
+
+int main(int argc, char **argv) {
+  ygm::comm world(&argc, &argv);
+
+  //
+  // Test load picks balanced splitters and keeps global order
+  {
+    ygm::container::bag<std::pair<int, int>> input(world);
+    for (int i = world.rank(); i < 10000; i += world.size()) {
+      input.async_insert(std::make_pair(i * 3, i));
+    }
+
+    ygm::container::ordered_map<int, int> omap(world);
+    omap.load(input);
+    ASSERT_RELEASE(omap.size() == 10000);
+    ASSERT_RELEASE(omap.imbalance() < 1.2);
+    ASSERT_RELEASE(omap.splitters().size() == size_t(world.size() - 1));
+
+    int local_min = std::numeric_limits<int>::max();
+    int local_max = std::numeric_limits<int>::min();
+    int prev      = -1;
+    omap.for_all([&](const int &key, int &value) {
+      ASSERT_RELEASE(key > prev);
+      ASSERT_RELEASE(omap.is_mine(key));
+      prev      = key;
+      local_min = std::min(local_min, key);
+      local_max = std::max(local_max, key);
+    });
+
+    // Ranks hold ascending, disjoint ranges
+    auto all_max = world.all_reduce(
+        std::vector<int>{local_max},
+        [](const std::vector<int> &a, const std::vector<int> &b) {
+          std::vector<int> out(a);
+          out.insert(out.end(), b.begin(), b.end());
+          return out;
+        });
+    for (int max : all_max) {
+      ASSERT_RELEASE(max < local_min || max >= local_max);
+    }
+  }
+
+  //
+  // Test async_visit_range touches only overlapping ranks
+  {
+    ygm::container::ordered_map<int, int> omap(world);
+    if (world.rank0()) {
+      for (int i = 0; i < 1000; ++i) {
+        omap.async_insert(i, i);
+      }
+    }
+    omap.rebalance();
+    ASSERT_RELEASE(omap.imbalance() < 1.2);
+
+    static size_t visited;
+    visited = 0;
+    world.cf_barrier();
+
+    if (world.rank0()) {
+      // Entirely inside one rank's range
+      omap.async_visit_range(
+          omap.splitters().empty() ? 0 : omap.splitters()[0] - 20,
+          omap.splitters().empty() ? 10 : omap.splitters()[0] - 10,
+          [](const int &key, int &value) { ++visited; });
+      omap.async_visit_range(100, 400, [](auto pmap, const int &key,
+                                          int &value) { ++visited; });
+    }
+    world.barrier();
+    ASSERT_RELEASE(world.all_reduce_sum(visited) == 310);
+
+    // Keys visited in order within each rank
+    static int last_key;
+    last_key = -1;
+    world.cf_barrier();
+    if (world.rank0()) {
+      omap.async_visit_range(0, 1000, [](const int &key, int &value) {
+        ASSERT_RELEASE(key > last_key);
+        last_key = key;
+      });
+    }
+    world.barrier();
+  }
+
+  //
+  // Test rebalance after skewed inserts
+  {
+    ygm::container::ordered_map<int, int> omap(world);
+    for (int i = world.rank(); i < 4000; i += world.size()) {
+      omap.async_insert(i, i);
+    }
+    omap.rebalance();
+    for (int i = 4000 + world.rank(); i < 8000; i += world.size()) {
+      omap.async_insert(i, i);
+    }
+    world.barrier();
+    if (world.size() > 1) {
+      ASSERT_RELEASE(omap.imbalance() > 1.5);
+    }
+    omap.rebalance();
+    ASSERT_RELEASE(omap.imbalance() < 1.2);
+    ASSERT_RELEASE(omap.size() == 8000);
+
+    omap.async_visit_if_exists(
+        7999, [](const int &key, int &value) { ASSERT_RELEASE(value == key); });
+    omap.async_erase(7999);
+    ASSERT_RELEASE(omap.count(7999) == 0);
+  }
+
+  return 0;
+}
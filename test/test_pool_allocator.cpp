@@ -0,0 +1,134 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#undef NDEBUG
+#include <array>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include <ygm/comm.hpp>
+#include <ygm/container/counting_set.hpp>
+#include <ygm/container/detail/pool_allocator.hpp>
+#include <ygm/container/disjoint_set.hpp>
+#include <ygm/container/map.hpp>
+#include <ygm/container/set.hpp>
+
+using ygm::container::detail::pool_allocator;
+
+int main(int argc, char **argv) {
+  ygm::comm world(&argc, &argv);
+
+  //
+  // Test node storage comes from the arena and is released by clear()
+  {
+    using alloc_type = pool_allocator<std::pair<const int, std::string>>;
+    std::multimap<int, std::string, std::less<int>, alloc_type> m;
+    for (int i = 0; i < 10000; ++i) {
+      m.emplace(i % 1000, std::to_string(i));
+    }
+    auto stats = m.get_allocator().stats();
+    ASSERT_RELEASE(stats.slabs > 0);
+    ASSERT_RELEASE(stats.bytes_in_use >= 10000 * sizeof(std::string));
+    ASSERT_RELEASE(stats.bytes_reserved >= stats.bytes_in_use);
+
+    // Erased nodes are reused rather than growing the arena
+    for (int i = 0; i < 1000; ++i) {
+      m.erase(m.begin());
+      m.emplace(2000 + i, "x");
+    }
+    ASSERT_RELEASE(m.get_allocator().stats().bytes_reserved ==
+                   stats.bytes_reserved);
+
+    m.clear();
+    stats = m.get_allocator().stats();
+    ASSERT_RELEASE(stats.slabs == 0);
+    ASSERT_RELEASE(stats.bytes_in_use == 0);
+
+    m.emplace(1, "one");
+    ASSERT_RELEASE(m.find(1)->second == "one");
+  }
+
+  //
+  // Test copies get their own arena, swaps carry theirs along
+  {
+    std::set<int, std::less<int>, pool_allocator<int>> a, b;
+    for (int i = 0; i < 100; ++i) {
+      a.insert(i);
+    }
+    ASSERT_RELEASE(a.get_allocator() != b.get_allocator());
+
+    auto c = a;
+    ASSERT_RELEASE(c == a);
+    ASSERT_RELEASE(c.get_allocator() != a.get_allocator());
+
+    auto a_alloc = a.get_allocator();
+    a.swap(b);
+    ASSERT_RELEASE(b.get_allocator() == a_alloc);
+    ASSERT_RELEASE(b.size() == 100);
+
+    auto d = std::move(b);
+    ASSERT_RELEASE(d.size() == 100);
+    b.insert(5);
+    ASSERT_RELEASE(b.count(5) == 1);
+  }
+
+  //
+  // Test array and over-sized allocations fall through to std::allocator
+  {
+    std::vector<int, pool_allocator<int>> v(1000, 7);
+    ASSERT_RELEASE(v.get_allocator().stats().slabs == 0);
+    ASSERT_RELEASE(v[999] == 7);
+
+    pool_allocator<std::array<char, 1024>> big;
+    auto                                   *p = big.allocate(1);
+    ASSERT_RELEASE(big.stats().bytes_in_use == 0);
+    big.deallocate(p, 1);
+  }
+
+  //
+  // Test huge page arenas
+  {
+    using alloc_type = pool_allocator<std::pair<const int, int>, true>;
+    std::map<int, int, std::less<int>, alloc_type> m;
+    for (int i = 0; i < 1000; ++i) {
+      m[i] = i;
+    }
+    auto stats = m.get_allocator().stats();
+    ASSERT_RELEASE(stats.bytes_reserved ==
+                   stats.slabs * ygm::container::detail::slab_arena::
+                                     huge_page_bytes);
+    m.clear();
+    ASSERT_RELEASE(m.get_allocator().stats().slabs == 0);
+  }
+
+  //
+  // Test containers using it by default
+  {
+    ygm::container::map<std::string, int> smap(world);
+    ygm::container::set<int>              iset(world);
+    ygm::container::counting_set<int>     cset(world);
+    ygm::container::disjoint_set<int>     dset(world);
+    for (int i = 0; i < 1000; ++i) {
+      smap.async_insert(std::to_string(i), i);
+      iset.async_insert(i);
+      cset.async_insert(i % 10);
+      dset.async_union(i, i + 1);
+    }
+    ASSERT_RELEASE(smap.size() == 1000);
+    ASSERT_RELEASE(iset.size() == 1000);
+    ASSERT_RELEASE(cset.count(3) == 100 * world.size());
+    ASSERT_RELEASE(dset.num_sets() == 1);
+
+    smap.clear();
+    iset.clear();
+    ASSERT_RELEASE(smap.size() == 0);
+    ASSERT_RELEASE(iset.size() == 0);
+    smap.async_insert("again", 1);
+    ASSERT_RELEASE(smap.count("again") == 1);
+  }
+
+  return 0;
+}
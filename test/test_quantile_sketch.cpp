@@ -0,0 +1,91 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#undef NDEBUG
+#include <cmath>
+#include <string>
+#include <ygm/comm.hpp>
+#include <ygm/container/detail/kll_sketch.hpp>
+#include <ygm/container/quantile_sketch.hpp>
+
+int main(int argc, char **argv) {
+  ygm::comm world(&argc, &argv);
+
+  //
+  // Test local sketch: bounded size, rank error, merge
+  {
+    using ygm::container::detail::kll_sketch;
+    kll_sketch<int> evens, odds;
+    for (int i = 0; i < 100000; i += 2) {
+      evens.insert(i);
+      odds.insert(i + 1);
+    }
+    ASSERT_RELEASE(evens.count() == 50000);
+    ASSERT_RELEASE(evens.num_retained() < 1000);
+    ASSERT_RELEASE(std::abs(evens.quantile(0.5) - 50000) < 2000);
+
+    evens.merge(odds);
+    ASSERT_RELEASE(evens.count() == 100000);
+    ASSERT_RELEASE(evens.num_retained() < 1000);
+    for (double q : {0.01, 0.25, 0.5, 0.9, 0.99}) {
+      ASSERT_RELEASE(std::abs(evens.quantile(q) - q * 100000) < 2000);
+      ASSERT_RELEASE(std::abs(evens.cdf(q * 100000) - q) < 0.02);
+    }
+    ASSERT_RELEASE(evens.cdf(-1) == 0);
+    ASSERT_RELEASE(evens.cdf(100000) == 1);
+  }
+
+  //
+  // Test distributed quantiles over items spread across ranks
+  {
+    ygm::container::quantile_sketch<double> qs(world);
+    const int num_items = 10000 * world.size();
+    for (int i = world.rank(); i < num_items; i += world.size()) {
+      qs.async_insert(i);
+    }
+    ASSERT_RELEASE(qs.count() == size_t(num_items));
+
+    auto result = qs.quantiles({0.1, 0.5, 0.99});
+    ASSERT_RELEASE(std::abs(result[0] - 0.1 * num_items) < 0.02 * num_items);
+    ASSERT_RELEASE(std::abs(result[1] - 0.5 * num_items) < 0.02 * num_items);
+    ASSERT_RELEASE(std::abs(result[2] - 0.99 * num_items) < 0.02 * num_items);
+    ASSERT_RELEASE(std::abs(qs.cdf(0.75 * num_items) - 0.75) < 0.02);
+
+    qs.serialize("/tmp/test_quantile_sketch");
+    qs.clear();
+    ASSERT_RELEASE(qs.count() == 0);
+    qs.deserialize("/tmp/test_quantile_sketch");
+    ASSERT_RELEASE(qs.count() == size_t(num_items));
+  }
+
+  //
+  // Test per-key quantiles
+  {
+    ygm::container::keyed_quantile_sketch<std::string, int> kqs(world);
+    for (int i = 0; i < 1000; ++i) {
+      kqs.async_insert("small", i);
+      kqs.async_insert("large", 1000000 + i);
+    }
+    if (world.rank0()) {
+      kqs.async_insert("one", 42);
+    }
+    ASSERT_RELEASE(kqs.size() == 3);
+
+    ASSERT_RELEASE(kqs.sketch("small").count() == 1000 * world.size());
+    ASSERT_RELEASE(std::abs(kqs.quantile("small", 0.5) - 500) < 30);
+    ASSERT_RELEASE(std::abs(kqs.quantile("large", 0.9) - 1000900) < 30);
+    ASSERT_RELEASE(kqs.quantile("one", 0.5) == 42);
+    ASSERT_RELEASE(std::abs(kqs.cdf("small", 250) - 0.25) < 0.03);
+
+    size_t owned_items = 0;
+    kqs.for_all([&owned_items](const std::string &key, const auto &sketch) {
+      owned_items += sketch.count();
+    });
+    ASSERT_RELEASE(world.all_reduce_sum(owned_items) ==
+                   2000 * world.size() + 1);
+  }
+
+  return 0;
+}
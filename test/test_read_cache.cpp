@@ -0,0 +1,136 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#undef NDEBUG
+#include <ygm/comm.hpp>
+#include <ygm/container/map.hpp>
+#include <ygm/container/read_cache.hpp>
+
+int main(int argc, char **argv) {
+  ygm::comm world(&argc, &argv);
+
+  ygm::container::map<int, int> imap(world);
+  if (world.rank0()) {
+    for (int i = 0; i < 1000; ++i) {
+      imap.async_insert(i, 2 * i);
+    }
+  }
+  world.barrier();
+
+  //
+  // Test repeated hot-key lookups coalesce into one fetch per key
+  {
+    ygm::container::read_cache<ygm::container::map<int, int>> cache(imap);
+
+    size_t remote  = 0;
+    size_t visited = 0;
+    for (int i = 0; i < 10000; ++i) {
+      int key = i % 10;
+      if (!imap.is_mine(key)) {
+        ++remote;
+      }
+      cache.async_visit_if_exists(key, [&visited](const int &k, const int &v) {
+        ASSERT_RELEASE(v == 2 * k);
+        ++visited;
+      });
+    }
+    // Waiting instead of a barrier keeps the epoch, and the cache, alive
+    world.local_wait_until([&visited]() { return visited == 10000; });
+    ASSERT_RELEASE(cache.hits() + cache.misses() == remote);
+    ASSERT_RELEASE(cache.fetches() <= 10);
+
+    // Served from the cache without new fetches
+    size_t fetches = cache.fetches();
+    for (int key = 0; key < 10; ++key) {
+      cache.async_visit_if_exists(
+          key, [](auto pcache, const int &k, const int &v, int expected) {
+            ASSERT_RELEASE(v == expected);
+          },
+          2 * key);
+    }
+    ASSERT_RELEASE(cache.fetches() == fetches);
+    world.barrier();
+  }
+
+  //
+  // Test barrier starts a new epoch and refetches updated values
+  {
+    ygm::container::read_cache<ygm::container::map<int, int>> cache(imap);
+
+    static int seen;
+    seen = 0;
+    world.cf_barrier();
+    cache.async_visit_if_exists(7,
+                                [](const int &k, const int &v) { seen = v; });
+    world.barrier();
+    ASSERT_RELEASE(seen == 14);
+
+    if (world.rank0()) {
+      imap.async_insert(7, 70);
+    }
+    world.barrier();
+
+    cache.async_visit_if_exists(7,
+                                [](const int &k, const int &v) { seen = v; });
+    world.barrier();
+    ASSERT_RELEASE(seen == 70);
+    if (!imap.is_mine(7)) {
+      ASSERT_RELEASE(cache.fetches() == 2);
+    }
+  }
+
+  //
+  // Test absent keys are cached as misses
+  {
+    ygm::container::read_cache<ygm::container::map<int, int>> cache(imap);
+
+    size_t visited = 0;
+    for (int i = 0; i < 100; ++i) {
+      cache.async_visit_if_exists(
+          5000, [&visited](const int &k, const int &v) { ++visited; });
+    }
+    ASSERT_RELEASE(cache.fetches() <= 1);
+    world.barrier();
+    ASSERT_RELEASE(visited == 0);
+  }
+
+  //
+  // Test a small cache evicts but stays correct
+  {
+    ygm::container::read_cache<ygm::container::map<int, int>> cache(imap, 4);
+
+    size_t sum = 0;
+    for (int i = 0; i < 1000; ++i) {
+      cache.async_visit_if_exists(
+          i, [&sum](const int &k, const int &v) { sum += v; });
+    }
+    world.barrier();
+    ASSERT_RELEASE(cache.local_size() <= 4);
+    ASSERT_RELEASE(sum == 999 * 1000 - 14 + 70);
+  }
+
+  //
+  // Test multimap values are all visited
+  {
+    ygm::container::multimap<int, int> mmap(world);
+    if (world.rank0()) {
+      mmap.async_insert(3, 1);
+      mmap.async_insert(3, 2);
+    }
+    world.barrier();
+
+    ygm::container::read_cache<ygm::container::multimap<int, int>> cache(mmap);
+
+    int sum = 0;
+    for (int i = 0; i < 5; ++i) {
+      cache.async_visit_if_exists(
+          3, [&sum](const int &k, const int &v) { sum += v; });
+    }
+    world.barrier();
+    ASSERT_RELEASE(sum == 15);
+  }
+
+  return 0;
+}
@@ -0,0 +1,122 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#undef NDEBUG
+#include <string>
+#include <ygm/comm.hpp>
+#include <ygm/container/bag.hpp>
+#include <ygm/container/detail/reducing_adapter.hpp>
+#include <ygm/container/map.hpp>
+#include <ygm/container/set.hpp>
+
+int main(int argc, char** argv) {
+  ASSERT_MPI(MPI_Init(nullptr, nullptr));
+  int world_size;
+  ASSERT_MPI(MPI_Comm_size(MPI_COMM_WORLD, &world_size));
+
+  // Simulate one and two ranks per node to exercise remote routing hops
+  std::vector<std::string> fake_ranks_per_node{"1", "2"};
+  std::vector<std::string> config_routings{"NONE", "NR", "NLNR", "HIER",
+                                           "ADAPTIVE"};
+  std::vector<ygm::routing_type> call_routings{
+      ygm::routing_type::NONE, ygm::routing_type::NR,
+      ygm::routing_type::NLNR, ygm::routing_type::HIER,
+      ygm::routing_type::ADAPTIVE, ygm::routing_type::DEFAULT};
+
+  for (const auto& fake_rpn : fake_ranks_per_node) {
+    // Fake nodes must evenly divide the ranks
+    if (world_size % std::max(std::stoi(fake_rpn), 1) != 0) {
+      continue;
+    }
+    for (const auto& config_routing : config_routings) {
+      setenv("YGM_FAKE_RANKS_PER_NODE", fake_rpn.c_str(), 1);
+      setenv("YGM_COMM_ROUTING", config_routing.c_str(), 1);
+      setenv("YGM_COMM_ROUTING_LEVELS", "2", 1);
+      setenv("YGM_COMM_ADAPTIVE_DIRECT_KB", "1", 1);
+      ygm::comm world(MPI_COMM_WORLD);
+
+      //
+      // Per-call routing to every destination
+      for (const auto route : call_routings) {
+        static size_t counter = 0;
+        counter               = 0;
+        world.cf_barrier();
+        for (int i = 0; i < 100; ++i) {
+          for (int dest = 0; dest < world.size(); ++dest) {
+            world.async(route, dest, []() { ++counter; });
+          }
+        }
+        world.barrier();
+        ASSERT_RELEASE(counter == 100 * size_t(world.size()));
+      }
+
+      //
+      // Mixed routings with recursive replies
+      {
+        static size_t replies = 0;
+        replies               = 0;
+        world.cf_barrier();
+        for (size_t i = 0; i < call_routings.size(); ++i) {
+          for (int dest = 0; dest < world.size(); ++dest) {
+            world.async(
+                call_routings[i], dest,
+                [](ygm::comm* pcomm, int from, ygm::routing_type reply_route) {
+                  pcomm->async(reply_route, from, []() { ++replies; });
+                },
+                world.rank(),
+                call_routings[call_routings.size() - i - 1]);
+          }
+        }
+        world.barrier();
+        ASSERT_RELEASE(replies == call_routings.size() * world.size());
+      }
+
+      //
+      // Per-container routing
+      {
+        ygm::container::map<int, int> nlnr_map(world, ygm::routing_type::NLNR);
+        ygm::container::set<int>      adaptive_set(world,
+                                                   ygm::routing_type::ADAPTIVE);
+        ygm::container::bag<int>      nr_bag(world, ygm::routing_type::NR);
+
+        ygm::container::multimap<int, int> hier_multimap(world);
+        hier_multimap.set_routing(ygm::routing_type::HIER);
+        for (int i = 0; i < 1000; ++i) {
+          nlnr_map.async_insert(i, i * 2);
+          adaptive_set.async_insert(i);
+          nr_bag.async_insert(i);
+          hier_multimap.async_insert(i % 10, i);
+        }
+        ASSERT_RELEASE(nlnr_map.size() == 1000);
+        ASSERT_RELEASE(hier_multimap.size() == 1000 * size_t(world.size()));
+        ASSERT_RELEASE(adaptive_set.size() == 1000);
+        ASSERT_RELEASE(nr_bag.size() == 1000 * size_t(world.size()));
+        nlnr_map.for_all([](const int& key, const int& value) {
+          ASSERT_RELEASE(value == key * 2);
+        });
+      }
+
+      //
+      // reducing_adapter combining along a hierarchical route
+      {
+        ygm::container::map<int, int> sum_map(world);
+        {
+          auto reducing_map = ygm::container::detail::make_reducing_adapter(
+              sum_map, std::plus<int>(), ygm::routing_type::HIER);
+          for (int i = 0; i < 100; ++i) {
+            reducing_map.async_reduce(i % 10, 1);
+          }
+        }
+        world.barrier();
+        sum_map.for_all([&world](const int& key, const int& value) {
+          ASSERT_RELEASE(value == 10 * world.size());
+        });
+      }
+    }
+  }
+
+  ASSERT_MPI(MPI_Finalize());
+  return 0;
+}
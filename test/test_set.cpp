@@ -231,5 +231,36 @@ int main(int argc, char **argv) {
     }
   }
 
+  //
+  // Test duplicate filter skips repeat inserts within an epoch
+  {
+    ygm::container::set<int> iset(world);
+    iset.set_duplicate_filter(1024);
+
+    static int visits;
+    visits = 0;
+    world.cf_barrier();
+    for (int round = 0; round < 10; ++round) {
+      for (int i = 0; i < 100; ++i) {
+        iset.async_insert(i);
+        iset.async_insert_exe_if_missing(1000 + i,
+                                         [](const int &key) { ++visits; });
+      }
+    }
+    ASSERT_RELEASE(iset.suppressed_inserts() == 2 * 9 * 100);
+    ASSERT_RELEASE(iset.size() == 200);
+    ASSERT_RELEASE(world.all_reduce_sum(visits) == 100);
+
+    // Filter starts over after a barrier and forgets erased keys
+    iset.async_erase(5);
+    world.barrier();
+    iset.async_insert(5);
+    iset.async_insert(7);
+    iset.async_erase(7);
+    iset.async_insert(7);
+    ASSERT_RELEASE(iset.suppressed_inserts() == 2 * 9 * 100);
+    ASSERT_RELEASE(iset.count(5) == 1);
+  }
+
   return 0;
 }
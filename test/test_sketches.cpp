@@ -0,0 +1,156 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#undef NDEBUG
+#include <cmath>
+#include <string>
+#include <ygm/comm.hpp>
+#include <ygm/container/approximate_counting_set.hpp>
+#include <ygm/container/detail/count_min_sketch.hpp>
+#include <ygm/container/detail/hyperloglog.hpp>
+#include <ygm/container/distinct_counter.hpp>
+
+bool within(const double estimate, const double exact, const double error) {
+  return std::abs(estimate - exact) <= error * exact;
+}
+
+int main(int argc, char **argv) {
+  ygm::comm world(&argc, &argv);
+
+  //
+  // Test HyperLogLog estimates and merges
+  {
+    ygm::container::detail::hyperloglog a(12), b(12), both(12);
+    for (int i = 0; i < 100000; ++i) {
+      a.add(i);
+      both.add(i);
+    }
+    for (int i = 50000; i < 150000; ++i) {
+      b.add(i);
+      both.add(i);
+    }
+    ASSERT_RELEASE(within(a.estimate(), 100000, 0.05));
+    a.merge(b);
+    ASSERT_RELEASE(a.estimate() == both.estimate());
+    ASSERT_RELEASE(within(a.estimate(), 150000, 0.05));
+
+    ygm::container::detail::hyperloglog small;
+    for (int i = 0; i < 10; ++i) {
+      small.add(std::to_string(i));
+      small.add(std::to_string(i));
+    }
+    ASSERT_RELEASE(std::round(small.estimate()) == 10);
+  }
+
+  //
+  // Test count-min never undercounts
+  {
+    ygm::container::detail::count_min_sketch cms(8192, 4), half(8192, 4);
+    size_t                                   total = 0;
+    for (int i = 0; i < 10000; ++i) {
+      cms.add(i % 1000, i % 7 + 1);
+      if (i % 2 == 0) {
+        half.add(i % 1000, i % 7 + 1);
+      }
+      total += i % 7 + 1;
+    }
+    ASSERT_RELEASE(cms.total() == total);
+
+    size_t overcounted = 0;
+    for (int key = 0; key < 1000; ++key) {
+      size_t exact = 0;
+      for (int i = key; i < 10000; i += 1000) {
+        exact += i % 7 + 1;
+      }
+      ASSERT_RELEASE(cms.estimate(key) >= exact);
+      overcounted += cms.estimate(key) > exact;
+    }
+    ASSERT_RELEASE(overcounted < 10);
+
+    const uint64_t before = half.estimate(4);
+    half.merge(half);
+    ASSERT_RELEASE(half.estimate(4) == 2 * before);
+  }
+
+  //
+  // Test distinct_counter over overlapping inserts
+  {
+    ygm::container::distinct_counter<int> dc(world);
+    for (int i = 0; i < 10000; ++i) {
+      dc.async_insert(world.rank() * 5000 + i);
+    }
+    size_t exact = 5000 * (world.size() - 1) + 10000;
+    ASSERT_RELEASE(within(dc.count(), exact, 0.05));
+
+    dc.serialize("/tmp/test_sketches_dc");
+    dc.clear();
+    ASSERT_RELEASE(dc.count() == 0);
+    dc.deserialize("/tmp/test_sketches_dc");
+    ASSERT_RELEASE(within(dc.count(), exact, 0.05));
+  }
+
+  //
+  // Test keyed_distinct_counter
+  {
+    ygm::container::keyed_distinct_counter<std::string, int> kdc(world);
+    for (int i = 0; i < 1000; ++i) {
+      kdc.async_insert("all", world.rank() * 1000 + i);
+      kdc.async_insert("shared", i);
+      kdc.async_insert("few", i % 3);
+    }
+    ASSERT_RELEASE(kdc.size() == 3);
+    ASSERT_RELEASE(within(kdc.count("all"), 1000 * world.size(), 0.1));
+    ASSERT_RELEASE(within(kdc.count("shared"), 1000, 0.1));
+    ASSERT_RELEASE(kdc.count("few") == 3);
+    ASSERT_RELEASE(kdc.count("none") == 0);
+
+    size_t local_keys = 0;
+    kdc.for_all([&local_keys](const std::string &key, size_t estimate) {
+      ASSERT_RELEASE(estimate > 0);
+      ++local_keys;
+    });
+    ASSERT_RELEASE(world.all_reduce_sum(local_keys) == 3);
+  }
+
+  //
+  // Test approximate_counting_set
+  {
+    ygm::container::approximate_counting_set<int> acs(world, 4096, 4, 64);
+    // Key k is inserted k + 1 times on every rank for k < 100, and keys 1000
+    // and up once each
+    for (int key = 0; key < 100; ++key) {
+      for (int i = 0; i <= key; ++i) {
+        acs.async_insert(key);
+      }
+    }
+    for (int i = 0; i < 1000; ++i) {
+      acs.async_insert(1000 + world.rank() * 1000 + i);
+    }
+
+    for (int key = 0; key < 100; ++key) {
+      ASSERT_RELEASE(acs.count(key) >= size_t(key + 1) * world.size());
+    }
+    ASSERT_RELEASE(acs.count(99) <= 101 * world.size());
+    ASSERT_RELEASE(acs.count_all() ==
+                   size_t(5050 + 1000) * size_t(world.size()));
+    ASSERT_RELEASE(within(acs.size(), 100 + 1000 * world.size(), 0.1));
+
+    auto top = acs.topk(
+        3, [](const auto &a, const auto &b) { return a.second > b.second; });
+    ASSERT_RELEASE(top.size() == 3);
+    ASSERT_RELEASE(top[0].first == 99);
+    ASSERT_RELEASE(top[1].first == 98);
+    ASSERT_RELEASE(top[2].first == 97);
+
+    acs.serialize("/tmp/test_sketches_acs");
+    const size_t before = acs.count(50);
+    acs.clear();
+    ASSERT_RELEASE(acs.count(50) == 0);
+    acs.deserialize("/tmp/test_sketches_acs");
+    ASSERT_RELEASE(acs.count(50) == before);
+  }
+
+  return 0;
+}
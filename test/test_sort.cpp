@@ -0,0 +1,85 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#undef NDEBUG
+#include <random>
+#include <string>
+#include <ygm/comm.hpp>
+#include <ygm/container/sort.hpp>
+
+int main(int argc, char **argv) {
+  ygm::comm world(&argc, &argv);
+
+  //
+  // Test sorting a bag of random integers into an array
+  {
+    ygm::container::bag<uint64_t> bbag(world);
+    std::mt19937_64               rng(world.rank());
+    uint64_t                      local_sum = 0;
+    for (int i = 0; i < 1000 * (world.rank() + 1); ++i) {
+      uint64_t v = rng() % 500;
+      local_sum += v;
+      bbag.async_insert(v);
+    }
+
+    auto sorted = ygm::container::sort(bbag);
+    ASSERT_RELEASE(sorted.size() == bbag.size());
+
+    auto gathered = bbag.gather_to_vector();
+    std::sort(gathered.begin(), gathered.end());
+
+    uint64_t sorted_sum = 0;
+    sorted.for_all([&gathered, &sorted_sum](const size_t index, uint64_t &v) {
+      ASSERT_RELEASE(gathered[index] == v);
+      sorted_sum += v;
+    });
+    ASSERT_RELEASE(world.all_reduce_sum(sorted_sum) ==
+                   world.all_reduce_sum(local_sum));
+  }
+
+  //
+  // Test sorting with a custom comparator and fewer items than ranks
+  {
+    ygm::container::bag<std::string> bbag(world);
+    if (world.rank0()) {
+      bbag.async_insert("apple");
+      bbag.async_insert("cat");
+      bbag.async_insert("banana");
+    }
+
+    auto sorted = ygm::container::sort(bbag, std::greater<std::string>());
+    ASSERT_RELEASE(sorted.size() == 3);
+    sorted.for_all([](const size_t index, std::string &v) {
+      const char *expected[] = {"cat", "banana", "apple"};
+      ASSERT_RELEASE(v == expected[index]);
+    });
+  }
+
+  //
+  // Test in-place array sort with duplicates
+  {
+    size_t                     size = 1003;
+    ygm::container::array<int> arr(world, size);
+    if (world.rank0()) {
+      for (size_t i = 0; i < size; ++i) {
+        arr.async_set(i, (size - i) % 7);
+      }
+    }
+    world.barrier();
+
+    ygm::container::sort(arr);
+
+    std::vector<int> expected;
+    for (size_t i = 0; i < size; ++i) {
+      expected.push_back((size - i) % 7);
+    }
+    std::sort(expected.begin(), expected.end());
+    arr.for_all([&expected](const size_t index, int &v) {
+      ASSERT_RELEASE(expected[index] == v);
+    });
+  }
+
+  return 0;
+}
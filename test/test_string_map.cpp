@@ -0,0 +1,132 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#undef NDEBUG
+#include <string>
+#include <ygm/comm.hpp>
+#include <ygm/container/detail/string_arena.hpp>
+#include <ygm/container/counting_set.hpp>
+#include <ygm/container/map.hpp>
+#include <ygm/container/string_counting_set.hpp>
+#include <ygm/container/string_map.hpp>
+
+int main(int argc, char **argv) {
+  ygm::comm world(&argc, &argv);
+
+  //
+  // Test interning
+  {
+    using ygm::container::detail::string_arena;
+    using ygm::container::detail::string_hash;
+    string_arena arena;
+    for (int i = 0; i < 10000; ++i) {
+      std::string s = "key" + std::to_string(i % 1000);
+      auto [id, added] = arena.insert(s, string_hash(s));
+      ASSERT_RELEASE(added == (i < 1000));
+      ASSERT_RELEASE(id == size_t(i % 1000));
+    }
+    ASSERT_RELEASE(arena.size() == 1000);
+    ASSERT_RELEASE(arena.view(42) == "key42");
+    ASSERT_RELEASE(arena.find("key999", string_hash("key999")) == 999);
+    ASSERT_RELEASE(arena.find("key1000", string_hash("key1000")) ==
+                   string_arena::npos);
+
+    auto [id, added] = arena.insert("", string_hash(""));
+    ASSERT_RELEASE(added && arena.view(id).empty());
+
+    arena.clear();
+    ASSERT_RELEASE(arena.empty());
+    ASSERT_RELEASE(arena.find("key42", string_hash("key42")) ==
+                   string_arena::npos);
+  }
+
+  //
+  // Test keys land where map<std::string, ...> puts them
+  {
+    ygm::container::string_map<int>       smap(world);
+    ygm::container::map<std::string, int> omap(world);
+    for (int i = 0; i < 100; ++i) {
+      std::string key = std::to_string(i);
+      ASSERT_RELEASE(smap.owner(key) == omap.owner(key));
+    }
+  }
+
+  //
+  // Test insert, visit and reduce
+  {
+    ygm::container::string_map<int> smap(world);
+    smap.async_insert("dog", 1);
+    smap.async_insert_if_missing("dog", 5);
+    smap.async_insert_if_missing("cat", 2);
+    smap.async_reduce("sum", world.rank(), std::plus<int>());
+    smap.async_visit("visited", [](const std::string &key, int &value) {
+      ASSERT_RELEASE(key == "visited");
+      ++value;
+    });
+    smap.async_visit_if_exists("missing", [](const auto &key, int &value) {
+      ASSERT_RELEASE(false);
+    });
+    smap.async_visit_if_exists(
+        "cat",
+        [](auto pmap, const std::string &key, int &value, int to_add) {
+          value += to_add;
+        },
+        10);
+
+    ASSERT_RELEASE(smap.size() == 4);
+    ASSERT_RELEASE(smap.count("dog") == 1);
+    ASSERT_RELEASE(smap.count("missing") == 0);
+
+    int n = world.size();
+    smap.for_all([n](std::string_view key, int &value) {
+      if (key == "dog") {
+        ASSERT_RELEASE(value == 1);
+      } else if (key == "cat") {
+        ASSERT_RELEASE(value == 2 + 10 * n);
+      } else if (key == "sum") {
+        ASSERT_RELEASE(value == n * (n - 1) / 2);
+      } else {
+        ASSERT_RELEASE(key == "visited" && value == n);
+      }
+    });
+    size_t local = 0;
+    smap.for_all([&local](const std::string &key, int &value) { ++local; });
+    ASSERT_RELEASE(world.all_reduce_sum(local) == 4);
+
+    size_t bytes = smap.local_key_bytes();
+    smap.clear();
+    ASSERT_RELEASE(smap.size() == 0);
+    ASSERT_RELEASE(smap.local_key_bytes() <= bytes);
+  }
+
+  //
+  // Test string_counting_set against counting_set
+  {
+    ygm::container::string_counting_set       words(world);
+    ygm::container::counting_set<std::string> reference(world);
+    for (int i = 0; i < 10000; ++i) {
+      std::string word = "w" + std::to_string((i * 31) % 500);
+      words.async_insert(word);
+      reference.async_insert(word);
+    }
+    ASSERT_RELEASE(words.size() == 500);
+    ASSERT_RELEASE(words.count_all() == 10000 * size_t(world.size()));
+    ASSERT_RELEASE(words.count("w7") == 20 * size_t(world.size()));
+    ASSERT_RELEASE(words.count("nope") == 0);
+
+    auto top = words.topk(
+        3, [](const auto &a, const auto &b) { return a.first < b.first; });
+    ASSERT_RELEASE(top.size() == 3);
+    ASSERT_RELEASE(top[0].first == "w0" && top[1].first == "w1" &&
+                   top[2].first == "w10");
+    ASSERT_RELEASE(top[0].second == 20 * size_t(world.size()));
+
+    reference.for_all([&words](const std::string &word, const size_t &count) {
+      ASSERT_RELEASE(words.is_mine(word));
+    });
+  }
+
+  return 0;
+}
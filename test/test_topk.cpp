@@ -0,0 +1,84 @@
+// Copyright 2019-2021 Lawrence Livermore National Security, LLC and other YGM
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#undef NDEBUG
+#include <ygm/comm.hpp>
+#include <ygm/container/bag.hpp>
+#include <ygm/container/map.hpp>
+#include <ygm/container/topk.hpp>
+
+int main(int argc, char **argv) {
+  ygm::comm world(&argc, &argv);
+
+  //
+  // Test topk_heap keeps the k best
+  {
+    auto greater = [](const int a, const int b) { return a > b; };
+    ygm::container::detail::topk_heap<int, decltype(greater)> heap(3, greater);
+    for (int i : {5, 1, 9, 7, 3, 9, 2}) {
+      heap.push(i);
+    }
+    auto best = heap.take_sorted();
+    ASSERT_RELEASE((best == std::vector<int>{9, 9, 7}));
+  }
+
+  //
+  // Test map::topk against every value
+  {
+    ygm::container::map<int, int> imap(world);
+    for (int i = world.rank(); i < 10000; i += world.size()) {
+      imap.async_insert(i, (i * 7919) % 10007);
+    }
+
+    auto by_value = [](const auto &a, const auto &b) {
+      return a.second > b.second;
+    };
+    for (size_t k : {size_t(0), size_t(1), size_t(100), size_t(20000)}) {
+      auto top = imap.topk(k, by_value);
+      ASSERT_RELEASE(top.size() == std::min(k, size_t(10000)));
+      for (size_t i = 1; i < top.size(); ++i) {
+        ASSERT_RELEASE(top[i - 1].second >= top[i].second);
+      }
+      if (k == 100) {
+        // Values are a permutation of part of [0, 10007)
+        std::vector<int> all;
+        for (int i = 0; i < 10000; ++i) {
+          all.push_back((i * 7919) % 10007);
+        }
+        std::sort(all.rbegin(), all.rend());
+        for (size_t i = 0; i < k; ++i) {
+          ASSERT_RELEASE(top[i].second == all[i]);
+          ASSERT_RELEASE((top[i].first * 7919) % 10007 == top[i].second);
+        }
+      }
+    }
+
+    // Generic version over for_all matches
+    auto generic = ygm::container::topk(imap, 100, by_value);
+    ASSERT_RELEASE(generic == imap.topk(100, by_value));
+  }
+
+  //
+  // Test topk of a bag, with ties, when only one rank holds items
+  {
+    ygm::container::bag<int> ibag(world);
+    if (world.rank0()) {
+      for (int i = 0; i < 100; ++i) {
+        ibag.async_insert(i % 10);
+      }
+    }
+    auto top = ygm::container::topk(
+        ibag, 15, [](const int a, const int b) { return a > b; });
+    ASSERT_RELEASE(top.size() == 15);
+    for (size_t i = 0; i < 10; ++i) {
+      ASSERT_RELEASE(top[i] == 9);
+    }
+    for (size_t i = 10; i < 15; ++i) {
+      ASSERT_RELEASE(top[i] == 8);
+    }
+  }
+
+  return 0;
+}